@@ -0,0 +1,15 @@
+OPENQASM 2.0;
+include "qelib1.inc";
+qreg q[4];
+h q[0];
+t q[2];
+cx q[0], q[3];
+rz(pi/8) q[1];
+ccx q[3], q[0], q[2];
+cz q[3], q[1];
+h q[3];
+cx q[2], q[0];
+sdg q[0];
+swap q[0], q[2];
+tdg q[3];
+cx q[1], q[3];
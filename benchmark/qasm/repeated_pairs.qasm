@@ -0,0 +1,16 @@
+OPENQASM 2.0;
+include "qelib1.inc";
+qreg q[4];
+cx q[0],q[1];
+cx q[0],q[1];
+cx q[1],q[0];
+t q[1];
+cx q[0],q[1];
+cx q[2],q[3];
+cx q[3],q[2];
+cx q[0],q[3];
+cx q[0],q[3];
+h q[3];
+cx q[3],q[0];
+cx q[1],q[2];
+cx q[1],q[2];
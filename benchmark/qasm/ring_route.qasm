@@ -0,0 +1,9 @@
+OPENQASM 2.0;
+include "qelib1.inc";
+qreg q[6];
+h q[0];
+cx q[0],q[3];
+t q[3];
+cx q[3],q[0];
+h q[2];
+cx q[1],q[2];
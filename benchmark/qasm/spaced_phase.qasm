@@ -0,0 +1,9 @@
+OPENQASM 2.0;
+include "qelib1.inc";
+qreg q[3];
+rz(pi/16) q[0];
+rz (pi/8) q[0];
+rz	(3*pi/8) q[1];
+p  (pi/8)  q[2];
+cx q[0], q[2];
+h q[1];
@@ -9,18 +9,24 @@
 
 #include <spdlog/spdlog.h>
 
+#include <cassert>
 #include <string>
+#include <variant>
 
+#include "./qcir_to_tableau.hpp"
 #include "./qcir_to_tensor.hpp"
 #include "./qcir_to_zxgraph.hpp"
+#include "./zxgraph_to_tableau.hpp"
 #include "./zxgraph_to_tensor.hpp"
 #include "argparse/arg_type.hpp"
 #include "cli/cli.hpp"
 #include "extractor/extract.hpp"
 #include "qcir/qcir_mgr.hpp"
+#include "qcir/simulator/dd_equivalence.hpp"
 #include "tensor/tensor_mgr.hpp"
 #include "util/data_structure_manager_common_cmd.hpp"
 #include "util/dvlab_string.hpp"
+#include "util/text_format.hpp"
 #include "util/util.hpp"
 #include "zx/zx_cmd.hpp"
 
@@ -55,12 +61,23 @@ Command conversion_cmd(QCirMgr& qcir_mgr, qsyn::tensor::TensorMgr& tensor_mgr, q
                     .default_value(3)
                     .constraint(valid_decomposition_mode)
                     .help("specify the decomposition mode (default: 3). The higher the number, the more aggressive the decomposition is. This option is currently only meaningful when converting from QCir to ZXGraph.");
+
+                parser.add_argument<std::string>("--contraction")
+                    .default_value("sequential")
+                    .choices({"sequential", "greedy", "partition", "best"})
+                    .help("the order to contract tensors when converting to Tensor. "
+                          "sequential: one gate or vertex at a time in topological order; "
+                          "greedy, partition: plan the order over the whole network greedily or by recursive bisection; "
+                          "best: try all and pick the plan with the lowest estimated peak memory and FLOPs");
             },
             [&](ArgumentParser const& parser) {
                 using namespace std::string_view_literals;
                 auto from = parser.get<std::string>("from");
                 auto to   = parser.get<std::string>("to");
 
+                auto const contraction = qsyn::tensor::get_contraction_strategy(parser.get<std::string>("--contraction"));
+                assert(contraction.has_value());
+
                 if (from == to) {
                     spdlog::error("The source and destination data structure should not be the same!!", from, to);
                     return CmdExecResult::error;
@@ -96,7 +113,7 @@ Command conversion_cmd(QCirMgr& qcir_mgr, qsyn::tensor::TensorMgr& tensor_mgr, q
                 if (get_data_type(from) == data_type::qcir && get_data_type(to) == data_type::tensor) {
                     if (!dvlab::utils::mgr_has_data(qcir_mgr)) return CmdExecResult::error;
                     spdlog::info("Converting to QCir {} to tensor {}...", qcir_mgr.focused_id(), tensor_mgr.get_next_id());
-                    auto tensor = to_tensor(*qcir_mgr.get());
+                    auto tensor = to_tensor(*qcir_mgr.get(), contraction.value());
 
                     if (tensor.has_value()) {
                         tensor_mgr.add(tensor_mgr.get_next_id());
@@ -115,7 +132,7 @@ Command conversion_cmd(QCirMgr& qcir_mgr, qsyn::tensor::TensorMgr& tensor_mgr, q
                     auto zx = zxgraph_mgr.get();
 
                     spdlog::info("Converting ZXGraph {} to Tensor {}...", zxgraph_mgr.focused_id(), tensor_mgr.get_next_id());
-                    auto tensor = qsyn::to_tensor(*zx);
+                    auto tensor = qsyn::to_tensor(*zx, contraction.value());
 
                     if (tensor.has_value()) {
                         tensor_mgr.add(tensor_mgr.get_next_id(), std::make_unique<qsyn::tensor::QTensor<double>>(std::move(tensor.value())));
@@ -163,8 +180,173 @@ Command conversion_cmd(QCirMgr& qcir_mgr, qsyn::tensor::TensorMgr& tensor_mgr, q
             }};
 }
 
+namespace {
+
+using EquivalenceOperand = std::variant<qcir::QCir const*, zx::ZXGraph const*>;
+
+bool is_clifford(EquivalenceOperand const& operand) {
+    if (auto const* qcir = std::get_if<qcir::QCir const*>(&operand)) return qsyn::is_clifford(**qcir);
+    return std::get<zx::ZXGraph const*>(operand)->non_clifford_count() == 0;
+}
+
+std::optional<tensor::QTensor<double>> get_tensor(EquivalenceOperand const& operand) {
+    if (auto const* qcir = std::get_if<qcir::QCir const*>(&operand)) return to_tensor(**qcir);
+    return to_tensor(*std::get<zx::ZXGraph const*>(operand));
+}
+
+/**
+ * @brief Check the equivalence with stabilizers. Two QCirs are compared by their tableaux in O(n^2) time;
+ *        otherwise, the canonical stabilizers of the Choi states are compared.
+ *
+ * @return whether the two are equivalent up to a global scalar, or std::nullopt if either is not Clifford
+ */
+std::optional<bool> is_equivalent_by_stabilizers(EquivalenceOperand const& lhs, EquivalenceOperand const& rhs) {
+    auto const* lhs_qcir = std::get_if<qcir::QCir const*>(&lhs);
+    auto const* rhs_qcir = std::get_if<qcir::QCir const*>(&rhs);
+    if (lhs_qcir != nullptr && rhs_qcir != nullptr) {
+        auto const lhs_tableau = to_stabilizer_tableau(**lhs_qcir);
+        if (!lhs_tableau.has_value()) return std::nullopt;
+        auto const rhs_tableau = to_stabilizer_tableau(**rhs_qcir);
+        if (!rhs_tableau.has_value()) return std::nullopt;
+        return *lhs_tableau == *rhs_tableau;
+    }
+
+    auto const get_stabilizers = [](EquivalenceOperand const& operand) -> std::optional<qcir::CanonicalStabilizers> {
+        if (auto const* qcir = std::get_if<qcir::QCir const*>(&operand)) {
+            auto const tableau = to_stabilizer_tableau(**qcir);
+            if (!tableau.has_value()) return std::nullopt;
+            return tableau->get_choi_stabilizers();
+        }
+        return to_canonical_stabilizers(*std::get<zx::ZXGraph const*>(operand));
+    };
+    auto const lhs_stabilizers = get_stabilizers(lhs);
+    if (!lhs_stabilizers.has_value()) return std::nullopt;
+    auto const rhs_stabilizers = get_stabilizers(rhs);
+    if (!rhs_stabilizers.has_value()) return std::nullopt;
+    return *lhs_stabilizers == *rhs_stabilizers;
+}
+
+void print_dd_equivalence_report(qcir::DDEquivalenceReport const& report) {
+    using namespace dvlab;
+    switch (report.result) {
+        case qcir::DDEquivalenceResult::equivalent:
+            fmt::println("{}", fmt_ext::styled_if_ansi_supported("Equivalent", fmt::fg(fmt::terminal_color::green) | fmt::emphasis::bold));
+            fmt::println("- Global Phase: {}", report.global_phase);
+            break;
+        case qcir::DDEquivalenceResult::not_equivalent:
+            fmt::println("{}", fmt_ext::styled_if_ansi_supported("Not Equivalent", fmt::fg(fmt::terminal_color::red) | fmt::emphasis::bold));
+            break;
+        case qcir::DDEquivalenceResult::unknown:
+            fmt::println("{}", fmt_ext::styled_if_ansi_supported("Unknown", fmt::fg(fmt::terminal_color::yellow) | fmt::emphasis::bold));
+            break;
+    }
+    spdlog::info("Peak number of decision diagram nodes: {}", report.peak_num_nodes);
+}
+
+}  // namespace
+
+Command equivalence_check_cmd(QCirMgr& qcir_mgr, qsyn::zx::ZXGraphMgr& zxgraph_mgr) {
+    return {"equiv",
+            [&](ArgumentParser& parser) {
+                parser.description("check the equivalence of two QCirs or ZXGraphs");
+
+                parser.add_argument<std::string>("type1")
+                    .constraint(choices_allow_prefix({"qcir", "zx"}))
+                    .help("the type of the first one. Choices: qcir, zx");
+                parser.add_argument<size_t>("id1")
+                    .help("the ID of the first one");
+                parser.add_argument<std::string>("type2")
+                    .constraint(choices_allow_prefix({"qcir", "zx"}))
+                    .help("the type of the second one. Choices: qcir, zx");
+                parser.add_argument<size_t>("id2")
+                    .help("the ID of the second one");
+
+                parser.add_argument<std::string>("-m", "--method")
+                    .default_value("auto")
+                    .choices({"auto", "stabilizer", "dd", "tensor"})
+                    .help("stabilizer: compare stabilizer tableaux, which only works for Clifford ones but takes polynomial time; "
+                          "dd: check if U V^dagger is the identity with decision diagrams, which only works for QCirs but scales to many qubits if the two are similar; "
+                          "tensor: compare the tensors; "
+                          "auto: use stabilizers if both are Clifford, decision diagrams if both are QCirs, and tensors otherwise (default: auto)");
+                parser.add_argument<double>("-e", "--epsilon")
+                    .metavar("eps")
+                    .default_value(1e-6)
+                    .help("with tensors, output \"equivalent\" if the Frobenius inner product is at least 1 - eps (default: 1e-6)");
+                parser.add_argument<double>("--timeout")
+                    .metavar("seconds")
+                    .default_value(0.)
+                    .help("with decision diagrams, give up after this many seconds; 0 for no limit (default: 0)");
+                parser.add_argument<size_t>("--max-nodes")
+                    .default_value(0)
+                    .help("with decision diagrams, give up if more than this many nodes are alive; 0 for no limit (default: 0)");
+            },
+            [&](ArgumentParser const& parser) {
+                auto const get_operand = [&](std::string const& type, size_t id) -> std::optional<EquivalenceOperand> {
+                    if (dvlab::str::is_prefix_of(dvlab::str::tolower_string(type), "qcir")) {
+                        if (!dvlab::utils::valid_mgr_id(qcir_mgr)(id)) return std::nullopt;
+                        return qcir_mgr.find_by_id(id);
+                    }
+                    if (!dvlab::utils::valid_mgr_id(zxgraph_mgr)(id)) return std::nullopt;
+                    return zxgraph_mgr.find_by_id(id);
+                };
+                auto const lhs = get_operand(parser.get<std::string>("type1"), parser.get<size_t>("id1"));
+                if (!lhs.has_value()) return CmdExecResult::error;
+                auto const rhs = get_operand(parser.get<std::string>("type2"), parser.get<size_t>("id2"));
+                if (!rhs.has_value()) return CmdExecResult::error;
+
+                using namespace dvlab;
+                auto const method = parser.get<std::string>("--method");
+                if (method == "stabilizer" || (method == "auto" && is_clifford(*lhs) && is_clifford(*rhs))) {
+                    spdlog::info("Checking equivalence with stabilizers...");
+                    auto const equiv = is_equivalent_by_stabilizers(*lhs, *rhs);
+                    if (equiv.has_value()) {
+                        if (*equiv) {
+                            fmt::println("{}", fmt_ext::styled_if_ansi_supported("Equivalent up to global scalar", fmt::fg(fmt::terminal_color::green) | fmt::emphasis::bold));
+                        } else {
+                            fmt::println("{}", fmt_ext::styled_if_ansi_supported("Not Equivalent", fmt::fg(fmt::terminal_color::red) | fmt::emphasis::bold));
+                        }
+                        return CmdExecResult::done;
+                    }
+                    if (method == "stabilizer") return CmdExecResult::error;
+                    spdlog::info("Falling back to tensors...");
+                }
+
+                auto const* lhs_qcir = std::get_if<qcir::QCir const*>(&*lhs);
+                auto const* rhs_qcir = std::get_if<qcir::QCir const*>(&*rhs);
+                if (method == "dd" || (method == "auto" && lhs_qcir != nullptr && rhs_qcir != nullptr)) {
+                    if (lhs_qcir == nullptr || rhs_qcir == nullptr) {
+                        spdlog::error("Decision diagrams only support QCirs!!");
+                        return CmdExecResult::error;
+                    }
+                    spdlog::info("Checking equivalence with decision diagrams...");
+                    auto const report = qcir::check_equivalence_by_dd(**lhs_qcir, **rhs_qcir,
+                                                                      {.timeout       = parser.get<double>("--timeout"),
+                                                                       .max_num_nodes = parser.get<size_t>("--max-nodes")});
+                    if (!report.has_value()) return CmdExecResult::error;
+                    print_dd_equivalence_report(*report);
+                    return CmdExecResult::done;
+                }
+
+                spdlog::info("Checking equivalence with tensors...");
+                auto const lhs_tensor = get_tensor(*lhs);
+                if (!lhs_tensor.has_value()) return CmdExecResult::error;
+                auto const rhs_tensor = get_tensor(*rhs);
+                if (!rhs_tensor.has_value()) return CmdExecResult::error;
+
+                if (is_equivalent(*lhs_tensor, *rhs_tensor, parser.get<double>("--epsilon"))) {
+                    fmt::println("{}", fmt_ext::styled_if_ansi_supported("Equivalent", fmt::fg(fmt::terminal_color::green) | fmt::emphasis::bold));
+                    fmt::println("- Global Norm : {:.6}", global_norm(*lhs_tensor, *rhs_tensor));
+                    fmt::println("- Global Phase: {}", global_phase(*lhs_tensor, *rhs_tensor));
+                } else {
+                    fmt::println("{}", fmt_ext::styled_if_ansi_supported("Not Equivalent", fmt::fg(fmt::terminal_color::red) | fmt::emphasis::bold));
+                }
+                return CmdExecResult::done;
+            }};
+}
+
 bool add_conversion_cmds(dvlab::CommandLineInterface& cli, QCirMgr& qcir_mgr, qsyn::tensor::TensorMgr& tensor_mgr, qsyn::zx::ZXGraphMgr& zxgraph_mgr) {
     if (!(cli.add_command(conversion_cmd(qcir_mgr, tensor_mgr, zxgraph_mgr)) &&
+          cli.add_command(equivalence_check_cmd(qcir_mgr, zxgraph_mgr)) &&
           cli.add_alias("qc2zx", "convert qcir zx") &&
           cli.add_alias("qc2ts", "convert qcir tensor") &&
           cli.add_alias("zx2ts", "convert zx tensor") &&
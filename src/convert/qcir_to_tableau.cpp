@@ -0,0 +1,175 @@
+/****************************************************************************
+  PackageName  [ qsyn ]
+  Synopsis     [ Define conversion from QCir to StabilizerTableau ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include "./qcir_to_tableau.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "qcir/gate_type.hpp"
+#include "qcir/qcir_gate.hpp"
+#include "qcir/qcir_qubit.hpp"
+#include "qsyn/qsyn_type.hpp"
+#include "util/phase.hpp"
+
+extern bool stop_requested();
+
+namespace qsyn {
+
+using qcir::GateRotationCategory;
+using qcir::StabilizerTableau;
+
+namespace {
+
+/**
+ * @brief Return k if the phase is k * pi/2, or std::nullopt otherwise.
+ *
+ */
+std::optional<size_t> get_quarter_turns(dvlab::Phase const& phase) {
+    if (phase.denominator() > 2) return std::nullopt;
+    auto const k = phase.numerator() * (2 / phase.denominator());
+    return static_cast<size_t>((k % 4 + 4) % 4);
+}
+
+/**
+ * @brief Apply diag(1, i^k), i.e., S^k.
+ *
+ */
+void apply_quarter_turns(StabilizerTableau& tableau, size_t qubit, size_t k) {
+    switch (k) {
+        case 1: tableau.s(qubit); break;
+        case 2: tableau.z(qubit); break;
+        case 3: tableau.sdg(qubit); break;
+        default: break;
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief Return whether the gate is a Clifford gate, i.e., H, SWAP, a rotation of k * pi/2 on one qubit,
+ *        or a rotation of pi with one control.
+ *
+ */
+bool is_clifford_gate(qcir::QCirGate const& gate) {
+    auto const num_qubits = gate.get_qubits().size();
+    switch (gate.get_rotation_category()) {
+        case GateRotationCategory::id:
+            return true;
+        case GateRotationCategory::h:
+            return num_qubits == 1;
+        case GateRotationCategory::swap:
+            return num_qubits == 2;
+        default:
+            break;
+    }
+
+    auto const k = get_quarter_turns(gate.get_phase());
+    if (!k.has_value()) return false;
+    return *k == 0 || num_qubits == 1 || (num_qubits == 2 && *k == 2);
+}
+
+/**
+ * @brief Return whether every gate of the QCir is a Clifford gate. Unlike `to_stabilizer_tableau`,
+ *        this neither builds the tableau nor logs the offending gate.
+ *
+ */
+bool is_clifford(qcir::QCir const& qcir) {
+    return std::ranges::all_of(qcir.get_gates(), [](qcir::QCirGate const* gate) { return is_clifford_gate(*gate); });
+}
+
+namespace {
+
+/**
+ * @brief Apply the gate if it is a Clifford gate. Rotations about X and Y conjugate those about Z by
+ *        H and by H S (S first), the latter following the convention of QTensor::pygate.
+ *        Global phases are dropped.
+ *
+ * @return false if the gate is not a Clifford gate
+ */
+bool apply_gate(StabilizerTableau& tableau, qcir::QCirGate const& gate, std::unordered_map<QubitIdType, size_t> const& positions) {
+    if (!is_clifford_gate(gate)) return false;
+
+    auto const& qubits  = gate.get_qubits();
+    auto const target   = positions.at(qubits.back()._qubit);
+    auto const category = gate.get_rotation_category();
+
+    switch (category) {
+        case GateRotationCategory::id:
+            return true;
+        case GateRotationCategory::h:
+            tableau.h(target);
+            return true;
+        case GateRotationCategory::swap:
+            tableau.swap(positions.at(qubits[0]._qubit), target);
+            return true;
+        default:
+            break;
+    }
+
+    auto const k = *get_quarter_turns(gate.get_phase());
+    if (k == 0) return true;
+
+    bool const is_x = category == GateRotationCategory::px || category == GateRotationCategory::rx;
+    bool const is_y = category == GateRotationCategory::py || category == GateRotationCategory::ry;
+    if (is_y) tableau.s(target);
+    if (is_x || is_y) tableau.h(target);
+
+    if (qubits.size() == 1) {
+        apply_quarter_turns(tableau, target, k);
+    } else {
+        auto const control = positions.at(qubits[0]._qubit);
+        tableau.cz(control, target);
+        // a controlled R(pi) is a controlled P(pi) times -i on the control
+        bool const is_r = category == GateRotationCategory::rz || category == GateRotationCategory::rx || category == GateRotationCategory::ry;
+        if (is_r) tableau.sdg(control);
+    }
+
+    if (is_x || is_y) tableau.h(target);
+    if (is_y) tableau.sdg(target);
+    return true;
+}
+
+}  // namespace
+
+/**
+ * @brief Apply a Clifford circuit U to |0...0> in the stabilizer formalism, so that the tableau holds
+ *        U X_i U^dagger and U Z_i U^dagger. The qubits of `qcir`, sorted by ID, are the qubits of the
+ *        tableau in order.
+ *
+ * @return the tableau, or std::nullopt if the circuit has a non-Clifford gate or the conversion is interrupted
+ */
+std::optional<StabilizerTableau> to_stabilizer_tableau(qcir::QCir const& qcir) {
+    std::vector<QubitIdType> qubit_ids;
+    for (auto const* qubit : qcir.get_qubits()) {
+        qubit_ids.emplace_back(qubit->get_id());
+    }
+    std::ranges::sort(qubit_ids);
+    std::unordered_map<QubitIdType, size_t> positions;
+    for (size_t i = 0; i < qubit_ids.size(); ++i) {
+        positions.emplace(qubit_ids[i], i);
+    }
+
+    auto tableau = StabilizerTableau(qubit_ids.size());
+    for (auto const* gate : qcir.update_topological_order()) {
+        if (stop_requested()) {
+            spdlog::warn("Conversion interrupted.");
+            return std::nullopt;
+        }
+        if (!apply_gate(tableau, *gate, positions)) {
+            spdlog::error("Gate {} ({}) is not a Clifford gate!!", gate->get_id(), gate->get_type_str());
+            return std::nullopt;
+        }
+    }
+    return tableau;
+}
+
+}  // namespace qsyn
@@ -0,0 +1,21 @@
+/****************************************************************************
+  PackageName  [ qsyn ]
+  Synopsis     [ Define conversion from QCir to StabilizerTableau ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#pragma once
+
+#include <optional>
+
+#include "qcir/qcir.hpp"
+#include "qcir/simulator/stabilizer_tableau.hpp"
+
+namespace qsyn {
+
+bool is_clifford_gate(qcir::QCirGate const& gate);
+bool is_clifford(qcir::QCir const& qcir);
+std::optional<qcir::StabilizerTableau> to_stabilizer_tableau(qcir::QCir const& qcir);
+
+}  // namespace qsyn
@@ -9,8 +9,11 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <thread>
+#include <unordered_map>
+#include <utility>
 
 #include "fmt/core.h"
 #include "qcir/gate_type.hpp"
@@ -18,6 +21,7 @@
 #include "qcir/qcir_qubit.hpp"
 #include "qsyn/qsyn_type.hpp"
 #include "tensor/qtensor.hpp"
+#include "tensor/tensor_network.hpp"
 
 extern bool stop_requested();
 
@@ -100,14 +104,85 @@ std::optional<QTensor<double>> to_tensor(QCirGate *gate) {
     }
 };
 
+namespace {
+
+/**
+ * @brief Convert QCir to tensor by planning a contraction order over all gates.
+ *        Each qubit starts with an identity, and each gate connects the wires of its qubits.
+ */
+std::optional<QTensor<double>> contract_as_network(QCir const &qcir, tensor::ContractionStrategy strategy) {
+    qcir.update_topological_order();
+
+    tensor::TensorNetwork network;
+    std::vector<QTensor<double>> tensors;
+    std::unordered_map<QubitIdType, size_t> wires;  // the edge at the current end of each qubit
+    std::vector<size_t> input_edges;
+    size_t num_edges = 0;
+    for (auto const *qubit : qcir.get_qubits()) {
+        input_edges.emplace_back(num_edges);
+        wires[qubit->get_id()] = num_edges + 1;
+        network.add_tensor({num_edges, num_edges + 1});
+        tensors.emplace_back(QTensor<double>::identity(1));
+        num_edges += 2;
+    }
+
+    bool convertible = true;
+    qcir.topological_traverse([&](QCirGate *gate) {
+        auto tmp = to_tensor(gate);
+        if (!tmp.has_value()) {
+            spdlog::error("Gate {} ({}) cannot be converted to a tensor!!", gate->get_id(), gate->get_type_str());
+            convertible = false;
+            return;
+        }
+        // NOTE - the axes 2i and 2i+1 of a gate tensor are the input and output of its i-th qubit
+        std::vector<size_t> edges;
+        for (auto const &info : gate->get_qubits()) {
+            edges.emplace_back(wires[info._qubit]);
+            edges.emplace_back(num_edges);
+            wires[info._qubit] = num_edges++;
+        }
+        network.add_tensor(std::move(edges));
+        tensors.emplace_back(std::move(*tmp));
+    });
+    if (!convertible) return std::nullopt;
+
+    auto const plan = tensor::find_contraction_plan(network, strategy);
+    spdlog::info("Contracting {} tensors ({}): {:.3g} FLOPs, peak memory {:.3g} entries",
+                 network.get_num_tensors(), tensor::get_contraction_strategy_str(strategy), plan.cost.flops, plan.cost.peak_memory);
+
+    auto contracted = tensor::contract(std::move(tensors), network, plan);
+    if (!contracted.has_value()) {
+        spdlog::warn("Conversion interrupted.");
+        return std::nullopt;
+    }
+    auto &result           = contracted->first;
+    auto const &open_edges = contracted->second;
+    auto const get_axis    = [&open_edges](size_t edge) -> size_t { return std::ranges::find(open_edges, edge) - open_edges.begin(); };
+
+    std::vector<size_t> input_pin, output_pin;
+    for (size_t i = 0; i < qcir.get_qubits().size(); i++) {
+        input_pin.emplace_back(get_axis(input_edges[i]));
+        output_pin.emplace_back(get_axis(wires[qcir.get_qubits()[i]->get_id()]));
+    }
+    return result.to_matrix(input_pin, output_pin);
+}
+
+}  // namespace
+
 /**
  * @brief Convert QCir to tensor
+ *
+ * @param strategy the sequential strategy applies the gates one by one in topological order;
+ *        the others plan the contraction order over the whole circuit first
  */
-std::optional<QTensor<double>> to_tensor(QCir const &qcir) {
+std::optional<QTensor<double>> to_tensor(QCir const &qcir, tensor::ContractionStrategy strategy) {
     if (qcir.get_qubits().empty()) {
         spdlog::warn("QCir is empty!!");
         return std::nullopt;
     }
+    if (strategy != tensor::ContractionStrategy::sequential) {
+        return contract_as_network(qcir, strategy);
+    }
     qcir.update_topological_order();
     spdlog::debug("Add boundary");
 
@@ -129,7 +204,10 @@ std::optional<QTensor<double>> to_tensor(QCir const &qcir) {
         spdlog::trace("  - Add Qubit {} input port: {}", qcir.get_qubits()[i]->get_id(), 2 * i);
     }
 
-    qcir.topological_traverse([&tensor, &qubit2pin](QCirGate *gate) {
+    // ping-pong between two tensors and reuse the permutation buffers to avoid allocations per gate
+    QTensor<double> buffer;
+    tensor::TensordotWorkspace<std::complex<double>> workspace;
+    qcir.topological_traverse([&tensor, &buffer, &workspace, &qubit2pin](QCirGate *gate) {
         if (stop_requested()) return;
         spdlog::debug("Gate {} ({})", gate->get_id(), gate->get_type_str());
         auto tmp = to_tensor(gate);
@@ -141,7 +219,8 @@ std::optional<QTensor<double>> to_tensor(QCir const &qcir) {
             auto const info = gate->get_qubits()[np];
             ori_pin.emplace_back(qubit2pin[info._qubit].second);
         }
-        tensor = tensordot(tensor, *tmp, ori_pin, new_pin);
+        tensordot_into(tensor, *tmp, ori_pin, new_pin, buffer, workspace);
+        std::swap(tensor, buffer);
         update_tensor_pin(qubit2pin, gate->get_qubits(), tensor, *tmp);
     });
 
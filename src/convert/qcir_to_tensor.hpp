@@ -10,12 +10,13 @@
 #include "qcir/qcir.hpp"
 #include "qcir/qcir_gate.hpp"
 #include "tensor/qtensor.hpp"
+#include "tensor/tensor_network.hpp"
 
 using namespace qsyn::qcir;
 
 namespace qsyn {
 
 std::optional<qsyn::tensor::QTensor<double>> to_tensor(QCirGate* gate);
-std::optional<qsyn::tensor::QTensor<double>> to_tensor(QCir const& qcir);
+std::optional<qsyn::tensor::QTensor<double>> to_tensor(QCir const& qcir, qsyn::tensor::ContractionStrategy strategy = qsyn::tensor::ContractionStrategy::sequential);
 
 }  // namespace qsyn
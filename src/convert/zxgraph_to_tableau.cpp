@@ -0,0 +1,123 @@
+/****************************************************************************
+  PackageName  [ qsyn ]
+  Synopsis     [ Define conversion from ZXGraph to stabilizers ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include "./zxgraph_to_tableau.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "zx/zx_def.hpp"
+#include "zx/zxgraph.hpp"
+
+extern bool stop_requested();
+
+namespace qsyn {
+
+using qcir::StabilizerTableau;
+
+namespace {
+
+std::vector<zx::ZXVertex*> get_sorted_by_qubit(zx::ZXVertexList const& vertices) {
+    auto sorted = std::vector<zx::ZXVertex*>(vertices.begin(), vertices.end());
+    std::ranges::sort(sorted, {}, [](zx::ZXVertex* v) { return v->get_qubit(); });
+    return sorted;
+}
+
+}  // namespace
+
+/**
+ * @brief Get the canonical stabilizers of the state obtained by regarding every boundary of a
+ *        Clifford ZXGraph as an output. The inputs, sorted by qubit, come first, followed by the
+ *        outputs sorted by qubit; for the ZXGraph of a circuit U, this is the Choi state of U as in
+ *        StabilizerTableau::get_choi_stabilizers.
+ *
+ *        Each spider is a qubit of a graph state: X-spiders are Z-spiders with the types of their
+ *        incident edges toggled, Hadamard H-boxes are phase-free Z-spiders with one leg toggled,
+ *        and a simple edge becomes two Hadamard edges through an extra phase-free spider.
+ *        A spider with phase k * pi/2 gets S^k, and every spider but the boundaries is then
+ *        projected onto <+|. Scalars are ignored.
+ *
+ * @return the canonical stabilizers, or std::nullopt if the ZXGraph is not Clifford or is zero
+ */
+std::optional<qcir::CanonicalStabilizers> to_canonical_stabilizers(zx::ZXGraph const& graph) {
+    std::unordered_map<zx::ZXVertex*, size_t> qubit_of;
+    // a Hadamard H-box is a phase-free Z-spider with one of its two legs toggled
+    std::unordered_map<zx::ZXVertex*, zx::ZXVertex*> toggled_leg_of;
+    for (auto* v : graph.get_vertices()) {
+        if (v->is_hbox()) {
+            if (graph.get_num_neighbors(v) != 2 || v->get_phase() != dvlab::Phase(1)) {
+                spdlog::error("Vertex {} is an H-box other than Hadamard, which is not supported by the stabilizer formalism!!", v->get_id());
+                return std::nullopt;
+            }
+            toggled_leg_of.emplace(v, graph.get_first_neighbor(v).first);
+        }
+        if (v->get_phase().denominator() > 2) {
+            spdlog::error("Vertex {} has a non-Clifford phase {}!!", v->get_id(), v->get_phase().get_print_string());
+            return std::nullopt;
+        }
+        qubit_of.emplace(v, qubit_of.size());
+    }
+
+    std::vector<std::pair<size_t, size_t>> hadamard_edges;
+    size_t n_qubits = qubit_of.size();
+    graph.for_each_edge([&](zx::EdgePair const& epair) {
+        auto const& [v0, v1] = epair.first;
+        // X-spiders are Z-spiders with Hadamards on all legs
+        auto const is_toggled = [&](zx::ZXVertex* v, zx::ZXVertex* nb) {
+            return v->is_x() || (v->is_hbox() && toggled_leg_of.at(v) == nb);
+        };
+        auto const etype = zx::concat_edge(epair.second,
+                                           is_toggled(v0, v1) ? zx::EdgeType::hadamard : zx::EdgeType::simple,
+                                           is_toggled(v1, v0) ? zx::EdgeType::hadamard : zx::EdgeType::simple);
+        if (etype == zx::EdgeType::hadamard) {
+            hadamard_edges.emplace_back(qubit_of.at(v0), qubit_of.at(v1));
+        } else {
+            hadamard_edges.emplace_back(qubit_of.at(v0), n_qubits);
+            hadamard_edges.emplace_back(n_qubits, qubit_of.at(v1));
+            ++n_qubits;
+        }
+    });
+
+    auto tableau = StabilizerTableau(n_qubits);
+    for (size_t q = 0; q < n_qubits; ++q) tableau.h(q);
+    for (auto const& [q0, q1] : hadamard_edges) tableau.cz(q0, q1);
+
+    std::vector<bool> is_boundary(n_qubits, false);
+    for (auto const& [v, q] : qubit_of) {
+        is_boundary[q] = v->is_boundary();
+        if (v->is_hbox()) continue;
+        auto const k = (v->get_phase().numerator() * (2 / v->get_phase().denominator()) % 4 + 4) % 4;
+        if (k == 1) tableau.s(q);
+        if (k == 2) tableau.z(q);
+        if (k == 3) tableau.sdg(q);
+    }
+
+    for (size_t q = 0; q < n_qubits; ++q) {
+        if (is_boundary[q]) continue;
+        if (stop_requested()) {
+            spdlog::warn("Conversion interrupted.");
+            return std::nullopt;
+        }
+        tableau.h(q);
+        if (!tableau.postselect(q, false)) {
+            spdlog::error("The ZXGraph evaluates to zero!!");
+            return std::nullopt;
+        }
+    }
+
+    std::vector<size_t> boundaries;
+    for (auto* v : get_sorted_by_qubit(graph.get_inputs())) boundaries.emplace_back(qubit_of.at(v));
+    for (auto* v : get_sorted_by_qubit(graph.get_outputs())) boundaries.emplace_back(qubit_of.at(v));
+
+    return tableau.get_canonical_stabilizers(boundaries);
+}
+
+}  // namespace qsyn
@@ -0,0 +1,24 @@
+/****************************************************************************
+  PackageName  [ qsyn ]
+  Synopsis     [ Define conversion from ZXGraph to stabilizers ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#pragma once
+
+#include <optional>
+
+#include "qcir/simulator/stabilizer_tableau.hpp"
+
+namespace qsyn {
+
+namespace zx {
+
+class ZXGraph;
+
+}  // namespace zx
+
+std::optional<qcir::CanonicalStabilizers> to_canonical_stabilizers(zx::ZXGraph const& graph);
+
+}  // namespace qsyn
@@ -8,12 +8,14 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <cassert>
 #include <limits>
 #include <ranges>
 #include <tl/to.hpp>
 #include <unordered_map>
 
+#include "tensor/tensor_network.hpp"
 #include "zx/zx_def.hpp"
 #include "zx/zxgraph.hpp"
 
@@ -89,7 +91,99 @@ private:
     InOutAxisList _get_axis_orders(zx::ZXGraph const& zxgraph);
 };
 
-std::optional<tensor::QTensor<double>> to_tensor(zx::ZXGraph const& zxgraph) {
+namespace {
+
+/**
+ * @brief Convert a zxgraph to a tensor by planning a contraction order over the whole graph.
+ *        Each vertex becomes a tensor and each Hadamard edge becomes an H-box in between.
+ *        As with the traversal, only the vertices connected to the boundaries are contracted.
+ *
+ * @return std::optional<QTensor<double>> containing a QTensor<double> if the conversion succeeds
+ */
+std::optional<tensor::QTensor<double>> contract_as_network(zx::ZXGraph const& graph, tensor::ContractionStrategy strategy) {
+    if (graph.is_empty()) {
+        spdlog::error("The ZXGraph is empty!!");
+        return std::nullopt;
+    }
+    if (!graph.is_valid()) {
+        spdlog::error("The ZXGraph is not valid!!");
+        return std::nullopt;
+    }
+
+    tensor::TensorNetwork network;
+    std::vector<tensor::QTensor<double>> tensors;
+    std::unordered_map<zx::EdgePair, std::pair<size_t, size_t>, zx::EdgePairHash> edge_ids;  // edges at the (lower-id, higher-id) end
+    std::unordered_map<zx::ZXVertex*, size_t> boundary_edges;
+    size_t num_edges = 0;
+
+    for (auto* v : graph.create_topological_order()) {
+        std::vector<size_t> edges;
+        if (v->is_boundary()) {
+            boundary_edges.emplace(v, num_edges);
+            edges.emplace_back(num_edges++);
+        }
+        for (auto const& [nb, etype] : graph.get_neighbors(v)) {
+            auto const edge_key = make_edge_pair(v, nb, etype);
+            if (!edge_ids.contains(edge_key)) {
+                if (etype == zx::EdgeType::hadamard) {
+                    edge_ids.emplace(edge_key, std::make_pair(num_edges, num_edges + 1));
+                    network.add_tensor({num_edges, num_edges + 1});
+                    tensors.emplace_back(tensor::QTensor<double>::hbox(2));
+                    num_edges += 2;
+                } else {
+                    edge_ids.emplace(edge_key, std::make_pair(num_edges, num_edges));
+                    ++num_edges;
+                }
+            }
+            auto const [lower_end, higher_end] = edge_ids.at(edge_key);
+            edges.emplace_back(v->get_id() < nb->get_id() ? lower_end : higher_end);
+        }
+        network.add_tensor(std::move(edges));
+        tensors.emplace_back(get_tensor_form(graph, v));
+    }
+
+    if (network.get_num_tensors() == 0) {
+        network.add_tensor({});
+        tensors.emplace_back();
+    }
+
+    auto const plan = tensor::find_contraction_plan(network, strategy);
+    spdlog::info("Contracting {} tensors ({}): {:.3g} FLOPs, peak memory {:.3g} entries",
+                 network.get_num_tensors(), tensor::get_contraction_strategy_str(strategy), plan.cost.flops, plan.cost.peak_memory);
+
+    auto contracted = tensor::contract(std::move(tensors), network, plan);
+    if (!contracted.has_value()) {
+        spdlog::error("Conversion is interrupted!!");
+        return std::nullopt;
+    }
+    auto& result           = contracted->first;
+    auto const& open_edges = contracted->second;
+
+    auto const get_axes = [&](zx::ZXVertexList const& boundaries) {
+        auto sorted = boundaries | tl::to<std::vector>();
+        std::ranges::sort(sorted, [](zx::ZXVertex* a, zx::ZXVertex* b) { return a->get_qubit() < b->get_qubit(); });
+        return sorted | std::views::transform([&](zx::ZXVertex* v) -> size_t {
+                   return std::ranges::find(open_edges, boundary_edges.at(v)) - open_edges.begin();
+               }) |
+               tl::to<std::vector>();
+    };
+
+    return result.to_matrix(get_axes(graph.get_inputs()), get_axes(graph.get_outputs()));
+}
+
+}  // namespace
+
+/**
+ * @brief convert a zxgraph to a tensor
+ *
+ * @param strategy the sequential strategy contracts the vertices in topological order;
+ *        the others plan the contraction order over the whole graph first
+ * @return std::optional<QTensor<double>> containing a QTensor<double> if the conversion succeeds
+ */
+std::optional<tensor::QTensor<double>> to_tensor(zx::ZXGraph const& zxgraph, tensor::ContractionStrategy strategy) {
+    if (strategy != tensor::ContractionStrategy::sequential) {
+        return contract_as_network(zxgraph, strategy);
+    }
     ZX2TSMapper mapper;
     return mapper.map(zxgraph);
 }
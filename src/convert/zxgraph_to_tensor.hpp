@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "tensor/qtensor.hpp"
+#include "tensor/tensor_network.hpp"
 #include "zx/zx_def.hpp"
 
 namespace qsyn {
@@ -21,7 +22,7 @@ class ZXVertex;
 
 }  // namespace zx
 
-std::optional<tensor::QTensor<double>> to_tensor(zx::ZXGraph const& zxgraph);
+std::optional<tensor::QTensor<double>> to_tensor(zx::ZXGraph const& zxgraph, tensor::ContractionStrategy strategy = tensor::ContractionStrategy::sequential);
 
 tensor::QTensor<double> get_tensor_form(zx::ZXGraph const& graph, zx::ZXVertex* v);
 
@@ -11,10 +11,13 @@
 #include <fmt/std.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <gsl/narrow>
 #include <limits>
@@ -27,6 +30,7 @@
 #include "qcir/qcir_gate.hpp"
 #include "qsyn/qsyn_type.hpp"
 #include "util/dvlab_string.hpp"
+#include "util/mapped_file.hpp"
 #include "util/util.hpp"
 
 using namespace qsyn::qcir;
@@ -36,7 +40,7 @@ struct fmt::formatter<qsyn::device::PhysicalQubit> {
     constexpr auto parse(format_parse_context& ctx) { return ctx.begin(); }
 
     template <typename FormatContext>
-    auto format(qsyn::device::PhysicalQubit const& q, FormatContext& ctx) {
+    auto format(qsyn::device::PhysicalQubit const& q, FormatContext& ctx) const {
         return fmt::format_to(ctx.out(), "Q{:>2}, logical: {:>2}, lock until {}", q.get_id(), q.get_logical_qubit(), q.get_occupied_time());
     }
 };
@@ -90,6 +94,7 @@ DeviceInfo const& Topology::get_qubit_info(size_t a) {
 void Topology::add_adjacency_info(size_t a, size_t b, DeviceInfo info) {
     if (a > b) std::swap(a, b);
     _adjacency_info[std::make_pair(a, b)] = info;
+    _edge_calibrations.clear();
 }
 
 /**
@@ -100,6 +105,7 @@ void Topology::add_adjacency_info(size_t a, size_t b, DeviceInfo info) {
  */
 void Topology::add_qubit_info(size_t a, DeviceInfo info) {
     _qubit_info[a] = info;
+    _single_delay_ratios.clear();
 }
 
 /**
@@ -117,55 +123,670 @@ void Topology::print_single_edge(size_t a, size_t b) const {
     }
 }
 
-// SECTION - Class PhysicalQubit Member Functions
+/**
+ * @brief Add an undirected edge (a,b) to the coupling graph. Invalidates the shortest paths.
+ *
+ * @param a Id of first qubit
+ * @param b Id of second qubit
+ */
+void Topology::add_adjacency(QubitIdType a, QubitIdType b) {
+    auto const max_id = static_cast<size_t>(std::max(a, b));
+    if (_adjacencies.size() <= max_id) _adjacencies.resize(max_id + 1);
+    if (std::ranges::find(_adjacencies[a], b) == _adjacencies[a].end()) _adjacencies[a].emplace_back(b);
+    if (std::ranges::find(_adjacencies[b], a) == _adjacencies[b].end()) _adjacencies[b].emplace_back(a);
+    _edge_calibrations.clear();
+    _predecessor.clear();
+    _distance.clear();
+}
 
 /**
- * @brief Operator overloading
+ * @brief Get the neighbors of a qubit in the coupling graph
  *
- * @param os
- * @param q
- * @return ostream&
+ * @param id
+ * @return Adjacencies const&
  */
-std::ostream& operator<<(std::ostream& os, PhysicalQubit const& q) {
-    return os << fmt::format("{}", q);
+Topology::Adjacencies const& Topology::get_adjacencies(QubitIdType id) const {
+    static Adjacencies const empty;
+    return std::cmp_less(id, _adjacencies.size()) ? _adjacencies[id] : empty;
 }
 
 /**
- * @brief Mark qubit
+ * @brief Check if (a,b) is an edge of the coupling graph
  *
- * @param source false: from 0, true: from 1
- * @param pred predecessor
  */
-void PhysicalQubit::mark(bool source, QubitIdType pred) {
-    _marked = true;
-    _source = source;
-    _pred   = pred;
+bool Topology::is_adjacent(QubitIdType a, QubitIdType b) const {
+    auto const& adjacencies = get_adjacencies(a);
+    return std::ranges::find(adjacencies, b) != adjacencies.end();
 }
 
+namespace {
+
+size_t scale_delay(size_t base_delay, float ratio) {
+    return std::max<size_t>(1, gsl::narrow_cast<size_t>(std::lround(static_cast<double>(base_delay) * ratio)));
+}
+
+}  // namespace
+
 /**
- * @brief Take the route
+ * @brief Set how the calibration data enters routing. Invalidates the shortest paths.
  *
  * @param cost
- * @param swapTime
  */
-void PhysicalQubit::take_route(size_t cost, size_t swap_time) {
-    _cost      = cost;
-    _swap_time = swap_time;
-    _taken     = true;
+void Topology::set_routing_cost(RoutingCost cost) {
+    _routing_cost = cost;
+    _calibrate();
+    _predecessor.clear();
+    _distance.clear();
+}
+
+/**
+ * @brief Compute the delay and infidelity of each gate relative to the device average.
+ *        Gates without calibration data (zero delay or error) are taken as average.
+ *
+ */
+void Topology::_calibrate() {
+    // errors compound multiplicatively along a path, so a coupler costs -log(1 - error)
+    auto const infidelity = [](float error) { return -std::log1p(-std::min(static_cast<double>(error), 1. - 1e-9)); };
+    auto const ratio      = [](double value, double sum, size_t count) {
+        return (value > 0 && count > 0) ? static_cast<float>(value * static_cast<double>(count) / sum) : 1.F;
+    };
+
+    double delay_sum = 0., infidelity_sum = 0.;
+    size_t num_delays = 0, num_infidelities = 0;
+    for (auto const& [_, info] : _adjacency_info) {
+        if (info._time > 0) {
+            delay_sum += info._time;
+            ++num_delays;
+        }
+        if (info._error > 0) {
+            infidelity_sum += infidelity(info._error);
+            ++num_infidelities;
+        }
+    }
+
+    _edge_calibrations.assign(_adjacencies.size(), {});
+    for (size_t i = 0; i < _adjacencies.size(); i++) {
+        for (auto const adj : _adjacencies[i]) {
+            auto const it = _adjacency_info.find(std::make_pair(std::min<size_t>(i, adj), std::max<size_t>(i, adj)));
+            if (it == _adjacency_info.end()) {
+                _edge_calibrations[i].emplace_back();
+                continue;
+            }
+            _edge_calibrations[i].push_back({.delay_ratio      = ratio(it->second._time, delay_sum, num_delays),
+                                             .infidelity_ratio = ratio(it->second._error > 0 ? infidelity(it->second._error) : 0., infidelity_sum, num_infidelities)});
+        }
+    }
+
+    double single_delay_sum = 0.;
+    size_t num_single_delays = 0, max_qubit = 0;
+    for (auto const& [qubit, info] : _qubit_info) {
+        max_qubit = std::max(max_qubit, qubit + 1);
+        if (info._time > 0) {
+            single_delay_sum += info._time;
+            ++num_single_delays;
+        }
+    }
+    _single_delay_ratios.assign(max_qubit, 1.F);
+    for (auto const& [qubit, info] : _qubit_info) {
+        _single_delay_ratios[qubit] = ratio(info._time, single_delay_sum, num_single_delays);
+    }
+}
+
+/**
+ * @brief Get the calibration of the edge (a,b), or the device average if there is none
+ *
+ */
+Topology::EdgeCalibration Topology::_get_edge_calibration(QubitIdType a, QubitIdType b) const {
+    if (std::cmp_greater_equal(a, _edge_calibrations.size())) return {};
+    auto const& adjacencies = get_adjacencies(a);
+    auto const k            = static_cast<size_t>(std::ranges::find(adjacencies, b) - adjacencies.begin());
+    return k < _edge_calibrations[a].size() ? _edge_calibrations[a][k] : EdgeCalibration{};
+}
+
+/**
+ * @brief Get the duration of a single-qubit gate on qubit a
+ *
+ */
+size_t Topology::get_single_duration(QubitIdType a) const {
+    if (_routing_cost == RoutingCost::uniform || std::cmp_greater_equal(a, _single_delay_ratios.size())) return SINGLE_DELAY;
+    return scale_delay(SINGLE_DELAY, _single_delay_ratios[a]);
+}
+
+/**
+ * @brief Get the duration of a double-qubit gate on the edge (a,b)
+ *
+ */
+size_t Topology::get_double_duration(QubitIdType a, QubitIdType b) const {
+    if (_routing_cost == RoutingCost::uniform) return DOUBLE_DELAY;
+    return scale_delay(DOUBLE_DELAY, _get_edge_calibration(a, b).delay_ratio);
+}
+
+/**
+ * @brief Get the duration of a SWAP gate on the edge (a,b)
+ *
+ */
+size_t Topology::get_swap_duration(QubitIdType a, QubitIdType b) const {
+    if (_routing_cost == RoutingCost::uniform) return SWAP_DELAY;
+    return scale_delay(SWAP_DELAY, _get_edge_calibration(a, b).delay_ratio);
+}
+
+/**
+ * @brief Get the extra routing cost of a SWAP on the edge (a,b) for its infidelity,
+ *        in the same unit as the durations. An average coupler costs SWAP_DELAY.
+ *
+ */
+size_t Topology::get_swap_penalty(QubitIdType a, QubitIdType b) const {
+    if (_routing_cost != RoutingCost::fidelity) return 0;
+    return gsl::narrow_cast<size_t>(std::lround(static_cast<double>(SWAP_DELAY) * _get_edge_calibration(a, b).infidelity_ratio));
+}
+
+/**
+ * @brief Get the weight of the edge (a,b) in the shortest paths
+ *
+ */
+int Topology::_get_path_weight(QubitIdType a, QubitIdType b) const {
+    switch (_routing_cost) {
+        case RoutingCost::delay:
+            return gsl::narrow<int>(get_swap_duration(a, b));
+        case RoutingCost::fidelity:
+            return gsl::narrow<int>(std::max<size_t>(1, get_swap_penalty(a, b)));
+        case RoutingCost::uniform:
+        default:
+            return 1;
+    }
+}
+
+/**
+ * @brief Calculate Shortest Path
+ *
+ */
+void Topology::calculate_path() {
+    if (_routing_cost != RoutingCost::uniform) _calibrate();
+    _initialize_floyd_warshall();
+    _floyd_warshall();
+
+    if (spdlog::default_logger()->should_log(spdlog::level::debug)) {
+        for (size_t i = 0; i < _num_qubit; i++) {
+            spdlog::debug("{:5}", fmt::join(_predecessor_row(i) | std::views::transform([](QubitIdType j) { return (j == max_qubit_id) ? std::string{"/"} : std::to_string(j); }), ""));
+        }
+        for (size_t i = 0; i < _num_qubit; i++) {
+            spdlog::debug("{:5}", fmt::join(_distance_row(i) | std::views::transform([this](int j) { return (j == _max_dist) ? std::string{"X"} : std::to_string(j); }), ""));
+        }
+    }
+}
+
+/**
+ * @brief Init data for Floyd-Warshall Algorithm: the edge weights along the edges and `_max_dist` elsewhere
+ *
+ */
+void Topology::_initialize_floyd_warshall() {
+    _distance.assign(_num_qubit * _num_qubit, _max_dist);
+    _predecessor.assign(_num_qubit * _num_qubit, max_qubit_id);
+
+    for (size_t i = 0; i < _num_qubit; i++) {
+        _distance[i * _num_qubit + i] = 0;
+        for (auto const& adj : get_adjacencies(gsl::narrow<QubitIdType>(i))) {
+            if (std::cmp_greater_equal(adj, _num_qubit) || std::cmp_equal(adj, i)) continue;
+            _distance[i * _num_qubit + adj]    = _get_path_weight(gsl::narrow<QubitIdType>(i), adj);
+            _predecessor[i * _num_qubit + adj] = gsl::narrow<QubitIdType>(i);
+        }
+    }
+}
+
+/**
+ * @brief Floyd-Warshall Algorithm. Solve All Pairs Shortest Path (APSP)
+ *
+ *        Row k and column k do not change in iteration k, so the rows are relaxed in
+ *        parallel, and the result (including the predecessors picked on ties) is the
+ *        same as the sequential algorithm.
+ */
+void Topology::_floyd_warshall() {
+    auto const n = _num_qubit;
+    for (size_t k = 0; k < n; k++) {
+        auto const* const dist_k = _distance.data() + k * n;
+        auto const* const pred_k = _predecessor.data() + k * n;
+#pragma omp parallel for schedule(static) if (n >= 256)
+        for (size_t i = 0; i < n; i++) {
+            auto const dist_ik = _distance[i * n + k];
+            if (dist_ik == _max_dist) continue;
+            auto* const dist_i = _distance.data() + i * n;
+            auto* const pred_i = _predecessor.data() + i * n;
+            for (size_t j = 0; j < n; j++) {
+                // NOTE - both summands are below _max_dist = INT_MAX / 2 here, so the sum does not overflow
+                if (dist_k[j] == _max_dist) continue;
+                auto const through_k = dist_ik + dist_k[j];
+                if (dist_i[j] > through_k) {
+                    dist_i[j] = through_k;
+                    pred_i[j] = pred_k[j];
+                }
+            }
+        }
+    }
 }
 
 /**
- * @brief Reset qubit
+ * @brief Check that distance and predecessor tables read from a file are shortest-path trees of this
+ *        coupling graph. Every predecessor is a neighbor strictly closer to the source, so walking
+ *        the predecessors back from any reachable qubit ends at the source.
  *
+ * @param distance row-major, _num_qubit x _num_qubit
+ * @param predecessor row-major, _num_qubit x _num_qubit
+ * @return true if the tables are consistent
  */
-void PhysicalQubit::reset() {
-    _marked = false;
-    _taken  = false;
-    _cost   = _occupied_time;
+bool Topology::_paths_are_consistent(std::span<int const> distance, std::span<QubitIdType const> predecessor) const {
+    auto const n = _num_qubit;
+    if (distance.size() != n * n || predecessor.size() != n * n) return false;
+    for (size_t i = 0; i < n; i++) {
+        auto const dist_i = distance.subspan(i * n, n);
+        auto const pred_i = predecessor.subspan(i * n, n);
+        if (dist_i[i] != 0 || pred_i[i] != max_qubit_id) return false;
+        for (size_t j = 0; j < n; j++) {
+            if (j == i) continue;
+            if (dist_i[j] <= 0 || dist_i[j] > _max_dist) return false;
+            auto const pred = pred_i[j];
+            if (pred == max_qubit_id) {
+                if (dist_i[j] != _max_dist) return false;
+                continue;
+            }
+            if (pred < 0 || std::cmp_greater_equal(pred, n) || dist_i[j] == _max_dist ||
+                dist_i[pred] >= dist_i[j] || !is_adjacent(pred, gsl::narrow<QubitIdType>(j))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+namespace {
+
+constexpr std::string_view apsp_cache_magic = "QSYNAPSP";
+constexpr uint32_t apsp_cache_version       = 2;
+
+}  // namespace
+
+/**
+ * @brief Fingerprint of the coupling graph that the shortest paths are computed from
+ *
+ * @return uint64_t
+ */
+uint64_t Topology::_coupling_hash() const {
+    uint64_t h         = 0xcbf29ce484222325;
+    auto const combine = [&h](uint64_t v) {
+        h ^= v;
+        h *= 0x100000001b3;
+    };
+    combine(_num_qubit);
+    for (size_t i = 0; i < _num_qubit; i++) {
+        auto const& adjacencies = get_adjacencies(gsl::narrow<QubitIdType>(i));
+        combine(adjacencies.size());
+        for (auto const adj : adjacencies) combine(static_cast<uint64_t>(adj));
+    }
+    return h;
+}
+
+/**
+ * @brief Write the distance and predecessor tables to a binary file
+ *
+ * @param filepath
+ * @return true if successfully written
+ */
+bool Topology::write_path_cache(std::filesystem::path const& filepath) const {
+    if (!has_paths() || _routing_cost != RoutingCost::uniform) return false;
+    std::ofstream ofs{filepath, std::ios::binary};
+    if (!ofs) return false;
+
+    uint64_t const n    = _num_qubit;
+    uint64_t const hash = _coupling_hash();
+    ofs.write(apsp_cache_magic.data(), gsl::narrow<std::streamsize>(apsp_cache_magic.size()));
+    ofs.write(reinterpret_cast<char const*>(&apsp_cache_version), sizeof(apsp_cache_version));
+    ofs.write(reinterpret_cast<char const*>(&n), sizeof(n));
+    ofs.write(reinterpret_cast<char const*>(&hash), sizeof(hash));
+    ofs.write(reinterpret_cast<char const*>(_distance.data()), gsl::narrow<std::streamsize>(_distance.size() * sizeof(int)));
+    ofs.write(reinterpret_cast<char const*>(_predecessor.data()), gsl::narrow<std::streamsize>(_predecessor.size() * sizeof(QubitIdType)));
+    return ofs.good();
+}
+
+/**
+ * @brief Read the distance and predecessor tables from a binary file written by `write_path_cache`.
+ *        Fails if the file is written for another coupling graph.
+ *
+ * @param filepath
+ * @return true if successfully read
+ */
+bool Topology::read_path_cache(std::filesystem::path const& filepath) {
+    if (_routing_cost != RoutingCost::uniform) return false;
+    std::ifstream ifs{filepath, std::ios::binary};
+    if (!ifs) return false;
+
+    std::array<char, apsp_cache_magic.size()> magic{};
+    uint32_t version = 0;
+    uint64_t n = 0, hash = 0;
+    ifs.read(magic.data(), gsl::narrow<std::streamsize>(magic.size()));
+    ifs.read(reinterpret_cast<char*>(&version), sizeof(version));
+    ifs.read(reinterpret_cast<char*>(&n), sizeof(n));
+    ifs.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+    if (!ifs || std::string_view{magic.data(), magic.size()} != apsp_cache_magic ||
+        version != apsp_cache_version || n != _num_qubit || hash != _coupling_hash()) {
+        return false;
+    }
+
+    std::vector<int> distance(_num_qubit * _num_qubit);
+    std::vector<QubitIdType> predecessor(_num_qubit * _num_qubit);
+    ifs.read(reinterpret_cast<char*>(distance.data()), gsl::narrow<std::streamsize>(distance.size() * sizeof(int)));
+    ifs.read(reinterpret_cast<char*>(predecessor.data()), gsl::narrow<std::streamsize>(predecessor.size() * sizeof(QubitIdType)));
+    if (!ifs || !_paths_are_consistent(distance, predecessor)) return false;
+
+    _distance    = std::move(distance);
+    _predecessor = std::move(predecessor);
+    return true;
+}
+
+/**
+ * @brief Print Predecessor
+ *
+ */
+void Topology::print_predecessor() const {
+    fmt::println("Predecessor Matrix:");
+    for (size_t i = 0; has_paths() && i < _num_qubit; i++) {
+        fmt::println("{:5}", fmt::join(_predecessor_row(i) | std::views::transform([](auto pred) { return (pred == max_qubit_id) ? "/" : std::to_string(pred); }), ""));
+    }
+}
+
+/**
+ * @brief Print Distance
+ *
+ */
+void Topology::print_distance() const {
+    fmt::println("Distance Matrix:");
+    for (size_t i = 0; has_paths() && i < _num_qubit; i++) {
+        fmt::println("{:5}", fmt::join(_distance_row(i) | std::views::transform([this](int dist) { return (dist == _max_dist) ? "X" : std::to_string(dist); }), ""));
+    }
+}
+
+namespace {
+
+constexpr std::string_view binary_device_magic = "QSYNDEVB";
+constexpr uint32_t binary_device_version       = 2;
+constexpr uint32_t binary_device_has_paths     = 1U << 0;
+
+/**
+ * @brief Header of the binary device format. The sections that follow are, in order:
+ *        name, gate set (comma-separated), CSR offsets (uint64, n + 1), CSR neighbors (int32),
+ *        CNOT delay and error (float, aligned with the neighbors), single-qubit delay and error
+ *        (float, n each), and if `binary_device_has_paths` is set, the distance and predecessor
+ *        matrices (int32, n x n each, row-major). Every section is padded to 8 bytes.
+ *
+ */
+struct BinaryDeviceHeader {
+    std::array<char, 8> magic{};
+    uint32_t version         = 0;
+    uint32_t flags           = 0;
+    uint64_t num_qubits      = 0;
+    uint64_t num_adjacencies = 0;  // CSR entries; every edge appears once from each end
+    uint64_t name_size       = 0;
+    uint64_t gate_set_size   = 0;
+};
+
+template <typename T, size_t N>
+void write_section(std::ostream& os, std::span<T, N> values) {
+    constexpr std::array<char, 8> padding{};
+    os.write(reinterpret_cast<char const*>(values.data()), gsl::narrow<std::streamsize>(values.size_bytes()));
+    os.write(padding.data(), gsl::narrow<std::streamsize>((8 - values.size_bytes() % 8) % 8));
+}
+
+/**
+ * @brief Read the sections of a binary device in order. The data is copied out, so the
+ *        buffer needs no particular alignment.
+ *
+ */
+class SectionReader {
+public:
+    SectionReader(std::string_view data) : _rest{data} {}
+
+    size_t remaining() const { return _rest.size(); }
+
+    template <typename T>
+    bool read(std::span<T> values) {
+        auto const size        = values.size_bytes();
+        auto const padded_size = size + (8 - size % 8) % 8;
+        if (_rest.size() < padded_size) return false;
+        std::memcpy(values.data(), _rest.data(), size);
+        _rest.remove_prefix(padded_size);
+        return true;
+    }
+
+private:
+    std::string_view _rest;
+};
+
+}  // namespace
+
+/**
+ * @brief Get the information of the edge (a,b) without inserting a default one
+ *
+ */
+DeviceInfo Topology::_find_adjacency_info(size_t a, size_t b) const {
+    auto const it = _adjacency_info.find(std::make_pair(std::min(a, b), std::max(a, b)));
+    return it == _adjacency_info.end() ? DeviceInfo{._time = 0.0, ._error = 0.0} : it->second;
+}
+
+/**
+ * @brief Get the information of the qubit without inserting a default one
+ *
+ */
+DeviceInfo Topology::_find_qubit_info(size_t a) const {
+    auto const it = _qubit_info.find(a);
+    return it == _qubit_info.end() ? DeviceInfo{._time = 0.0, ._error = 0.0} : it->second;
+}
+
+/**
+ * @brief Check if the data starts like a binary device file
+ *
+ */
+bool Topology::is_binary(std::string_view data) {
+    return data.starts_with(binary_device_magic);
+}
+
+/**
+ * @brief Write the topology in the text layout format read by `Device::read_device`
+ *
+ * @param os
+ * @param num_qubits
+ */
+void Topology::write_layout(std::ostream& os, size_t num_qubits) const {
+    std::vector<std::string> coupling_map, cx_error, cx_delay;
+    std::vector<float> single_error, single_delay;
+    for (size_t i = 0; i < num_qubits; i++) {
+        auto const& adjacencies = get_adjacencies(gsl::narrow<QubitIdType>(i));
+        std::vector<float> errors, delays;
+        for (auto const adj : adjacencies) {
+            auto const info = _find_adjacency_info(i, adj);
+            errors.emplace_back(info._error);
+            delays.emplace_back(info._time);
+        }
+        coupling_map.emplace_back(fmt::format("[{}]", fmt::join(adjacencies, ",")));
+        cx_error.emplace_back(fmt::format("[{}]", fmt::join(errors, ",")));
+        cx_delay.emplace_back(fmt::format("[{}]", fmt::join(delays, ",")));
+        auto const info = _find_qubit_info(i);
+        single_error.emplace_back(info._error);
+        single_delay.emplace_back(info._time);
+    }
+
+    fmt::print(os, "NAME: {}\n", _name);
+    fmt::print(os, "QUBITNUM: {}\n", num_qubits);
+    fmt::print(os, "GATESET: {{{}}}\n", fmt::join(_gate_set | std::views::transform([](GateType const& type) { return gate_type_to_str(type); }), ", "));
+    fmt::print(os, "COUPLINGMAP: [{}]\n", fmt::join(coupling_map, ", "));
+    fmt::print(os, "SGERROR: [{}]\n", fmt::join(single_error, ", "));
+    fmt::print(os, "SGTIME: [{}]\n", fmt::join(single_delay, ", "));
+    fmt::print(os, "CNOTERROR: [{}]\n", fmt::join(cx_error, ", "));
+    fmt::print(os, "CNOTTIME: [{}]\n", fmt::join(cx_delay, ", "));
+}
+
+/**
+ * @brief Write the topology in the binary device format. The shortest paths are included
+ *        if they are computed for the uniform routing cost.
+ *
+ * @param os
+ * @param num_qubits
+ */
+void Topology::write_binary(std::ostream& os, size_t num_qubits) const {
+    auto const gate_set = fmt::format("{}", fmt::join(_gate_set | std::views::transform([](GateType const& type) { return gate_type_to_str(type); }), ","));
+
+    std::vector<uint64_t> offsets{0};
+    std::vector<QubitIdType> neighbors;
+    std::vector<float> cx_delay, cx_error, single_delay, single_error;
+    for (size_t i = 0; i < num_qubits; i++) {
+        for (auto const adj : get_adjacencies(gsl::narrow<QubitIdType>(i))) {
+            auto const info = _find_adjacency_info(i, adj);
+            neighbors.emplace_back(adj);
+            cx_delay.emplace_back(info._time);
+            cx_error.emplace_back(info._error);
+        }
+        offsets.emplace_back(neighbors.size());
+        auto const info = _find_qubit_info(i);
+        single_delay.emplace_back(info._time);
+        single_error.emplace_back(info._error);
+    }
+
+    auto const with_paths = has_paths() && _routing_cost == RoutingCost::uniform && _num_qubit == num_qubits;
+
+    BinaryDeviceHeader header;
+    std::ranges::copy(binary_device_magic, header.magic.begin());
+    header.version         = binary_device_version;
+    header.flags           = with_paths ? binary_device_has_paths : 0;
+    header.num_qubits      = num_qubits;
+    header.num_adjacencies = neighbors.size();
+    header.name_size       = _name.size();
+    header.gate_set_size   = gate_set.size();
+
+    write_section(os, std::span{&header, 1});
+    write_section(os, std::span{_name});
+    write_section(os, std::span{gate_set});
+    write_section(os, std::span<uint64_t const>{offsets});
+    write_section(os, std::span<QubitIdType const>{neighbors});
+    write_section(os, std::span<float const>{cx_delay});
+    write_section(os, std::span<float const>{cx_error});
+    write_section(os, std::span<float const>{single_delay});
+    write_section(os, std::span<float const>{single_error});
+    if (with_paths) {
+        write_section(os, std::span<int const>{_distance});
+        write_section(os, std::span<QubitIdType const>{_predecessor});
+    }
+}
+
+/**
+ * @brief Read the topology from the binary device format, replacing the current one
+ *
+ * @param data the whole file
+ * @param num_qubits set to the number of qubits of the device
+ * @return true if successfully read
+ */
+bool Topology::read_binary(std::string_view data, size_t& num_qubits) {
+    SectionReader reader{data};
+    BinaryDeviceHeader header;
+    if (!reader.read(std::span{&header, 1}) ||
+        std::string_view{header.magic.data(), header.magic.size()} != binary_device_magic) {
+        spdlog::error("Not a binary device file!!");
+        return false;
+    }
+    if (header.version != binary_device_version) {
+        spdlog::error("Unsupported binary device version {} (expected {})!!", header.version, binary_device_version);
+        return false;
+    }
+    // NOTE - reject sizes the file cannot hold before allocating for them
+    auto const n = header.num_qubits;
+    if (n > reader.remaining() || header.num_adjacencies > reader.remaining() ||
+        header.name_size > reader.remaining() || header.gate_set_size > reader.remaining() ||
+        ((header.flags & binary_device_has_paths) && n * n > reader.remaining())) {
+        spdlog::error("The binary device file is truncated!!");
+        return false;
+    }
+
+    std::string name(header.name_size, '\0'), gate_set(header.gate_set_size, '\0');
+    std::vector<uint64_t> offsets(n + 1);
+    std::vector<QubitIdType> neighbors(header.num_adjacencies);
+    std::vector<float> cx_delay(header.num_adjacencies), cx_error(header.num_adjacencies), single_delay(n), single_error(n);
+    std::vector<int> distance;
+    std::vector<QubitIdType> predecessor;
+    if (header.flags & binary_device_has_paths) {
+        distance.resize(n * n);
+        predecessor.resize(n * n);
+    }
+    if (!reader.read(std::span{name}) || !reader.read(std::span{gate_set}) ||
+        !reader.read(std::span{offsets}) || !reader.read(std::span{neighbors}) ||
+        !reader.read(std::span{cx_delay}) || !reader.read(std::span{cx_error}) ||
+        !reader.read(std::span{single_delay}) || !reader.read(std::span{single_error}) ||
+        !reader.read(std::span{distance}) || !reader.read(std::span{predecessor})) {
+        spdlog::error("The binary device file is truncated!!");
+        return false;
+    }
+    if (offsets.front() != 0 || offsets.back() != neighbors.size() || !std::ranges::is_sorted(offsets) ||
+        std::ranges::any_of(neighbors, [n](QubitIdType q) { return q < 0 || std::cmp_greater_equal(q, n); })) {
+        spdlog::error("The adjacency lists in the binary device file are corrupted!!");
+        return false;
+    }
+
+    Topology topology;
+    topology._name      = std::move(name);
+    topology._num_qubit = n;
+    for (auto const& str : dvlab::str::views::tokenize(gate_set, ',')) {
+        auto const gate_type = str_to_gate_type(str);
+        if (!gate_type.has_value()) {
+            spdlog::error("unsupported gate type \"{}\"!!", str);
+            return false;
+        }
+        topology._gate_set.emplace_back(gate_type.value());
+    }
+    topology._adjacencies.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        for (auto k = offsets[i]; k < offsets[i + 1]; k++) {
+            topology._adjacencies[i].emplace_back(neighbors[k]);
+            if (std::cmp_less(i, neighbors[k])) {
+                topology._adjacency_info[std::make_pair(i, static_cast<size_t>(neighbors[k]))] = {._time = cx_delay[k], ._error = cx_error[k]};
+            }
+        }
+        topology._qubit_info[i] = {._time = single_delay[i], ._error = single_error[i]};
+    }
+    if ((header.flags & binary_device_has_paths) && !topology._paths_are_consistent(distance, predecessor)) {
+        spdlog::error("The shortest paths in the binary device file are corrupted!!");
+        return false;
+    }
+    topology._distance    = std::move(distance);
+    topology._predecessor = std::move(predecessor);
+
+    *this      = std::move(topology);
+    num_qubits = n;
+    return true;
+}
+
+// SECTION - Class PhysicalQubit Member Functions
+
+/**
+ * @brief Operator overloading
+ *
+ * @param os
+ * @param q
+ * @return ostream&
+ */
+std::ostream& operator<<(std::ostream& os, PhysicalQubit const& q) {
+    return os << fmt::format("{}", q);
 }
 
 // SECTION - Class Device Member Functions
 
+/**
+ * @brief Get the topology for modification. Detaches it first if it is shared with other devices.
+ *
+ * @return Topology&
+ */
+Topology& Device::_mutable_topology() {
+    if (_topology.use_count() > 1) {
+        spdlog::debug("Copying the topology of \"{}\" shared with other devices before modifying it", get_name());
+        _topology = std::make_shared<Topology>(*_topology);
+    }
+    return *_topology;
+}
+
 /**
  * @brief Get next swap cost
  *
@@ -174,12 +795,12 @@ void PhysicalQubit::reset() {
  * @return tuple<size_t, size_t> (index of next qubit, cost)
  */
 std::tuple<QubitIdType, QubitIdType> Device::get_next_swap_cost(QubitIdType source, QubitIdType target) {
-    auto const next_idx  = _predecessor[source][target];
+    auto const next_idx  = _topology->get_predecessor(source, target);
     auto const& q_source = get_physical_qubit(source);
     auto const& q_next   = get_physical_qubit(next_idx);
     auto const cost      = std::max(q_source.get_occupied_time(), q_next.get_occupied_time());
 
-    assert(q_source.is_adjacency(q_next));
+    assert(is_adjacent(source, next_idx));
     return {next_idx, cost};
 }
 
@@ -190,7 +811,7 @@ std::tuple<QubitIdType, QubitIdType> Device::get_next_swap_cost(QubitIdType sour
  * @return size_t
  */
 QubitIdType Device::get_physical_by_logical(QubitIdType id) {
-    for (auto& [_, phy] : _qubit_list) {
+    for (auto& phy : _qubit_list) {
         if (phy.get_logical_qubit() == id) {
             return phy.get_id();
         }
@@ -198,6 +819,17 @@ QubitIdType Device::get_physical_by_logical(QubitIdType id) {
     return max_qubit_id;
 }
 
+/**
+ * @brief Add a physical qubit, or overwrite the one with the same id
+ *
+ * @param q
+ */
+void Device::add_physical_qubit(PhysicalQubit q) {
+    auto const id = static_cast<size_t>(q.get_id());
+    if (_qubit_list.size() <= id) _qubit_list.resize(id + 1);
+    _qubit_list[id] = q;
+}
+
 /**
  * @brief Add adjacency pair (a,b)
  *
@@ -212,10 +844,10 @@ void Device::add_adjacency(QubitIdType a, QubitIdType b) {
     if (!qubit_id_exists(b)) {
         add_physical_qubit(PhysicalQubit(b));
     }
-    _qubit_list[a].add_adjacency(_qubit_list[b].get_id());
-    _qubit_list[b].add_adjacency(_qubit_list[a].get_id());
+    auto& topology = _mutable_topology();
+    topology.add_adjacency(a, b);
     constexpr DeviceInfo default_info = {._time = 0.0, ._error = 0.0};
-    _topology->add_adjacency_info(a, b, default_info);
+    topology.add_adjacency_info(a, b, default_info);
 }
 
 /**
@@ -233,14 +865,14 @@ void Device::apply_gate(Operation const& op) {
         auto temp = q0.get_logical_qubit();
         q0.set_logical_qubit(q1.get_logical_qubit());
         q1.set_logical_qubit(temp);
-        q0.set_occupied_time(t + SWAP_DELAY);
-        q1.set_occupied_time(t + SWAP_DELAY);
+        q0.set_occupied_time(t + get_swap_duration(q0.get_id(), q1.get_id()));
+        q1.set_occupied_time(t + get_swap_duration(q0.get_id(), q1.get_id()));
     } else if (op.is_cx()) {
-        q0.set_occupied_time(t + DOUBLE_DELAY);
-        q1.set_occupied_time(t + DOUBLE_DELAY);
+        q0.set_occupied_time(t + get_double_duration(q0.get_id(), q1.get_id()));
+        q1.set_occupied_time(t + get_double_duration(q0.get_id(), q1.get_id()));
     } else if (op.is_cz()) {
-        q0.set_occupied_time(t + DOUBLE_DELAY);
-        q1.set_occupied_time(t + DOUBLE_DELAY);
+        q0.set_occupied_time(t + get_double_duration(q0.get_id(), q1.get_id()));
+        q1.set_occupied_time(t + get_double_duration(q0.get_id(), q1.get_id()));
     } else {
         DVLAB_ASSERT(false, "Unknown gate type at apply_gate()!!");
     }
@@ -258,8 +890,8 @@ void Device::apply_swap_check(QubitIdType qid0, QubitIdType qid1) {
     q0.set_logical_qubit(q1.get_logical_qubit());
     q1.set_logical_qubit(temp);
     auto const max_occupied_time = std::max(q0.get_occupied_time(), q1.get_occupied_time());
-    q0.set_occupied_time(max_occupied_time + DOUBLE_DELAY);
-    q1.set_occupied_time(max_occupied_time + DOUBLE_DELAY);
+    q0.set_occupied_time(max_occupied_time + get_swap_duration(qid0, qid1));
+    q1.set_occupied_time(max_occupied_time + get_swap_duration(qid0, qid1));
 }
 
 /**
@@ -269,8 +901,7 @@ void Device::apply_swap_check(QubitIdType qid0, QubitIdType qid1) {
  */
 void Device::apply_single_qubit_gate(QubitIdType physical_id) {
     auto const start_time = _qubit_list[physical_id].get_occupied_time();
-    _qubit_list[physical_id].set_occupied_time(start_time + SINGLE_DELAY);
-    _qubit_list[physical_id].reset();
+    _qubit_list[physical_id].set_occupied_time(start_time + get_single_duration(physical_id));
 }
 
 /**
@@ -281,8 +912,8 @@ void Device::apply_single_qubit_gate(QubitIdType physical_id) {
 std::vector<std::optional<size_t>> Device::mapping() const {
     std::vector<std::optional<size_t>> ret;
     ret.resize(_qubit_list.size());
-    for (auto const& [id, qubit] : _qubit_list) {
-        ret[id] = qubit.get_logical_qubit();
+    for (size_t i = 0; i < _qubit_list.size(); ++i) {
+        ret[i] = _qubit_list[i].get_logical_qubit();
     }
     return ret;
 }
@@ -300,97 +931,26 @@ void Device::place(std::vector<QubitIdType> const& assignment) {
 }
 
 /**
- * @brief Calculate Shortest Path
+ * @brief Set how the calibration data enters routing, and recalculate the shortest paths if there are any
  *
+ * @param cost
  */
-void Device::calculate_path() {
-    _predecessor.clear();
-    _distance.clear();
-    _adjacency_matrix.clear();
-    _adjacency_matrix.resize(get_num_qubits());
-    for (size_t i = 0; i < get_num_qubits(); i++) {
-        _adjacency_matrix[i].resize(get_num_qubits(), _max_dist);
-        for (size_t j = 0; j < get_num_qubits(); j++) {
-            if (i == j)
-                _adjacency_matrix[i][j] = 0;
-        }
-    }
-    floyd_warshall();
-    _adjacency_matrix.clear();
-}
-
-/**
- * @brief Init data for Floyd-Warshall Algorithm
- *
- */
-void Device::_initialize_floyd_warshall() {
-    _distance.resize(get_num_qubits());
-    _predecessor.resize(get_num_qubits());
-
-    for (size_t i = 0; i < get_num_qubits(); i++) {
-        _distance[i].resize(get_num_qubits());
-        _predecessor[i].resize(get_num_qubits(), max_qubit_id);
-        for (size_t j = 0; j < get_num_qubits(); j++) {
-            _distance[i][j] = _adjacency_matrix[i][j];
-            if (_distance[i][j] != 0 && _distance[i][j] != _max_dist) {
-                _predecessor[i][j] = _qubit_list[gsl::narrow<QubitIdType>(i)].get_id();
-            }
-        }
-    }
-
-    spdlog::debug("Predecessor Matrix:");
-    for (auto& row : _predecessor) {
-        spdlog::debug("{:5}", fmt::join(row | std::views::transform([](QubitIdType j) { return (j == max_qubit_id) ? std::string{"/"} : std::to_string(j); }), ""));
-    }
-    spdlog::debug("Distance Matrix:");
-    for (auto& row : _distance) {
-        spdlog::debug("{:5}", fmt::join(row | std::views::transform([this](int j) { return (j == _max_dist) ? std::string{"X"} : std::to_string(j); }), ""));
-    }
-}
-
-/**
- * @brief Set weight of edge used in Floyd-Warshall
- *
- * @param type
- */
-void Device::_set_weight() {
-    assert(_adjacency_matrix.size() == _num_qubit);
-    for (size_t i = 0; i < _num_qubit; i++) {
-        for (auto const& adj : _qubit_list[gsl::narrow<QubitIdType>(i)].get_adjacencies()) {
-            _adjacency_matrix[i][adj] = 1;
-        }
-    }
+void Device::set_routing_cost(RoutingCost cost) {
+    if (_topology->get_routing_cost() == cost) return;
+    auto const had_paths = _topology->has_paths();
+    _mutable_topology().set_routing_cost(cost);
+    if (had_paths) calculate_path();
 }
 
 /**
- * @brief Floyd-Warshall Algorithm. Solve All Pairs Shortest Path (APSP)
+ * @brief Calculate Shortest Path if the topology has changed since the last calculation
  *
  */
-void Device::floyd_warshall() {
-    _set_weight();
-    _initialize_floyd_warshall();
-    for (size_t k = 0; k < _num_qubit; k++) {
-        spdlog::debug("Including vertex({}):", k);
-        for (size_t i = 0; i < _num_qubit; i++) {
-            for (size_t j = 0; j < _num_qubit; j++) {
-                if ((_distance[i][j] > _distance[i][k] + _distance[k][j]) && (_distance[i][k] != _max_dist)) {
-                    _distance[i][j]    = _distance[i][k] + _distance[k][j];
-                    _predecessor[i][j] = _predecessor[k][j];
-                }
-            }
-        }
-
-        spdlog::debug("Predecessor Matrix:");
-        for (auto& row : _predecessor) {
-            spdlog::debug("{:5}", fmt::join(
-                                      row | std::views::transform([](auto j) { return (j == max_qubit_id) ? std::string{"/"} : std::to_string(j); }), ""));
-        }
-        spdlog::debug("Distance Matrix:");
-        for (auto& row : _distance) {
-            spdlog::debug("{:5}", fmt::join(
-                                      row | std::views::transform([this](int j) { return (j == _max_dist) ? std::string{"X"} : std::to_string(j); }), ""));
-        }
-    }
+void Device::calculate_path() {
+    if (_topology->has_paths()) return;
+    auto& topology = _mutable_topology();
+    topology.set_num_qubits(_num_qubit);
+    topology.calculate_path();
 }
 
 /**
@@ -404,10 +964,10 @@ std::vector<PhysicalQubit> Device::get_path(QubitIdType src, QubitIdType dest) c
     std::vector<PhysicalQubit> path;
     path.emplace_back(_qubit_list.at(src));
     if (src == dest) return path;
-    auto new_pred = _predecessor[dest][src];
+    auto new_pred = _topology->get_predecessor(dest, src);
     path.emplace_back(new_pred);
     while (true) {
-        new_pred = _predecessor[dest][new_pred];
+        new_pred = _topology->get_predecessor(dest, new_pred);
         if (new_pred == max_qubit_id) break;
         path.emplace_back(_qubit_list.at(new_pred));
     }
@@ -418,10 +978,16 @@ std::vector<PhysicalQubit> Device::get_path(QubitIdType src, QubitIdType dest) c
  * @brief Read Device
  *
  * @param filename
+ * @param use_path_cache if true, load the shortest paths from `<filename>.apsp` if it matches the
+ *        device, and (re)write it otherwise
  * @return true
  * @return false
  */
-bool Device::read_device(std::string const& filename) {
+bool Device::read_device(std::string const& filename, bool use_path_cache) {
+    if (dvlab::utils::MappedFile const mapped{filename}; mapped.is_open() && Topology::is_binary(mapped.view())) {
+        return _read_binary_device(mapped.view());
+    }
+
     std::ifstream topo_file(filename);
     if (!topo_file.is_open()) {
         spdlog::error("Cannot open the file \"{}\"!!", filename);
@@ -437,7 +1003,7 @@ bool Device::read_device(std::string const& filename) {
     size_t token_end = dvlab::str::str_get_token(str, token, 0, ": ");
     data             = str.substr(token_end + 1);
 
-    _topology->set_name(std::string{dvlab::str::trim_spaces(data)});
+    _mutable_topology().set_name(std::string{dvlab::str::trim_spaces(data)});
 
     // NOTE - Qubit num
     str = "", token = "", data = "";
@@ -484,21 +1050,89 @@ bool Device::read_device(std::string const& filename) {
     if (!_parse_info(topo_file, cx_err, cx_delay, sg_err, sg_delay)) return false;
 
     // NOTE - Finish parsing, store the topology
+    for (size_t i = 0; i < _num_qubit; i++) {
+        add_physical_qubit(PhysicalQubit(gsl::narrow<QubitIdType>(i)));
+    }
+    auto& topology = _mutable_topology();
     for (size_t i = 0; i < adj_list.size(); i++) {
         for (size_t j = 0; j < adj_list[i].size(); j++) {
             if (adj_list[i][j] > i) {
                 add_adjacency(gsl::narrow<QubitIdType>(i), gsl::narrow<QubitIdType>(adj_list[i][j]));
-                _topology->add_adjacency_info(i, adj_list[i][j], {._time = cx_delay[i][j], ._error = cx_err[i][j]});
+                topology.add_adjacency_info(i, adj_list[i][j], {._time = cx_delay[i][j], ._error = cx_err[i][j]});
             }
         }
     }
 
     assert(sg_err.size() == sg_delay.size());
     for (size_t i = 0; i < sg_err.size(); i++) {
-        _topology->add_qubit_info(i, {._time = sg_delay[i], ._error = sg_err[i]});
+        topology.add_qubit_info(i, {._time = sg_delay[i], ._error = sg_err[i]});
     }
 
+    if (!use_path_cache) {
+        calculate_path();
+        return true;
+    }
+
+    auto const cache_path = filename + ".apsp";
+    topology.set_num_qubits(_num_qubit);
+    if (topology.read_path_cache(cache_path)) {
+        spdlog::debug("Loaded the shortest paths from \"{}\"", cache_path);
+        return true;
+    }
     calculate_path();
+    if (!topology.write_path_cache(cache_path)) {
+        spdlog::warn("Cannot write the shortest paths to \"{}\"!!", cache_path);
+    } else {
+        spdlog::debug("Wrote the shortest paths to \"{}\"", cache_path);
+    }
+    return true;
+}
+
+/**
+ * @brief Read a device written by `write_device(filename, true)`. The shortest paths are
+ *        computed only if the file does not carry them.
+ *
+ * @param data the whole file
+ * @return true if successfully read
+ */
+bool Device::_read_binary_device(std::string_view data) {
+    auto topology     = std::make_shared<Topology>();
+    size_t num_qubits = 0;
+    if (!topology->read_binary(data, num_qubits)) return false;
+
+    _topology  = std::move(topology);
+    _num_qubit = num_qubits;
+    _qubit_list.clear();
+    for (size_t i = 0; i < _num_qubit; i++) {
+        add_physical_qubit(PhysicalQubit(gsl::narrow<QubitIdType>(i)));
+    }
+    if (!_topology->has_paths()) calculate_path();
+    return true;
+}
+
+/**
+ * @brief Write the device to a file
+ *
+ * @param filename
+ * @param binary if true, write the binary device format with the precomputed shortest paths;
+ *        otherwise, write the text layout format
+ * @return true if successfully written
+ */
+bool Device::write_device(std::string const& filename, bool binary) const {
+    std::ofstream ofs{filename, binary ? std::ios::binary : std::ios::out};
+    if (!ofs.is_open()) {
+        spdlog::error("Cannot open the file \"{}\"!!", filename);
+        return false;
+    }
+    if (binary) {
+        _topology->write_binary(ofs, _num_qubit);
+    } else {
+        _topology->write_layout(ofs, _num_qubit);
+    }
+    if (!ofs) {
+        spdlog::error("Failed to write to \"{}\"!!", filename);
+        return false;
+    }
     return true;
 }
 
@@ -523,7 +1157,7 @@ bool Device::_parse_gate_set(std::string const& gate_set_str) {
             if (!gate_type.has_value()) {
                 spdlog::error("unsupported gate type \"{}\"!!", str);
             };
-            _topology->add_gate_type(gate_type.value());
+            _mutable_topology().add_gate_type(gate_type.value());
             return gate_type;
         });
 
@@ -669,20 +1303,15 @@ void Device::print_qubits(std::vector<size_t> candidates) const {
         }
     }
     fmt::println("");
-    std::vector<PhysicalQubit> qubits;
-    qubits.resize(_num_qubit);
-    for (auto const& [idx, info] : _qubit_list) {
-        qubits[idx] = info;
-    }
     if (candidates.empty()) {
-        for (size_t i = 0; i < qubits.size(); i++) {
-            fmt::println("ID: {:>3}    {}Adjs: {:>3}", i, _topology->get_qubit_info(i), fmt::join(qubits[i].get_adjacencies(), " "));
+        for (size_t i = 0; i < _num_qubit; i++) {
+            fmt::println("ID: {:>3}    {}Adjs: {:>3}", i, _topology->get_qubit_info(i), fmt::join(get_adjacencies(gsl::narrow<QubitIdType>(i)), " "));
         }
         fmt::println("Total #Qubits: {}", _num_qubit);
     } else {
         sort(candidates.begin(), candidates.end());
         for (auto& p : candidates) {
-            fmt::println("ID: {:>3}    {}Adjs: {:>3}", p, _topology->get_qubit_info(p), fmt::join(qubits[p].get_adjacencies(), " "));
+            fmt::println("ID: {:>3}    {}Adjs: {:>3}", p, _topology->get_qubit_info(p), fmt::join(get_adjacencies(gsl::narrow<QubitIdType>(p)), " "));
         }
     }
 }
@@ -700,15 +1329,10 @@ void Device::print_edges(std::vector<size_t> candidates) const {
         }
     }
     fmt::println("");
-    std::vector<PhysicalQubit> qubits;
-    qubits.resize(_num_qubit);
-    for (auto const& [idx, info] : _qubit_list) {
-        qubits[idx] = info;
-    }
     if (candidates.size() == 0) {
         size_t cnt = 0;
         for (size_t i = 0; i < _num_qubit; i++) {
-            for (auto& q : qubits[i].get_adjacencies()) {
+            for (auto& q : get_adjacencies(gsl::narrow<QubitIdType>(i))) {
                 if (std::cmp_less(i, q)) {
                     cnt++;
                     _topology->print_single_edge(i, q);
@@ -718,10 +1342,11 @@ void Device::print_edges(std::vector<size_t> candidates) const {
         assert(cnt == _topology->get_num_adjacencies());
         fmt::println("Total #Edges: {}", cnt);
     } else if (candidates.size() == 1) {
-        for (auto& q : qubits[candidates[0]].get_adjacencies()) {
+        auto const& adjacencies = get_adjacencies(gsl::narrow<QubitIdType>(candidates[0]));
+        for (auto& q : adjacencies) {
             _topology->print_single_edge(candidates[0], q);
         }
-        fmt::println("Total #Edges: {}", qubits[candidates[0]].get_adjacencies().size());
+        fmt::println("Total #Edges: {}", adjacencies.size());
     } else if (candidates.size() == 2) {
         _topology->print_single_edge(candidates[0], candidates[1]);
     }
@@ -736,28 +1361,6 @@ void Device::print_topology() const {
     fmt::println("Gate Set: {}", fmt::join(_topology->get_gate_set() | std::views::transform([](GateType gtype) { return dvlab::str::toupper_string(gate_type_to_str(gtype)); }), ", "));
 }
 
-/**
- * @brief Print Predecessor
- *
- */
-void Device::print_predecessor() const {
-    fmt::println("Predecessor Matrix:");
-    for (auto& row : _predecessor) {
-        fmt::println("{:5}", fmt::join(row | std::views::transform([](auto pred) { return (pred == max_qubit_id) ? "/" : std::to_string(pred); }), ""));
-    }
-}
-
-/**
- * @brief Print Distance
- *
- */
-void Device::print_distance() const {
-    fmt::println("Distance Matrix:");
-    for (auto& row : _distance) {
-        fmt::println("{:5}", fmt::join(row | std::views::transform([this](int dist) { return (dist == _max_dist) ? "X" : std::to_string(dist); }), ""));
-    }
-}
-
 /**
  * @brief Print shortest path from `s` to `t`
  *
@@ -803,13 +1406,8 @@ void Device::print_mapping() {
  */
 void Device::print_status() const {
     fmt::println("Device Status:");
-    std::vector<PhysicalQubit> qubits;
-    qubits.resize(_num_qubit);
-    for (auto const& [idx, info] : _qubit_list) {
-        qubits[idx] = info;
-    }
-    for (size_t i = 0; i < qubits.size(); ++i) {
-        fmt::println("{}", qubits[i]);
+    for (auto const& qubit : _qubit_list) {
+        fmt::println("{}", qubit);
     }
     fmt::println("");
 }
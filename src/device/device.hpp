@@ -11,14 +11,19 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <limits>
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "qcir/gate_type.hpp"
 #include "qsyn/qsyn_type.hpp"
-#include "util/ordered_hashmap.hpp"
-#include "util/ordered_hashset.hpp"
 #include "util/phase.hpp"
 
 namespace qsyn::device {
@@ -34,6 +39,17 @@ struct DeviceInfo {
     float _error;
 };
 
+/**
+ * @brief How the calibration data (SGTIME, CNOTTIME, CNOTERROR) enters routing.
+ *        Calibrated durations are the base delays scaled by the gate's delay relative to the device average.
+ *
+ */
+enum class RoutingCost {
+    uniform,   // every gate takes SINGLE_DELAY/DOUBLE_DELAY/SWAP_DELAY; shortest paths minimize #SWAPs
+    delay,     // gates take their calibrated durations; shortest paths minimize the SWAP time
+    fidelity,  // gates take their calibrated durations; shortest paths and routing avoid error-prone couplers
+};
+
 std::ostream& operator<<(std::ostream& os, DeviceInfo const& info);
 
 class Topology {
@@ -50,6 +66,9 @@ public:
     using AdjacencyPair     = std::pair<size_t, size_t>;
     using PhysicalQubitInfo = std::unordered_map<size_t, DeviceInfo>;
     using AdjacencyMap      = std::unordered_map<AdjacencyPair, DeviceInfo, AdjacencyPairHash>;
+    using Adjacencies       = std::vector<QubitIdType>;
+    // NOTE - half of the maximum so that the sum of two finite distances never overflows
+    constexpr static int default_max_dist = std::numeric_limits<int>::max() / 2;
     Topology() {}
 
     std::string get_name() const { return _name; }
@@ -63,7 +82,37 @@ public:
     void add_adjacency_info(size_t a, size_t b, DeviceInfo info);
     void add_qubit_info(size_t a, DeviceInfo info);
 
+    // NOTE - Coupling graph
+    void add_adjacency(QubitIdType a, QubitIdType b);
+    Adjacencies const& get_adjacencies(QubitIdType id) const;
+    bool is_adjacent(QubitIdType a, QubitIdType b) const;
+
+    // NOTE - All Pairs Shortest Path
+    bool has_paths() const { return !_distance.empty(); }
+    void calculate_path();
+    int get_distance(QubitIdType a, QubitIdType b) const { return _distance[a * _num_qubit + b]; }
+    QubitIdType get_predecessor(QubitIdType a, QubitIdType b) const { return _predecessor[a * _num_qubit + b]; }
+    int get_max_dist() const { return _max_dist; }
+    bool write_path_cache(std::filesystem::path const& filepath) const;
+    bool read_path_cache(std::filesystem::path const& filepath);
+
+    // NOTE - Routing cost
+    RoutingCost get_routing_cost() const { return _routing_cost; }
+    void set_routing_cost(RoutingCost cost);
+    size_t get_single_duration(QubitIdType a) const;
+    size_t get_double_duration(QubitIdType a, QubitIdType b) const;
+    size_t get_swap_duration(QubitIdType a, QubitIdType b) const;
+    size_t get_swap_penalty(QubitIdType a, QubitIdType b) const;
+
+    // NOTE - Serialization
+    static bool is_binary(std::string_view data);
+    void write_layout(std::ostream& os, size_t num_qubits) const;
+    void write_binary(std::ostream& os, size_t num_qubits) const;
+    bool read_binary(std::string_view data, size_t& num_qubits);
+
     void print_single_edge(size_t a, size_t b) const;
+    void print_predecessor() const;
+    void print_distance() const;
 
 private:
     std::string _name;
@@ -71,70 +120,87 @@ private:
     std::vector<qcir::GateType> _gate_set;
     PhysicalQubitInfo _qubit_info;
     AdjacencyMap _adjacency_info;
+    std::vector<Adjacencies> _adjacencies;  // in insertion order, which decides the routing tie-breaks
+
+    // NOTE - Calibration relative to the device average; _edge_calibrations is aligned with _adjacencies
+    struct EdgeCalibration {
+        float delay_ratio      = 1.F;
+        float infidelity_ratio = 1.F;
+    };
+    RoutingCost _routing_cost = RoutingCost::uniform;
+    std::vector<std::vector<EdgeCalibration>> _edge_calibrations;
+    std::vector<float> _single_delay_ratios;
+    void _calibrate();
+    EdgeCalibration _get_edge_calibration(QubitIdType a, QubitIdType b) const;
+    int _get_path_weight(QubitIdType a, QubitIdType b) const;
+
+    // NOTE - Containers and helper functions for Floyd-Warshall; the tables are row-major _num_qubit x _num_qubit
+    int _max_dist = default_max_dist;
+    std::vector<QubitIdType> _predecessor;
+    std::vector<int> _distance;
+    std::span<QubitIdType const> _predecessor_row(size_t i) const { return {_predecessor.data() + i * _num_qubit, _num_qubit}; }
+    std::span<int const> _distance_row(size_t i) const { return {_distance.data() + i * _num_qubit, _num_qubit}; }
+    void _floyd_warshall();
+    void _initialize_floyd_warshall();
+    bool _paths_are_consistent(std::span<int const> distance, std::span<QubitIdType const> predecessor) const;
+    uint64_t _coupling_hash() const;
+
+    DeviceInfo _find_adjacency_info(size_t a, size_t b) const;
+    DeviceInfo _find_qubit_info(size_t a) const;
 };
 
+/**
+ * @brief The mutable routing state of a physical qubit. The coupling graph lives in the
+ *        shared Topology, so copying a qubit (and hence a Device) is a flat copy.
+ *
+ */
 class PhysicalQubit {
 public:
-    using Adjacencies = dvlab::utils::ordered_hashset<QubitIdType>;
     PhysicalQubit() {}
     PhysicalQubit(QubitIdType id) : _id(id) {}
 
     void set_id(QubitIdType id) { _id = id; }
     void set_occupied_time(size_t t) { _occupied_time = t; }
     void set_logical_qubit(std::optional<size_t> id) { _logical_qubit = id; }
-    void add_adjacency(size_t adj) { _adjacencies.emplace(adj); }
 
     auto get_id() const { return _id; }
     auto get_occupied_time() const { return _occupied_time; }
-    auto is_adjacency(PhysicalQubit const& pq) const { return _adjacencies.contains(pq.get_id()); }
-    auto const& get_adjacencies() const { return _adjacencies; }
     auto get_logical_qubit() const { return _logical_qubit; }
 
-    // traversal
-    auto get_cost() const { return _cost; }
-    auto is_marked() { return _marked; }
-    auto is_taken() { return _taken; }
-    auto get_source() const { return _source; }
-    auto get_predecessor() const { return _pred; }
-    auto get_swap_time() const { return _swap_time; }
-
-    // NOTE - Duostra functions
-    void mark(bool source, QubitIdType pred);
-    void take_route(size_t cost, size_t swap_time);
-    void reset();
-
 private:
     // NOTE - Device information
     QubitIdType _id = max_qubit_id;
-    Adjacencies _adjacencies;
 
     // NOTE - Duostra parameter
     std::optional<QubitIdType> _logical_qubit = std::nullopt;
     size_t _occupied_time                     = 0;
-
-    bool _marked      = false;
-    QubitIdType _pred = 0;
-    size_t _cost      = 0;
-    size_t _swap_time = 0;
-    bool _source      = false;  // false:0, true:1
-    bool _taken       = false;
 };
 
+/**
+ * @brief A device is a shared, read-only Topology plus the per-qubit routing state.
+ *        Copies share the topology until one of them modifies it (copy-on-write),
+ *        so cloning a device for the Duostra search costs O(#qubits).
+ *
+ */
 class Device {
 public:
-    using PhysicalQubitList                  = dvlab::utils::ordered_hashmap<QubitIdType, PhysicalQubit>;
-    constexpr static size_t default_max_dist = 100000;
+    using PhysicalQubitList               = std::vector<PhysicalQubit>;
+    using Adjacencies                     = Topology::Adjacencies;
+    constexpr static int default_max_dist = Topology::default_max_dist;
     Device() : _topology{std::make_shared<Topology>()} {}
 
     std::string get_name() const { return _topology->get_name(); }
     size_t get_num_qubits() const { return _num_qubit; }
     PhysicalQubitList const& get_physical_qubit_list() const { return _qubit_list; }
     PhysicalQubit& get_physical_qubit(QubitIdType id) { return _qubit_list[id]; }
+    PhysicalQubit const& get_physical_qubit(QubitIdType id) const { return _qubit_list[id]; }
     QubitIdType get_physical_by_logical(QubitIdType id);
     std::tuple<QubitIdType, QubitIdType> get_next_swap_cost(QubitIdType source, QubitIdType target);
-    bool qubit_id_exists(QubitIdType id) { return _qubit_list.contains(id); }
+    bool qubit_id_exists(QubitIdType id) { return id >= 0 && std::cmp_less(id, _qubit_list.size()) && _qubit_list[id].get_id() == id; }
+    Adjacencies const& get_adjacencies(QubitIdType id) const { return _topology->get_adjacencies(id); }
+    bool is_adjacent(QubitIdType a, QubitIdType b) const { return _topology->is_adjacent(a, b); }
 
-    void add_physical_qubit(PhysicalQubit q) { _qubit_list[q.get_id()] = std::move(q); }
+    void add_physical_qubit(PhysicalQubit q);
     void add_adjacency(QubitIdType a, QubitIdType b);
 
     // NOTE - Duostra
@@ -146,16 +212,25 @@ public:
 
     // NOTE - All Pairs Shortest Path
     void calculate_path();
-    void floyd_warshall();
+    int get_distance(QubitIdType src, QubitIdType dest) const { return _topology->get_distance(src, dest); }
     std::vector<PhysicalQubit> get_path(QubitIdType src, QubitIdType dest) const;
 
-    bool read_device(std::string const&);
+    // NOTE - Routing cost
+    RoutingCost get_routing_cost() const { return _topology->get_routing_cost(); }
+    void set_routing_cost(RoutingCost cost);
+    size_t get_single_duration(QubitIdType id) const { return _topology->get_single_duration(id); }
+    size_t get_double_duration(QubitIdType a, QubitIdType b) const { return _topology->get_double_duration(a, b); }
+    size_t get_swap_duration(QubitIdType a, QubitIdType b) const { return _topology->get_swap_duration(a, b); }
+    size_t get_swap_penalty(QubitIdType a, QubitIdType b) const { return _topology->get_swap_penalty(a, b); }
+
+    bool read_device(std::string const& filename, bool use_path_cache = false);
+    bool write_device(std::string const& filename, bool binary = false) const;
 
     void print_qubits(std::vector<size_t> candidates = {}) const;
     void print_edges(std::vector<size_t> candidates = {}) const;
     void print_topology() const;
-    void print_predecessor() const;
-    void print_distance() const;
+    void print_predecessor() const { _topology->print_predecessor(); }
+    void print_distance() const { _topology->print_distance(); }
     void print_path(QubitIdType src, QubitIdType dest) const;
     void print_mapping();
     void print_status() const;
@@ -165,20 +240,15 @@ private:
     std::shared_ptr<Topology> _topology;
     PhysicalQubitList _qubit_list;
 
+    Topology& _mutable_topology();
+
     // NOTE - Internal functions only used in reader
+    bool _read_binary_device(std::string_view data);
     bool _parse_gate_set(std::string const& gate_set_str);
     bool _parse_singles(std::string const& data, std::vector<float>& container);
     bool _parse_float_pairs(std::string const& data, std::vector<std::vector<float>>& containers);
     bool _parse_size_t_pairs(std::string const& data, std::vector<std::vector<size_t>>& containers);
     bool _parse_info(std::ifstream& f, std::vector<std::vector<float>>& cx_error, std::vector<std::vector<float>>& cx_delay, std::vector<float>& single_error, std::vector<float>& single_delay);
-
-    // NOTE - Containers and helper functions for Floyd-Warshall
-    int _max_dist = default_max_dist;
-    std::vector<std::vector<QubitIdType>> _predecessor;
-    std::vector<std::vector<int>> _distance;
-    std::vector<std::vector<QubitIdType>> _adjacency_matrix;
-    void _initialize_floyd_warshall();
-    void _set_weight();
 };
 
 class Operation {
@@ -87,13 +87,18 @@ dvlab::Command device_read_cmd(qsyn::device::DeviceMgr& device_mgr) {
                 parser.add_argument<bool>("-r", "--replace")
                     .action(store_true)
                     .help("if specified, replace the current device; otherwise store to a new one");
+
+                parser.add_argument<bool>("--cache-paths")
+                    .action(store_true)
+                    .help("load the shortest paths from <filepath>.apsp if it is up to date, and write it otherwise");
             },
             [&device_mgr](ArgumentParser const& parser) {
                 qsyn::device::Device buffer_device;
-                auto filepath = parser.get<std::string>("filepath");
-                auto replace  = parser.get<bool>("--replace");
+                auto filepath    = parser.get<std::string>("filepath");
+                auto replace     = parser.get<bool>("--replace");
+                auto cache_paths = parser.get<bool>("--cache-paths");
 
-                if (!buffer_device.read_device(filepath)) {
+                if (!buffer_device.read_device(filepath, cache_paths)) {
                     spdlog::error("the format in \"{}\" has something wrong!!", filepath);
                     return CmdExecResult::error;
                 }
@@ -108,6 +113,28 @@ dvlab::Command device_read_cmd(qsyn::device::DeviceMgr& device_mgr) {
             }};
 }
 
+dvlab::Command device_write_cmd(qsyn::device::DeviceMgr& device_mgr) {
+    return {"write",
+            [](ArgumentParser& parser) {
+                parser.description("write the device topology to a file");
+
+                parser.add_argument<std::string>("filepath")
+                    .help("the filepath to output file");
+
+                parser.add_argument<bool>("-b", "--binary")
+                    .action(store_true)
+                    .help("write the binary device format, which also stores the shortest paths and loads faster; otherwise write the text layout format");
+            },
+            [&device_mgr](ArgumentParser const& parser) {
+                if (!qsyn::device::device_mgr_not_empty(device_mgr)) return CmdExecResult::error;
+
+                if (!device_mgr.get()->write_device(parser.get<std::string>("filepath"), parser.get<bool>("--binary"))) {
+                    return CmdExecResult::error;
+                }
+                return CmdExecResult::done;
+            }};
+}
+
 dvlab::Command device_list_cmd(qsyn::device::DeviceMgr& device_mgr) {
     return {"list",
             [](ArgumentParser& parser) {
@@ -147,6 +174,10 @@ dvlab::Command device_print_cmd(qsyn::device::DeviceMgr& device_mgr) {
                     .metavar("(q1, q2)")
                     .help(
                         "print routing paths between q1 and q2");
+
+                mutex.add_argument<bool>("-d", "--distances")
+                    .action(store_true)
+                    .help("print the distance and predecessor matrices of the shortest paths");
             },
             [&device_mgr](ArgumentParser const& parser) {
                 if (!qsyn::device::device_mgr_not_empty(device_mgr)) return CmdExecResult::error;
@@ -164,6 +195,11 @@ dvlab::Command device_print_cmd(qsyn::device::DeviceMgr& device_mgr) {
                     device_mgr.get()->print_path(qids[0], qids[1]);
                     return CmdExecResult::done;
                 }
+                if (parser.parsed("--distances")) {
+                    device_mgr.get()->print_distance();
+                    device_mgr.get()->print_predecessor();
+                    return CmdExecResult::done;
+                }
 
                 device_mgr.get()->print_topology();
                 return CmdExecResult::done;
@@ -177,6 +213,7 @@ dvlab::Command device_cmd(qsyn::device::DeviceMgr& device_mgr) {
     cmd.add_subcommand(device_print_cmd(device_mgr));
     cmd.add_subcommand(device_checkout_cmd(device_mgr));
     cmd.add_subcommand(device_read_cmd(device_mgr));
+    cmd.add_subcommand(device_write_cmd(device_mgr));
     cmd.add_subcommand(dvlab::utils::mgr_delete_cmd(device_mgr));
     return cmd;
 }
@@ -43,12 +43,13 @@ Checker::Checker(CircuitTopology& topo,
  * @return size_t
  */
 size_t Checker::get_cycle(Operation const& op) {
+    auto const [q0, q1] = op.get_qubits();
     if (op.is_swap()) {
-        return SWAP_DELAY;
+        return _device->get_swap_duration(q0, q1);
     } else if (op.is_cx() || op.is_cz()) {
-        return DOUBLE_DELAY;
+        return _device->get_double_duration(q0, q1);
     } else {
-        return SINGLE_DELAY;
+        return _device->get_single_duration(q0);
     }
 }
 
@@ -10,6 +10,8 @@
 
 #include <fmt/ranges.h>
 
+#include <algorithm>
+
 #include "qcir/gate_type.hpp"
 
 using namespace qsyn::qcir;
@@ -54,19 +56,6 @@ void Gate::add_next(size_t next_gate_id) {
     _nexts.emplace_back(next_gate_id);
 }
 
-/**
- * @brief Is the gate are ready to be executed
- *
- * @param executedGates
- * @return true : all previous gates are executed,
- * @return false : else
- */
-bool Gate::is_available(std::unordered_map<size_t, size_t> const& executed_gates) const {
-    return all_of(_prevs.begin(), _prevs.end(), [&](size_t prev) -> bool {
-        return executed_gates.find(prev) != executed_gates.end();
-    });
-}
-
 // SECTION - Class CircuitTopo Member Functions
 
 /**
@@ -74,9 +63,9 @@ bool Gate::is_available(std::unordered_map<size_t, size_t> const& executed_gates
  *
  * @param dep
  */
-CircuitTopology::CircuitTopology(std::shared_ptr<DependencyGraph> const& dep) : _dependency_graph(dep), _available_gates({}), _executed_gates({}) {
+CircuitTopology::CircuitTopology(std::shared_ptr<DependencyGraph> const& dep) : _dependency_graph(dep), _available_gates({}), _partially_ready_gates({}) {
     for (size_t i = 0; i < _dependency_graph->get_gates().size(); i++) {
-        if (_dependency_graph->get_gate(i).is_available(_executed_gates))
+        if (_dependency_graph->get_gate(i).get_prevs().empty())
             _available_gates.emplace_back(i);
     }
 }
@@ -101,21 +90,25 @@ void CircuitTopology::update_available_gates(size_t executed) {
     _available_gates.erase(remove(begin(_available_gates), end(_available_gates), executed), end(_available_gates));
     assert(gate_executed.get_id() == executed);
 
-    _executed_gates[executed] = 0;
+    // NOTE - each successor is listed once per predecessor edge, so a successor is ready
+    //        once it has been reached as many times as it has predecessors
     for (auto next : gate_executed.get_nexts()) {
-        if (get_gate(next).is_available(_executed_gates))
-            _available_gates.emplace_back(next);
-    }
-
-    std::vector<size_t> gates_to_trim;
-    for (auto prev_id : gate_executed.get_prevs()) {
-        auto const& prev_gate = get_gate(prev_id);
-        ++_executed_gates[prev_id];
-        if (_executed_gates[prev_id] >= prev_gate.get_nexts().size())
-            gates_to_trim.emplace_back(prev_id);
+        auto const num_prevs = get_gate(next).get_prevs().size();
+        auto const it        = std::ranges::find(_partially_ready_gates, next, &std::pair<size_t, size_t>::first);
+        auto const num_done  = (it == _partially_ready_gates.end() ? 0 : it->second) + 1;
+        if (num_done < num_prevs) {
+            if (it == _partially_ready_gates.end())
+                _partially_ready_gates.emplace_back(next, num_done);
+            else
+                it->second = num_done;
+            continue;
+        }
+        if (it != _partially_ready_gates.end()) {
+            *it = _partially_ready_gates.back();
+            _partially_ready_gates.pop_back();
+        }
+        _available_gates.emplace_back(next);
     }
-    for (auto gate_id : gates_to_trim)
-        _executed_gates.erase(gate_id);
 }
 
 /**
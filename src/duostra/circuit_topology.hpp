@@ -14,6 +14,8 @@
 #include <memory>
 #include <set>
 #include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "qcir/qcir_gate.hpp"
@@ -46,7 +48,6 @@ public:
     void set_prevs(std::unordered_map<size_t, size_t> const&);
     void set_nexts(std::unordered_map<size_t, size_t> const&);
 
-    bool is_available(std::unordered_map<size_t, size_t> const&) const;
     bool is_swapped() const { return _swap; }
     bool is_first_gate() const { return _prevs.empty(); }
     bool is_last_gate() const { return _nexts.empty(); }
@@ -104,7 +105,9 @@ protected:
     std::shared_ptr<DependencyGraph const> _dependency_graph;
     std::vector<size_t> _available_gates;
 
-    std::unordered_map<size_t, size_t> _executed_gates;  //  maps gate index to number of gates executed next
+    // NOTE - gates with some but not all predecessors executed, as (gate index, #executed predecessors).
+    //        There is at most one such gate per qubit, so this stays small and cheap to copy.
+    std::vector<std::pair<size_t, size_t>> _partially_ready_gates;
 };
 
 }  // namespace qsyn::duostra
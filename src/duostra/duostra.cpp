@@ -10,6 +10,10 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <chrono>
+#include <gsl/narrow>
+
 #include "./checker.hpp"
 #include "./placer.hpp"
 #include "qcir/qcir.hpp"
@@ -125,6 +129,7 @@ void Duostra::make_dependency(std::vector<Operation> const& ops, size_t n_qubits
  * @return size_t
  */
 bool Duostra::map(bool use_device_as_placement) {
+    _device.set_routing_cost(DuostraConfig::ROUTING_COST);
     std::unique_ptr<CircuitTopology> topo;
     topo            = make_unique<CircuitTopology>(_dependency);
     auto check_topo = topo->clone();
@@ -135,11 +140,19 @@ bool Duostra::map(bool use_device_as_placement) {
         spdlog::error("Number of logical qubits are larger than the device!!");
         return false;
     }
+    // SWAPs never move a qubit to another connected component, so such devices cannot be routed
+    _device.calculate_path();
+    for (size_t i = 1; i < _device.get_num_qubits(); ++i) {
+        if (_device.get_distance(0, gsl::narrow<QubitIdType>(i)) == Device::default_max_dist) {
+            spdlog::error("Device {} is not connected!!", _device.get_name());
+            return false;
+        }
+    }
 
     std::vector<QubitIdType> assign;
     if (!use_device_as_placement) {
         spdlog::info("Calculating Initial Placement...");
-        auto placer = get_placer();
+        auto placer = get_placer(_dependency);
         assign      = placer->place_and_assign(_device);
     }
     // scheduler
@@ -187,6 +200,7 @@ bool Duostra::map(bool use_device_as_placement) {
     assert(scheduler->is_sorted());
     assert(scheduler->get_order().size() == _dependency->get_gates().size());
     _result = scheduler->get_operations();
+    _depth  = scheduler->get_final_cost();
     store_order_info(scheduler->get_order());
     build_circuit_by_result();
 
@@ -237,4 +251,52 @@ void Duostra::build_circuit_by_result() {
     }
 }
 
+/**
+ * @brief Map many circuit files onto the same device concurrently. The shortest paths of
+ *        the device are computed once up front; each mapping then works on a copy of the
+ *        device that shares its topology.
+ *
+ * @param inputs the logical circuit files
+ * @param outputs where to write the physical circuits in QASM, one per input
+ * @param device
+ * @param config options passed to each Duostra run
+ * @param num_threads the number of circuits mapped at the same time
+ * @return std::vector<DuostraBatchResult> in the order of `inputs`
+ */
+std::vector<DuostraBatchResult> map_batch(std::vector<std::filesystem::path> const& inputs,
+                                          std::vector<std::filesystem::path> const& outputs,
+                                          qsyn::device::Device device,
+                                          Duostra::DuostraExecutionOptions const& config,
+                                          size_t num_threads) {
+    assert(inputs.size() == outputs.size());
+    device.set_routing_cost(DuostraConfig::ROUTING_COST);
+    device.calculate_path();
+
+    std::vector<DuostraBatchResult> results(inputs.size());
+#pragma omp parallel for schedule(dynamic) num_threads(std::max<size_t>(num_threads, 1))
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        auto& result  = results[i];
+        result.input  = inputs[i];
+        result.output = outputs[i];
+        if (stop_requested()) continue;
+
+        auto const start = std::chrono::steady_clock::now();
+        QCir logical_circuit;
+        if (!logical_circuit.read_qcir_file(inputs[i])) {
+            spdlog::error("Cannot read the circuit \"{}\"!!", inputs[i].string());
+            continue;
+        }
+        Duostra duo{&logical_circuit, device, config};
+        if (!duo.map()) continue;
+
+        result.num_gates = logical_circuit.get_gates().size();
+        result.depth     = duo.get_depth();
+        result.num_swaps = static_cast<size_t>(std::ranges::count_if(duo.get_result(), [](qsyn::device::Operation const& op) { return op.is_swap(); }));
+        result.success   = duo.get_physical_circuit()->write_qasm(outputs[i]);
+        result.runtime   = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    return results;
+}
+
 }  // namespace qsyn::duostra
@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include <filesystem>
 #include <memory>
+#include <vector>
 
 #include "./duostra_def.hpp"
 #include "./scheduler.hpp"
@@ -40,7 +42,9 @@ public:
     std::unique_ptr<qcir::QCir>&& get_physical_circuit() { return std::move(_physical_circuit); }
     std::vector<Operation> const& get_result() const { return _result; }
     std::vector<Operation> const& get_order() const { return _order; }
+    size_t get_depth() const { return _depth; }
     Device get_device() const { return _device; }
+    std::shared_ptr<DependencyGraph const> get_dependency() const { return _dependency; }
 
     void make_dependency();
     void make_dependency(std::vector<Operation> const& ops, size_t n_qubits);
@@ -61,8 +65,29 @@ private:
     std::shared_ptr<DependencyGraph> _dependency;
     std::vector<Operation> _result;
     std::vector<Operation> _order;
+    size_t _depth = 0;  // the final cost of the scheduler, i.e., the "Mapping Depth"
 };
 
+/**
+ * @brief The outcome of mapping one circuit file in `map_batch`.
+ *
+ */
+struct DuostraBatchResult {
+    std::filesystem::path input;
+    std::filesystem::path output;
+    bool success     = false;
+    size_t num_gates = 0;
+    size_t depth     = 0;
+    size_t num_swaps = 0;
+    double runtime   = 0.;  // in seconds
+};
+
+std::vector<DuostraBatchResult> map_batch(std::vector<std::filesystem::path> const& inputs,
+                                          std::vector<std::filesystem::path> const& outputs,
+                                          qsyn::device::Device device,
+                                          Duostra::DuostraExecutionOptions const& config,
+                                          size_t num_threads);
+
 }  // namespace duostra
 
 }  // namespace qsyn
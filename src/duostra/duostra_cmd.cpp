@@ -8,9 +8,14 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <filesystem>
 #include <gsl/util>
+#include <set>
 #include <string>
+#include <thread>
+#include <unordered_map>
 
 #include "./duostra.hpp"
 #include "./mapping_eqv_checker.hpp"
@@ -27,20 +32,70 @@ using dvlab::Command;
 
 namespace qsyn::duostra {
 
+namespace {
+
+bool omp_wait_policy_is_passive() {
+#ifdef __GNUC__
+    char const* const omp_wait_policy = std::getenv("OMP_WAIT_POLICY");
+
+    if (omp_wait_policy == nullptr || (strcasecmp(omp_wait_policy, "passive") != 0)) {
+        spdlog::error("Cannot run command `DUOSTRA`: environment variable `OMP_WAIT_POLICY` is not set to `PASSIVE`.");
+        spdlog::error("Note: Not setting the `OMP_WAIT_POLICY` to `PASSIVE` may cause the program to freeze.");
+        spdlog::error("      You can set it to PASSIVE by running `export OMP_WAIT_POLICY=PASSIVE`");
+        spdlog::error("      prior to running `qsyn`.");
+        return false;
+    }
+#endif
+    return true;
+}
+
+/**
+ * @brief Expand the directories in `paths` into the circuit files they contain.
+ *
+ * @param paths
+ * @return std::vector<std::filesystem::path>
+ */
+std::vector<std::filesystem::path> collect_circuit_files(std::vector<std::string> const& paths) {
+    static std::set<std::string> const circuit_extensions = {".qasm", ".qc", ".qsim", ".quipper"};
+
+    std::vector<std::filesystem::path> files;
+    for (auto const& path : paths) {
+        if (!std::filesystem::is_directory(path)) {
+            files.emplace_back(path);
+            continue;
+        }
+        std::vector<std::filesystem::path> entries;
+        for (auto const& entry : std::filesystem::directory_iterator(path)) {
+            if (entry.is_regular_file() && circuit_extensions.contains(entry.path().extension().string())) {
+                entries.emplace_back(entry.path());
+            }
+        }
+        std::ranges::sort(entries);
+        std::ranges::move(entries, std::back_inserter(files));
+    }
+    return files;
+}
+
+}  // namespace
+
 Command duostra_config_cmd() {
     return {"config",
             [](ArgumentParser& parser) {
                 parser.description("set Duostra parameter(s)");
 
                 parser.add_argument<std::string>("--scheduler")
-                    .choices({"base", "naive", "random", "greedy", "search"})
-                    .help("<base | naive | random | greedy | search>");
+                    .choices({"base", "naive", "random", "greedy", "search", "beam"})
+                    .help("<base | naive | random | greedy | search | beam>");
                 parser.add_argument<std::string>("--router")
                     .choices({"shortest_path", "duostra"})
                     .help("<shortest_path | duostra>");
                 parser.add_argument<std::string>("--placer")
-                    .choices({"naive", "random", "dfs"})
-                    .help("<naive | random | dfs>");
+                    .choices({"naive", "random", "dfs", "sabre"})
+                    .help("<naive | random | dfs | sabre>");
+
+                parser.add_argument<std::string>("--routing-cost")
+                    .choices({"uniform", "delay", "fidelity"})
+                    .help("use the same duration for every gate, or the calibrated gate durations and route by SWAP time or SWAP fidelity");
 
                 parser.add_argument<std::string>("--tie-breaker")
                     .choices({"min", "max"})
@@ -63,6 +118,18 @@ Command duostra_config_cmd() {
                 parser.add_argument<int>("--depth")
                     .help("depth of searching region");
 
+                parser.add_argument<size_t>("--beam-width")
+                    .help("number of partial schedules kept by the beam scheduler");
+
+                parser.add_argument<size_t>("--sabre-restarts")
+                    .help("number of random initial placements refined by the SABRE placer");
+
+                parser.add_argument<size_t>("--sabre-iterations")
+                    .help("number of forward-backward passes per SABRE placement");
+
+                parser.add_argument<size_t>("--sabre-seed")
+                    .help("seed of the random initial placements of the SABRE placer");
+
                 parser.add_argument<bool>("--never-cache")
                     .help("never cache any children unless children() is called");
 
@@ -97,6 +164,13 @@ Command duostra_config_cmd() {
                     printing_config            = false;
                 }
 
+                if (parser.parsed("--routing-cost")) {
+                    auto new_routing_cost = get_routing_cost_type(parser.get<std::string>("--routing-cost"));
+                    assert(new_routing_cost.has_value());
+                    DuostraConfig::ROUTING_COST = new_routing_cost.value();
+                    printing_config             = false;
+                }
+
                 if (parser.parsed("--tie-breaker")) {
                     auto new_tie_breaking_strategy = get_minmax_type(parser.get<std::string>("--tie-breaker"));
                     assert(new_tie_breaking_strategy.has_value());
@@ -133,6 +207,26 @@ Command duostra_config_cmd() {
                     printing_config             = false;
                 }
 
+                if (parser.parsed("--beam-width")) {
+                    DuostraConfig::BEAM_WIDTH = parser.get<size_t>("--beam-width");
+                    printing_config           = false;
+                }
+
+                if (parser.parsed("--sabre-restarts")) {
+                    DuostraConfig::SABRE_RESTARTS = parser.get<size_t>("--sabre-restarts");
+                    printing_config               = false;
+                }
+
+                if (parser.parsed("--sabre-iterations")) {
+                    DuostraConfig::SABRE_ITERATIONS = parser.get<size_t>("--sabre-iterations");
+                    printing_config                 = false;
+                }
+
+                if (parser.parsed("--sabre-seed")) {
+                    DuostraConfig::SABRE_SEED = parser.get<size_t>("--sabre-seed");
+                    printing_config           = false;
+                }
+
                 if (parser.parsed("--never-cache")) {
                     DuostraConfig::NEVER_CACHE = parser.get<bool>("--never-cache");
                     printing_config            = false;
@@ -153,7 +247,12 @@ Command duostra_config_cmd() {
                         fmt::println("");
                         fmt::println("# Candidates:      {}", ((DuostraConfig::NUM_CANDIDATES == SIZE_MAX) ? "unlimited" : std::to_string(DuostraConfig::NUM_CANDIDATES)));
                         fmt::println("Search Depth:      {}", DuostraConfig::SEARCH_DEPTH);
+                        fmt::println("Beam Width:        {}", DuostraConfig::BEAM_WIDTH);
+                        fmt::println("SABRE Restarts:    {}", DuostraConfig::SABRE_RESTARTS);
+                        fmt::println("SABRE Iterations:  {}", DuostraConfig::SABRE_ITERATIONS);
+                        fmt::println("SABRE Seed:        {}", DuostraConfig::SABRE_SEED);
                         fmt::println("");
+                        fmt::println("Routing Cost:      {}", get_routing_cost_type_str(DuostraConfig::ROUTING_COST));
                         fmt::println("Tie breaker:       {}", get_minmax_type_str(DuostraConfig::TIE_BREAKING_STRATEGY));
                         fmt::println("APSP Coeff.:       {}", DuostraConfig::APSP_COEFF);
                         fmt::println("2-Qb. Avail. Time: {}", get_minmax_type_str(DuostraConfig::AVAILABLE_TIME_STRATEGY));
@@ -184,6 +283,10 @@ Command mapping_equivalence_check_cmd(qcir::QCirMgr& qcir_mgr, device::DeviceMgr
                 .default_value(false)
                 .action(store_true)
                 .help("check the QCir in reverse. This option is supposed to be used for extracted QCir");
+            parser.add_argument<bool>("-f", "--fast")
+                .default_value(false)
+                .action(store_true)
+                .help("check in linear time by following the gate sequence of each qubit");
         },
         [&](ArgumentParser const& parser) {
             using dvlab::fmt_ext::styled_if_ansi_supported;
@@ -193,7 +296,7 @@ Command mapping_equivalence_check_cmd(qcir::QCirMgr& qcir_mgr, device::DeviceMgr
                 return CmdExecResult::error;
             }
             MappingEquivalenceChecker mpeqc(physical_qc, logical_qc, *device_mgr.get(), {});
-            if (mpeqc.check()) {
+            if (parser.get<bool>("--fast") ? mpeqc.fast_check() : mpeqc.check()) {
                 fmt::println("{}", styled_if_ansi_supported("Equivalent up to permutation", fmt::fg(fmt::terminal_color::green) | fmt::emphasis::bold));
             } else {
                 fmt::println("{}", styled_if_ansi_supported("Not equivalent", fmt::fg(fmt::terminal_color::red) | fmt::emphasis::bold));
@@ -202,6 +305,82 @@ Command mapping_equivalence_check_cmd(qcir::QCirMgr& qcir_mgr, device::DeviceMgr
         }};
 }
 
+Command duostra_batch_cmd(device::DeviceMgr& device_mgr) {
+    return {"batch",
+            [](ArgumentParser& parser) {
+                parser.description("map many circuit files to the current device and write the physical circuits in QASM");
+                parser.add_argument<std::string>("inputs")
+                    .nargs(NArgsOption::one_or_more)
+                    .help("the circuit files, or directories containing them");
+                parser.add_argument<std::string>("-o", "--output-dir")
+                    .required(true)
+                    .help("the directory to write the physical circuits to");
+                parser.add_argument<size_t>("-j", "--jobs")
+                    .default_value(std::max(std::thread::hardware_concurrency(), 1u))
+                    .help("the number of circuits to map at the same time");
+                parser.add_argument<bool>("-c", "--check")
+                    .default_value(false)
+                    .action(store_true)
+                    .help("check whether each mapping result is correct");
+                parser.add_argument<bool>("-t", "--time")
+                    .default_value(false)
+                    .action(store_true)
+                    .help("also print the time spent on mapping each circuit");
+            },
+            [&](ArgumentParser const& parser) {
+                if (!device_mgr_not_empty(device_mgr)) return CmdExecResult::error;
+                if (!omp_wait_policy_is_passive()) return CmdExecResult::error;
+
+                auto const inputs = collect_circuit_files(parser.get<std::vector<std::string>>("inputs"));
+                if (inputs.empty()) {
+                    spdlog::error("No circuit files to map!!");
+                    return CmdExecResult::error;
+                }
+
+                std::filesystem::path const output_dir = parser.get<std::string>("--output-dir");
+                std::error_code ec;
+                std::filesystem::create_directories(output_dir, ec);
+                if (ec) {
+                    spdlog::error("Cannot create the output directory \"{}\": {}", output_dir.string(), ec.message());
+                    return CmdExecResult::error;
+                }
+
+                // NOTE - files from different directories may share a name; number the repeats
+                std::vector<std::filesystem::path> outputs;
+                std::unordered_map<std::string, size_t> name_count;
+                for (auto const& input : inputs) {
+                    auto const stem  = input.stem().string();
+                    auto const count = name_count[stem]++;
+                    outputs.emplace_back(output_dir / (count == 0 ? stem + ".qasm" : fmt::format("{}_{}.qasm", stem, count)));
+                }
+
+                auto const results = map_batch(inputs, outputs, *device_mgr.get(),
+                                               {.verify_result = parser.get<bool>("--check"),
+                                                .silent        = true,
+                                                .use_tqdm      = false},
+                                               parser.get<size_t>("--jobs"));
+
+                auto const print_time = parser.get<bool>("--time");
+                fmt::println("{:<32} {:>8} {:>10} {:>8}{}", "Circuit", "#Gates", "Depth", "#SWAP", print_time ? fmt::format(" {:>10}", "Time (s)") : "");
+                size_t num_failed = 0;
+                for (auto const& result : results) {
+                    auto const name = result.input.filename().string();
+                    if (!result.success) {
+                        fmt::println("{:<32} {:>8}", name, "failed");
+                        ++num_failed;
+                        continue;
+                    }
+                    fmt::println("{:<32} {:>8} {:>10} {:>8}{}", name, result.num_gates, result.depth, result.num_swaps, print_time ? fmt::format(" {:>10.3f}", result.runtime) : "");
+                }
+
+                if (num_failed > 0) {
+                    spdlog::error("Failed to map {} out of {} circuits!!", num_failed, results.size());
+                    return CmdExecResult::error;
+                }
+                return CmdExecResult::done;
+            }};
+}
+
 Command duostra_cmd(qcir::QCirMgr& qcir_mgr, device::DeviceMgr& device_mgr) {
     auto cmd = Command{"duostra",
                        [](ArgumentParser& parser) {
@@ -222,17 +401,7 @@ Command duostra_cmd(qcir::QCirMgr& qcir_mgr, device::DeviceMgr& device_mgr) {
 
                        [&](ArgumentParser const& parser) {
                            if (!qcir_mgr_not_empty(qcir_mgr) || !device_mgr_not_empty(device_mgr)) return CmdExecResult::error;
-#ifdef __GNUC__
-                           char const* const omp_wait_policy = std::getenv("OMP_WAIT_POLICY");
-
-                           if (omp_wait_policy == nullptr || (strcasecmp(omp_wait_policy, "passive") != 0)) {
-                               spdlog::error("Cannot run command `DUOSTRA`: environment variable `OMP_WAIT_POLICY` is not set to `PASSIVE`.");
-                               spdlog::error("Note: Not setting the `OMP_WAIT_POLICY` to `PASSIVE` may cause the program to freeze.");
-                               spdlog::error("      You can set it to PASSIVE by running `export OMP_WAIT_POLICY=PASSIVE`");
-                               spdlog::error("      prior to running `qsyn`.");
-                               return CmdExecResult::error;
-                           }
-#endif
+                           if (!omp_wait_policy_is_passive()) return CmdExecResult::error;
                            qcir::QCir* logical_qcir = qcir_mgr.get();
                            Duostra duo{logical_qcir,
                                        *device_mgr.get(),
@@ -257,6 +426,7 @@ Command duostra_cmd(qcir::QCirMgr& qcir_mgr, device::DeviceMgr& device_mgr) {
                        }};
 
     cmd.add_subcommand(duostra_config_cmd());
+    cmd.add_subcommand(duostra_batch_cmd(device_mgr));
     return cmd;
 }
 
@@ -15,7 +15,7 @@ namespace qsyn::duostra {
  * @return string
  */
 std::string get_scheduler_type_str(SchedulerType const& type) {
-    // 0:base 1:static 2:random 3:greedy 4:search
+    // 0:base 1:static 2:random 3:greedy 4:search 5:beam
     switch (type) {
         case SchedulerType::base:
             return "base";
@@ -25,6 +25,8 @@ std::string get_scheduler_type_str(SchedulerType const& type) {
             return "random";
         case SchedulerType::greedy:
             return "greedy";
+        case SchedulerType::beam:
+            return "beam";
         case SchedulerType::search:
         default:
             return "search";
@@ -57,6 +59,8 @@ std::string get_placer_type_str(PlacerType const& type) {
             return "naive";
         case PlacerType::random:
             return "random";
+        case PlacerType::sabre:
+            return "sabre";
         case PlacerType::dfs:
         default:
             return "dfs";
@@ -90,6 +94,7 @@ std::optional<SchedulerType> get_scheduler_type(std::string const& str) {
     if (str == "random") return SchedulerType::random;
     if (str == "greedy") return SchedulerType::greedy;
     if (str == "search") return SchedulerType::search;
+    if (str == "beam") return SchedulerType::beam;
 
     return std::nullopt;
 }
@@ -115,10 +120,11 @@ std::optional<RouterType> get_router_type(std::string const& str) {
  * @return size_t
  */
 std::optional<PlacerType> get_placer_type(std::string const& str) {
-    // 0:static 1:random 2:dfs
+    // 0:static 1:random 2:dfs 3:sabre
     if (str == "naive") return PlacerType::naive;
     if (str == "random") return PlacerType::random;
     if (str == "dfs") return PlacerType::dfs;
+    if (str == "sabre") return PlacerType::sabre;
 
     return std::nullopt;
 }
@@ -130,12 +136,44 @@ std::optional<MinMaxOptionType> get_minmax_type(std::string const& str) {
     return std::nullopt;
 }
 
+/**
+ * @brief Get the Routing Cost Type Str object
+ *
+ * @return string
+ */
+std::string get_routing_cost_type_str(device::RoutingCost const& type) {
+    switch (type) {
+        case device::RoutingCost::delay:
+            return "delay";
+        case device::RoutingCost::fidelity:
+            return "fidelity";
+        case device::RoutingCost::uniform:
+        default:
+            return "uniform";
+    }
+}
+
+/**
+ * @brief Get the Routing Cost object
+ *
+ * @param str
+ * @return std::optional<device::RoutingCost>
+ */
+std::optional<device::RoutingCost> get_routing_cost_type(std::string const& str) {
+    if (str == "uniform") return device::RoutingCost::uniform;
+    if (str == "delay") return device::RoutingCost::delay;
+    if (str == "fidelity") return device::RoutingCost::fidelity;
+
+    return std::nullopt;
+}
+
 // SECTION - Global settings for Duostra mapper
 
 SchedulerType DuostraConfig::SCHEDULER_TYPE           = SchedulerType::search;
 RouterType DuostraConfig::ROUTER_TYPE                 = RouterType::duostra;
 PlacerType DuostraConfig::PLACER_TYPE                 = PlacerType::dfs;
 MinMaxOptionType DuostraConfig::TIE_BREAKING_STRATEGY = MinMaxOptionType::min;
+device::RoutingCost DuostraConfig::ROUTING_COST       = device::RoutingCost::uniform;
 
 // SECTION - Initialize in Greedy Scheduler
 size_t DuostraConfig::NUM_CANDIDATES                    = SIZE_MAX;               // top k candidates, SIZE_MAX: all
@@ -148,4 +186,12 @@ size_t DuostraConfig::SEARCH_DEPTH                  = 4;  // depth of searching
 bool DuostraConfig::NEVER_CACHE                     = 1;  // never cache any children unless children() is called
 bool DuostraConfig::EXECUTE_SINGLE_QUBIT_GATES_ASAP = 0;  // execute the single gates when they are available
 
+// SECTION - Initialize in SABRE Placer
+size_t DuostraConfig::SABRE_RESTARTS   = 16;  // number of placements refined in parallel
+size_t DuostraConfig::SABRE_ITERATIONS = 2;   // number of forward-backward passes per placement
+size_t DuostraConfig::SABRE_SEED       = 0;   // seed of the random initial placements
+
+// SECTION - Initialize in Beam Scheduler
+size_t DuostraConfig::BEAM_WIDTH = 16;  // number of partial schedules kept at each step
+
 }  // namespace qsyn::duostra
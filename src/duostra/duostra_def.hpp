@@ -12,6 +12,8 @@
 #include <optional>
 #include <string>
 
+#include "device/device.hpp"
+
 namespace qsyn::duostra {
 
 enum class SchedulerType {
@@ -20,12 +22,14 @@ enum class SchedulerType {
     random,
     greedy,
     search,
+    beam,
 };
 
 enum class PlacerType {
     naive,
     random,
     dfs,
+    sabre,
 };
 
 enum class RouterType {
@@ -42,17 +46,20 @@ std::string get_scheduler_type_str(SchedulerType const& type);
 std::string get_placer_type_str(PlacerType const& type);
 std::string get_router_type_str(RouterType const& type);
 std::string get_minmax_type_str(MinMaxOptionType const& type);
+std::string get_routing_cost_type_str(device::RoutingCost const& type);
 
 std::optional<SchedulerType> get_scheduler_type(std::string const& str);
 std::optional<PlacerType> get_placer_type(std::string const& str);
 std::optional<RouterType> get_router_type(std::string const& str);
 std::optional<MinMaxOptionType> get_minmax_type(std::string const& str);
+std::optional<device::RoutingCost> get_routing_cost_type(std::string const& str);
 
 struct DuostraConfig {
     static SchedulerType SCHEDULER_TYPE;
     static RouterType ROUTER_TYPE;
     static PlacerType PLACER_TYPE;
     static MinMaxOptionType TIE_BREAKING_STRATEGY;  // t/f smaller logical qubit index with little priority
+    static device::RoutingCost ROUTING_COST;        // how gate durations and errors of the device enter routing
 
     // SECTION - Initialize in Greedy Scheduler
     static size_t NUM_CANDIDATES;                     // top k candidates, SIZE_MAX: all candidates
@@ -64,6 +71,14 @@ struct DuostraConfig {
     static size_t SEARCH_DEPTH;                   // depth of searching region
     static bool NEVER_CACHE;                      // never cache any children unless children() is called
     static bool EXECUTE_SINGLE_QUBIT_GATES_ASAP;  // execute the single gates when they are available
+
+    // SECTION - Initialize in SABRE Placer
+    static size_t SABRE_RESTARTS;    // number of placements refined in parallel
+    static size_t SABRE_ITERATIONS;  // number of forward-backward passes per placement
+    static size_t SABRE_SEED;        // seed of the random initial placements
+
+    // SECTION - Initialize in Beam Scheduler
+    static size_t BEAM_WIDTH;  // number of partial schedules kept at each step
 };
 
 }  // namespace qsyn::duostra
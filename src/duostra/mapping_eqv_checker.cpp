@@ -7,6 +7,12 @@
 
 #include "./mapping_eqv_checker.hpp"
 
+#include <algorithm>
+#include <gsl/narrow>
+#include <utility>
+#include <vector>
+
+#include "./duostra.hpp"
 #include "./placer.hpp"
 #include "qcir/qcir.hpp"
 #include "qcir/qcir_gate.hpp"
@@ -27,8 +33,11 @@ namespace qsyn::duostra {
  * @param reverse check reversily if true
  */
 MappingEquivalenceChecker::MappingEquivalenceChecker(QCir* phy, QCir* log, Device dev, std::vector<QubitIdType> init, bool reverse) : _physical(phy), _logical(log), _device(std::move(dev)), _reverse(reverse) {
+    // NOTE - place with the distances Duostra::map used
+    _device.set_routing_cost(DuostraConfig::ROUTING_COST);
     if (init.empty()) {
-        auto placer = get_placer();
+        // NOTE - placers such as SABRE look at the circuit; give them the same dependency graph Duostra used
+        auto placer = get_placer(Duostra{_logical, _device, {.verify_result = false, .silent = true, .use_tqdm = false}}.get_dependency());
         init        = placer->place_and_assign(_device);
     } else
         _device.place(init);
@@ -70,6 +79,128 @@ bool MappingEquivalenceChecker::check() {
     return true;
 }
 
+/**
+ * @brief Check physical circuit in linear time. The gates on each logical qubit are laid out in
+ *        flat arrays consumed through one cursor per qubit, and the placement is a flat
+ *        physical-to-logical array, so each physical gate is matched in O(1) without hashing.
+ *        Reports the first physical gate that diverges from the logical circuit.
+ *
+ * @return true if the circuits are equivalent up to permutation
+ */
+bool MappingEquivalenceChecker::fast_check() {
+    // NOTE - gates on each logical qubit, in execution order
+    size_t num_logical = 0;
+    for (auto const* qubit : _logical->get_qubits()) {
+        num_logical = std::max(num_logical, static_cast<size_t>(qubit->get_id()) + 1);
+    }
+    std::vector<std::vector<QCirGate*>> logical_gates(num_logical);
+    for (auto const* qubit : _logical->get_qubits()) {
+        auto& gates = logical_gates[qubit->get_id()];
+        for (auto* gate = _reverse ? qubit->get_last() : qubit->get_first(); gate != nullptr; gate = get_next(gate->get_qubit(qubit->get_id()))) {
+            gates.emplace_back(gate);
+        }
+    }
+    std::vector<size_t> cursors(num_logical, 0);
+    auto const expected_gate = [&](QubitIdType logical) -> QCirGate* {
+        return std::cmp_less(logical, num_logical) && cursors[logical] < logical_gates[logical].size() ? logical_gates[logical][cursors[logical]] : nullptr;
+    };
+
+    auto const num_physical = _device.get_num_qubits();
+    std::vector<QubitIdType> physical_to_logical(num_physical, max_qubit_id);
+    for (size_t i = 0; i < num_physical; ++i) {
+        if (auto const logical = _device.get_physical_qubit(gsl::narrow<QubitIdType>(i)).get_logical_qubit(); logical.has_value()) {
+            physical_to_logical[i] = gsl::narrow<QubitIdType>(logical.value());
+        }
+    }
+    // the number of gates of a detected SWAP still to come on each physical qubit
+    std::vector<unsigned char> swap_gates_left(num_physical, 0);
+
+    // NOTE - the three CXs of a SWAP are consecutive on both qubits and alternate in direction
+    auto const forms_swap = [this](QCirGate* first) {
+        auto* candidate = first;
+        for (size_t i = 0; i < 2; ++i) {
+            auto* const next = get_next(candidate->get_qubits()[0]);
+            if (next == nullptr || next != get_next(candidate->get_qubits()[1]) || !next->is_cx()) return false;
+            if (candidate->get_qubits()[0]._qubit != next->get_qubits()[1]._qubit ||
+                candidate->get_qubits()[1]._qubit != next->get_qubits()[0]._qubit) return false;
+            candidate = next;
+        }
+        return true;
+    };
+
+    auto execute_order = _physical->get_topologically_ordered_gates();
+    if (_reverse) std::ranges::reverse(execute_order);
+    for (auto* const gate : execute_order) {
+        auto const& qubits = gate->get_qubits();
+        if (std::ranges::any_of(qubits, [num_physical](QubitInfo const& info) { return std::cmp_greater_equal(info._qubit, num_physical); })) {
+            spdlog::error("Gate {} acts on a qubit that is not on the device!!", gate->get_id());
+            return false;
+        }
+
+        if (qubits.size() == 1) {
+            auto const logical = physical_to_logical[qubits[0]._qubit];
+            auto* const expected = expected_gate(logical);
+            if (expected == nullptr) {
+                spdlog::error("Corresponding logical gate of gate {} is nullptr!!", gate->get_id());
+                return false;
+            }
+            if (expected->get_type() != gate->get_type() || expected->get_phase() != gate->get_phase()) {
+                spdlog::error("Gate {} mismatches logical gate {} on qubit {}!!", gate->get_id(), expected->get_id(), logical);
+                return false;
+            }
+            ++cursors[logical];
+            continue;
+        }
+
+        if (!(gate->is_cx() || gate->is_cz())) {
+            spdlog::error("Gate {} is not a single-qubit gate, CX, or CZ!!", gate->get_id());
+            return false;
+        }
+        auto const p0 = qubits[0]._qubit;
+        auto const p1 = qubits[1]._qubit;
+        if (swap_gates_left[p0] > 0) {
+            --swap_gates_left[p0];
+            --swap_gates_left[p1];
+            continue;
+        }
+        if (!_device.is_adjacent(p0, p1)) {
+            spdlog::error("Gate {} acts on non-adjacent qubits {} and {}!!", gate->get_id(), p0, p1);
+            return false;
+        }
+
+        auto const l0        = physical_to_logical[p0];
+        auto const l1        = physical_to_logical[p1];
+        auto* const expected = expected_gate(l0);
+        // NOTE - three CXs are a real gate rather than a SWAP if the logical circuit expects one there
+        auto const expects_cx = expected != nullptr && expected == expected_gate(l1) && expected->is_cx();
+        if (gate->is_cx() && !expects_cx && forms_swap(gate)) {
+            std::swap(physical_to_logical[p0], physical_to_logical[p1]);
+            swap_gates_left[p0] = 2;
+            swap_gates_left[p1] = 2;
+            continue;
+        }
+
+        if (expected == nullptr || expected != expected_gate(l1)) {
+            spdlog::error("Gate {} violates dependency graph!!", gate->get_id());
+            return false;
+        }
+        if (expected->get_type() != gate->get_type() || expected->get_phase() != gate->get_phase() ||
+            expected->get_qubits()[0]._qubit != l0 || expected->get_qubits()[1]._qubit != l1) {
+            spdlog::error("Gate {} mismatches logical gate {} on qubits {} and {}!!", gate->get_id(), expected->get_id(), l0, l1);
+            return false;
+        }
+        ++cursors[l0];
+        ++cursors[l1];
+    }
+
+    for (size_t i = 0; i < num_logical; ++i) {
+        if (cursors[i] < logical_gates[i].size()) {
+            spdlog::warn("Note: qubit {} has gates remaining", i);
+        }
+    }
+    return true;
+}
+
 /**
  * @brief Check the gate and its previous two gates constitute a swap
  *
@@ -126,7 +257,7 @@ bool MappingEquivalenceChecker::is_swap(QCirGate* candidate) {
 bool MappingEquivalenceChecker::execute_swap(QCirGate* first, std::unordered_set<QCirGate*>& swaps) {
     auto const& q_info0 = first->get_qubits()[0];
     auto const& q_info1 = first->get_qubits()[1];
-    if (!_device.get_physical_qubit(q_info0._qubit).is_adjacency(_device.get_physical_qubit(q_info1._qubit))) return false;
+    if (!_device.is_adjacent(q_info0._qubit, q_info1._qubit)) return false;
 
     swaps.emplace(first);
     auto next_gate = get_next(q_info0);
@@ -215,7 +346,7 @@ bool MappingEquivalenceChecker::execute_double(QCirGate* gate) {
         return false;
     }
 
-    if (!_device.get_physical_qubit(gate->get_qubits()[0]._qubit).is_adjacency(_device.get_physical_qubit(gate->get_qubits()[1]._qubit))) return false;
+    if (!_device.is_adjacent(gate->get_qubits()[0]._qubit, gate->get_qubits()[1]._qubit)) return false;
 
     _dependency[logical_gate->get_qubits()[0]._qubit] = get_next(logical_gate->get_qubits()[0]);
     _dependency[logical_gate->get_qubits()[1]._qubit] = get_next(logical_gate->get_qubits()[1]);
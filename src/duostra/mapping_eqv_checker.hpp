@@ -32,6 +32,7 @@ public:
     MappingEquivalenceChecker(qcir::QCir*, qcir::QCir*, Device, std::vector<QubitIdType> = {}, bool = false);
 
     bool check();
+    bool fast_check();
     bool is_swap(qcir::QCirGate*);
     bool execute_swap(qcir::QCirGate*, std::unordered_set<qcir::QCirGate*>&);
     bool execute_single(qcir::QCirGate*);
@@ -8,9 +8,17 @@
 
 #include "./placer.hpp"
 
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
 #include <cassert>
+#include <gsl/narrow>
+#include <limits>
+#include <numeric>
+#include <optional>
 #include <random>
 
+#include "./circuit_topology.hpp"
 #include "./duostra.hpp"
 #include "device/device.hpp"
 #include "qsyn/qsyn_type.hpp"
@@ -23,13 +31,15 @@ namespace qsyn::duostra {
  *
  * @return unique_ptr<BasePlacer>
  */
-std::unique_ptr<BasePlacer> get_placer() {
+std::unique_ptr<BasePlacer> get_placer(std::shared_ptr<DependencyGraph const> dependency) {
     if (DuostraConfig::PLACER_TYPE == PlacerType::naive) {
         return std::make_unique<StaticPlacer>();
     } else if (DuostraConfig::PLACER_TYPE == PlacerType::random) {
         return std::make_unique<RandomPlacer>();
     } else if (DuostraConfig::PLACER_TYPE == PlacerType::dfs) {
         return std::make_unique<DFSPlacer>();
+    } else if (DuostraConfig::PLACER_TYPE == PlacerType::sabre) {
+        return std::make_unique<SabrePlacer>(std::move(dependency), DuostraConfig::SABRE_RESTARTS, DuostraConfig::SABRE_ITERATIONS, DuostraConfig::SABRE_SEED);
     }
     DVLAB_UNREACHABLE("Unknown placer type");
 }
@@ -112,16 +122,16 @@ void DFSPlacer::_dfs_device(QubitIdType current, Device& device, std::vector<Qub
     qubit_marks[current] = true;
     assign.emplace_back(current);
 
-    auto const& q = device.get_physical_qubit(current);
+    auto const& adjacencies = device.get_adjacencies(current);
     std::vector<QubitIdType> adjacency_waitlist;
 
-    for (auto& adj : q.get_adjacencies()) {
+    for (auto& adj : adjacencies) {
         // already marked
         if (qubit_marks[adj])
             continue;
-        assert(q.get_adjacencies().size() > 0);
+        assert(adjacencies.size() > 0);
         // corner
-        if (q.get_adjacencies().size() == 1)
+        if (adjacencies.size() == 1)
             _dfs_device(adj, device, assign, qubit_marks);
         else
             adjacency_waitlist.emplace_back(adj);
@@ -136,4 +146,216 @@ void DFSPlacer::_dfs_device(QubitIdType current, Device& device, std::vector<Qub
     return;
 }
 
+// SECTION - Class SabrePlacer Member Functions
+
+namespace {
+
+constexpr size_t sabre_extended_set_size  = 20;
+constexpr double sabre_extended_set_weight = 0.5;
+constexpr double sabre_decay_delta         = 0.001;
+constexpr size_t sabre_decay_reset         = 5;
+
+/**
+ * @brief One SABRE routing pass over the dependency graph. SWAPs are applied to
+ *        `logical_to_physical` in place, so the mapping at the end of the pass
+ *        is the starting mapping of the pass in the other direction.
+ *
+ * @param dependency
+ * @param device must have its shortest paths calculated
+ * @param logical_to_physical
+ * @param reverse if true, walk the circuit from the last gates to the first
+ * @return the number of SWAPs inserted, or std::nullopt if some gate acts on
+ *         physical qubits that are not connected on the device
+ */
+std::optional<size_t> sabre_pass(DependencyGraph const& dependency, qsyn::device::Device const& device, std::vector<QubitIdType>& logical_to_physical, bool reverse) {
+    auto const& gates      = dependency.get_gates();
+    auto const num_qubits  = device.get_num_qubits();
+    auto const successors  = [&](Gate const& gate) -> auto const& { return reverse ? gate.get_prevs() : gate.get_nexts(); };
+    auto const is_2q       = [](Gate const& gate) { return std::get<1>(gate.get_qubits()) != max_qubit_id; };
+    auto const physical_of = [&](Gate const& gate) {
+        return std::make_pair(logical_to_physical[std::get<0>(gate.get_qubits())], logical_to_physical[std::get<1>(gate.get_qubits())]);
+    };
+    auto const distance = [&](Gate const& gate) {
+        auto const [p0, p1] = physical_of(gate);
+        return static_cast<double>(device.get_distance(p0, p1));
+    };
+
+    std::vector<QubitIdType> physical_to_logical(num_qubits);
+    for (size_t logical = 0; logical < logical_to_physical.size(); ++logical) {
+        physical_to_logical[logical_to_physical[logical]] = gsl::narrow<QubitIdType>(logical);
+    }
+    auto const apply_swap = [&](QubitIdType p0, QubitIdType p1) {
+        std::swap(physical_to_logical[p0], physical_to_logical[p1]);
+        logical_to_physical[physical_to_logical[p0]] = p0;
+        logical_to_physical[physical_to_logical[p1]] = p1;
+    };
+
+    std::vector<size_t> num_pending_preds(gates.size(), 0);
+    for (auto const& gate : gates) {
+        for (auto const succ : successors(gate)) ++num_pending_preds[succ];
+    }
+    std::vector<size_t> front;
+    for (size_t i = 0; i < gates.size(); ++i) {
+        if (num_pending_preds[i] == 0) front.emplace_back(i);
+    }
+
+    std::vector<double> decay(num_qubits, 1.);
+    std::vector<size_t> extended_set;
+    std::vector<size_t> visit_stamp(gates.size(), 0);
+    size_t stamp                = 0;
+    size_t num_swaps            = 0;
+    size_t swaps_since_progress = 0;
+
+    while (true) {
+        // NOTE - execute everything that is executable; `front` may grow while we iterate
+        std::vector<size_t> blocked;
+        auto progress = false;
+        for (size_t i = 0; i < front.size(); ++i) {
+            auto const& gate = gates[front[i]];
+            if (is_2q(gate)) {
+                auto const [p0, p1] = physical_of(gate);
+                if (!device.is_adjacent(p0, p1)) {
+                    blocked.emplace_back(front[i]);
+                    continue;
+                }
+            }
+            progress = true;
+            for (auto const succ : successors(gate)) {
+                if (--num_pending_preds[succ] == 0) front.emplace_back(succ);
+            }
+        }
+        front = std::move(blocked);
+        if (front.empty()) break;
+
+        if (progress) {
+            std::ranges::fill(decay, 1.);
+            swaps_since_progress = 0;
+        }
+
+        // the heuristic may cycle; route the first blocked gate along a shortest path then
+        if (swaps_since_progress > 2 * num_qubits) {
+            auto [p0, p1] = physical_of(gates[front.front()]);
+            // SWAPs never move a qubit out of its connected component, so the gate can never be routed
+            if (device.get_distance(p0, p1) == qsyn::device::Device::default_max_dist) return std::nullopt;
+            while (!device.is_adjacent(p0, p1)) {
+                auto const& adjacencies = device.get_adjacencies(p0);
+                auto const next         = *std::ranges::min_element(adjacencies, {}, [&](QubitIdType q) { return device.get_distance(q, p1); });
+                apply_swap(p0, next);
+                ++num_swaps;
+                p0 = next;
+            }
+            continue;
+        }
+
+        // NOTE - the extended set: the nearest two-qubit gates after the front layer
+        ++stamp;
+        extended_set.clear();
+        for (size_t i = 0; i < front.size() && extended_set.size() < sabre_extended_set_size; ++i) {
+            std::vector<size_t> queue{front[i]};
+            for (size_t j = 0; j < queue.size() && extended_set.size() < sabre_extended_set_size; ++j) {
+                for (auto const succ : successors(gates[queue[j]])) {
+                    if (visit_stamp[succ] == stamp) continue;
+                    visit_stamp[succ] = stamp;
+                    queue.emplace_back(succ);
+                    if (is_2q(gates[succ])) extended_set.emplace_back(succ);
+                }
+            }
+        }
+
+        auto const score = [&]() {
+            double front_cost = 0., extended_cost = 0.;
+            for (auto const g : front) front_cost += distance(gates[g]);
+            for (auto const g : extended_set) extended_cost += distance(gates[g]);
+            front_cost /= static_cast<double>(front.size());
+            if (!extended_set.empty()) extended_cost /= static_cast<double>(extended_set.size());
+            return front_cost + sabre_extended_set_weight * extended_cost;
+        };
+
+        auto best_score = std::numeric_limits<double>::max();
+        auto best_swap  = std::make_pair(max_qubit_id, max_qubit_id);
+        for (auto const g : front) {
+            auto const [p0, p1] = physical_of(gates[g]);
+            for (auto const p : {p0, p1}) {
+                for (auto const adj : device.get_adjacencies(p)) {
+                    apply_swap(p, adj);
+                    auto const candidate_score = std::max(decay[p], decay[adj]) * score();
+                    apply_swap(p, adj);
+                    if (candidate_score < best_score) {
+                        best_score = candidate_score;
+                        best_swap  = {p, adj};
+                    }
+                }
+            }
+        }
+
+        auto const [s0, s1] = best_swap;
+        if (s0 == max_qubit_id) return std::nullopt;  // the front gates only touch isolated qubits
+        apply_swap(s0, s1);
+        ++num_swaps;
+        ++swaps_since_progress;
+        if (num_swaps % sabre_decay_reset == 0) {
+            std::ranges::fill(decay, 1.);
+        } else {
+            decay[s0] += sabre_decay_delta;
+            decay[s1] += sabre_decay_delta;
+        }
+    }
+
+    return num_swaps;
+}
+
+}  // namespace
+
+/**
+ * @brief Place logical qubit
+ *
+ * @param device
+ * @return vector<size_t>
+ */
+std::vector<QubitIdType> SabrePlacer::_place(Device& device) const {
+    if (_dependency == nullptr) {
+        spdlog::warn("SABRE placement needs the circuit to map; falling back to DFS placement.");
+        return DFSPlacer::_place(device);
+    }
+
+    device.calculate_path();
+    Device const& dev = device;
+
+    auto const num_restarts = std::max<size_t>(_num_restarts, 1);
+    std::vector<std::vector<QubitIdType>> placements(num_restarts);
+    // a restart that runs into qubits on disconnected parts of the device is given up as unroutable
+    constexpr auto unroutable = std::numeric_limits<size_t>::max();
+    std::vector<size_t> num_swaps(num_restarts, unroutable);
+
+    // Restart 0 refines the DFS placement; the others start from random placements seeded by
+    // (_seed, restart) so that the result is reproducible regardless of the thread schedule.
+    auto const dfs_placement = DFSPlacer::_place(device);
+#pragma omp parallel for schedule(dynamic)
+    for (size_t restart = 0; restart < num_restarts; ++restart) {
+        auto placement = dfs_placement;
+        if (restart > 0) {
+            std::seed_seq seeds{_seed, restart};
+            std::ranges::shuffle(placement, std::mt19937_64{seeds});
+        }
+        auto routable = true;
+        for (size_t i = 0; i < _num_iterations && routable; ++i) {
+            routable = sabre_pass(*_dependency, dev, placement, false).has_value() &&
+                       sabre_pass(*_dependency, dev, placement, true).has_value();
+        }
+        if (!routable) continue;
+        // NOTE - score with a forward pass on a copy; the pass moves the qubits
+        auto final_mapping  = placement;
+        num_swaps[restart]  = sabre_pass(*_dependency, dev, final_mapping, false).value_or(unroutable);
+        placements[restart] = std::move(placement);
+    }
+
+    auto const best = std::ranges::min_element(num_swaps) - num_swaps.begin();
+    if (num_swaps[best] == unroutable) {
+        spdlog::warn("SABRE placement cannot route the circuit on a disconnected device; falling back to DFS placement.");
+        return dfs_placement;
+    }
+    spdlog::debug("SABRE placement: {} estimated SWAPs (restart {} of {})", num_swaps[best], best, num_restarts);
+    return placements[best];
+}
+
 }  // namespace qsyn::duostra
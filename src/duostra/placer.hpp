@@ -20,6 +20,8 @@ class Device;
 
 namespace qsyn::duostra {
 
+class DependencyGraph;
+
 class BasePlacer {
 public:
     using Device = qsyn::device::Device;
@@ -62,6 +64,30 @@ private:
     void _dfs_device(QubitIdType current, Device& device, std::vector<QubitIdType>& assign, std::vector<bool>& qubit_marks) const;
 };
 
-std::unique_ptr<BasePlacer> get_placer();
+/**
+ * @brief Refines the initial placement with SABRE-style forward and backward routing
+ *        passes over the circuit (Li et al., ASPLOS 2019). Several restarts from
+ *        random placements run in parallel, and the placement with the fewest
+ *        estimated SWAPs wins. Without a circuit, it falls back to DFS placement.
+ *
+ */
+class SabrePlacer : public DFSPlacer {
+public:
+    using Device = DFSPlacer::Device;
+    SabrePlacer(std::shared_ptr<DependencyGraph const> dependency, size_t num_restarts, size_t num_iterations, size_t seed)
+        : _dependency(std::move(dependency)), _num_restarts(num_restarts), _num_iterations(num_iterations), _seed(seed) {}
+    ~SabrePlacer() override = default;
+
+protected:
+    std::vector<QubitIdType> _place(Device& /*unused*/) const override;
+
+private:
+    std::shared_ptr<DependencyGraph const> _dependency;
+    size_t _num_restarts;
+    size_t _num_iterations;
+    size_t _seed;
+};
+
+std::unique_ptr<BasePlacer> get_placer(std::shared_ptr<DependencyGraph const> dependency = nullptr);
 
 }  // namespace qsyn::duostra
@@ -10,6 +10,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <gsl/narrow>
 #include <gsl/util>
 
@@ -35,6 +36,85 @@ namespace qsyn::duostra {
 AStarNode::AStarNode(size_t cost, QubitIdType id, bool source)
     : _estimated_cost(cost), _id(id), _source(source) {}
 
+// SECTION - Class RoutingWorkspace Member Functions
+
+/**
+ * @brief Start a new search over `num_qubits` qubits. Everything marked by the previous
+ *        search becomes unmarked without touching the per-qubit arrays.
+ *
+ * @param num_qubits
+ */
+void RoutingWorkspace::begin(size_t num_qubits) {
+    if (_marked_epoch.size() != num_qubits) {
+        _marked_epoch.assign(num_qubits, 0);
+        _taken_epoch.assign(num_qubits, 0);
+        _predecessor.resize(num_qubits);
+        _cost.resize(num_qubits);
+        _swap_time.resize(num_qubits);
+        _penalty.resize(num_qubits);
+        _source.resize(num_qubits);
+        _epoch = 0;
+    }
+    if (++_epoch == 0) {
+        // the counter wrapped around; stale stamps could now collide with the new epoch
+        std::ranges::fill(_marked_epoch, 0);
+        std::ranges::fill(_taken_epoch, 0);
+        _epoch = 1;
+    }
+    _open_list.clear();
+}
+
+/**
+ * @brief Mark qubit as seen by the search
+ *
+ * @param q
+ * @param source false: from 0, true: from 1
+ * @param pred predecessor
+ */
+void RoutingWorkspace::mark(QubitIdType q, bool source, QubitIdType pred) {
+    _marked_epoch[q] = _epoch;
+    _source[q]       = source;
+    _predecessor[q]  = pred;
+}
+
+/**
+ * @brief Take the route through qubit
+ *
+ * @param q
+ * @param cost the time the route through q is ready
+ * @param swap_time
+ * @param penalty
+ */
+void RoutingWorkspace::take_route(QubitIdType q, size_t cost, size_t swap_time, size_t penalty) {
+    _taken_epoch[q] = _epoch;
+    _cost[q]        = cost;
+    _swap_time[q]   = swap_time;
+    _penalty[q]     = penalty;
+}
+
+/**
+ * @brief Push a node into the open list
+ *
+ * @param node
+ */
+void RoutingWorkspace::push(AStarNode const& node) {
+    _open_list.emplace_back(node);
+    std::push_heap(_open_list.begin(), _open_list.end(), AStarComp{});
+}
+
+/**
+ * @brief Pop the node with the smallest estimated cost from the open list
+ *
+ * @return AStarNode
+ */
+AStarNode RoutingWorkspace::pop() {
+    assert(!_open_list.empty());
+    std::pop_heap(_open_list.begin(), _open_list.end(), AStarComp{});
+    auto const node = _open_list.back();
+    _open_list.pop_back();
+    return node;
+}
+
 // SECTION - Class Router Member Functions
 
 /**
@@ -144,9 +224,7 @@ bool Router::is_executable(Gate const& gate) {
 
     auto physical_qubits_ids{_get_physical_qubits(gate)};
     assert(get<1>(physical_qubits_ids) != max_qubit_id);
-    PhysicalQubit const& q0 = _device.get_physical_qubit(get<0>(physical_qubits_ids));
-    PhysicalQubit const& q1 = _device.get_physical_qubit(get<1>(physical_qubits_ids));
-    return q0.is_adjacency(q1);
+    return _device.is_adjacent(get<0>(physical_qubits_ids), get<1>(physical_qubits_ids));
 }
 
 /**
@@ -160,9 +238,8 @@ bool Router::is_executable(Gate const& gate) {
 Router::Operation Router::execute_single(GateRotationCategory gate, dvlab::Phase phase, QubitIdType q) {
     auto& qubit           = _device.get_physical_qubit(q);
     auto const start_time = qubit.get_occupied_time();
-    auto const end_time   = start_time + SINGLE_DELAY;
+    auto const end_time   = start_time + _device.get_single_duration(q);
     qubit.set_occupied_time(end_time);
-    qubit.reset();
     Operation op{gate, phase, std::make_tuple(q, max_qubit_id), std::make_tuple(start_time, end_time)};
     spdlog::debug("execute_single: {}", op);
     return op;
@@ -198,36 +275,35 @@ std::vector<Router::Operation> Router::duostra_routing(Gate const& gate, std::tu
         }
     }
 
-    PhysicalQubit& t0 = _device.get_physical_qubit(q0_id);  // target 0
-    PhysicalQubit& t1 = _device.get_physical_qubit(q1_id);  // target 1
-    // priority queue: pop out the node with the smallest cost from both the sources
-    PriorityQueue priority_queue;
+    auto const t0_id = q0_id;  // target 0
+    auto const t1_id = q1_id;  // target 1
+    // open list: pop out the node with the smallest cost from both the sources
+    _workspace.begin(_device.get_num_qubits());
 
     // init conditions for the sources
-    t0.mark(false, t0.get_id());
-    t0.take_route(t0.get_cost(), 0);
-    t1.mark(true, t1.get_id());
-    t1.take_route(t1.get_cost(), 0);
-    auto const touch0 = _touch_adjacency(t0, priority_queue, false);
+    _workspace.mark(t0_id, false, t0_id);
+    _workspace.take_route(t0_id, _device.get_physical_qubit(t0_id).get_occupied_time(), 0);
+    _workspace.mark(t1_id, true, t1_id);
+    _workspace.take_route(t1_id, _device.get_physical_qubit(t1_id).get_occupied_time(), 0);
+    auto const touch0 = _touch_adjacency(t0_id, false);
     auto is_adjacent  = get<0>(touch0);
-    _touch_adjacency(t1, priority_queue, true);
+    _touch_adjacency(t1_id, true);
 
     // the two paths from the two sources propagate until the two paths meet each other
     while (!is_adjacent) {
-        // each iteration gets an element from the priority queue
-        auto const next{priority_queue.top()};
-        priority_queue.pop();
+        // each iteration gets an element from the open list
+        auto const next      = _workspace.pop();
         auto const q_next_id = next.get_id();
-        auto& q_next         = _device.get_physical_qubit(q_next_id);
         // FIXME - swtch to source
-        assert(q_next.get_source() == next.get_source());
+        assert(_workspace.get_source(q_next_id) == next.get_source());
 
         // mark the element as visited and check its neighbors
-        auto const cost = next.get_cost();
-        assert(cost >= SWAP_DELAY);
-        auto const operation_time = cost - SWAP_DELAY;
-        q_next.take_route(cost, operation_time);
-        auto const touch = _touch_adjacency(q_next, priority_queue, next.get_source());
+        auto const q_pred_id      = _workspace.get_predecessor(q_next_id);
+        auto const operation_time = std::max(_workspace.get_cost(q_pred_id), _device.get_physical_qubit(q_next_id).get_occupied_time());
+        auto const cost           = operation_time + _device.get_swap_duration(q_pred_id, q_next_id);
+        assert(next.get_cost() >= cost);
+        _workspace.take_route(q_next_id, cost, operation_time, next.get_cost() - cost);
+        auto const touch = _touch_adjacency(q_next_id, next.get_source());
         is_adjacent      = get<0>(touch);
         if (is_adjacent) {
             if (next.get_source())  // 0 get true means touch 1's set
@@ -240,19 +316,13 @@ std::vector<Router::Operation> Router::duostra_routing(Gate const& gate, std::tu
             }
         }
     }
-    auto const operation_list =
-        _traceback(gate, _device.get_physical_qubit(q0_id), _device.get_physical_qubit(q1_id), t0, t1, swap_ids, swapped);
+    auto const operation_list = _traceback(gate, q0_id, q1_id, t0_id, t1_id, swap_ids, swapped);
 
     spdlog::debug("Operation List:");
     for (auto const& op : operation_list) {
         spdlog::debug("  {}", op);
     }
 
-    for (size_t i = 0; i < _device.get_num_qubits(); ++i) {
-        auto& qubit = _device.get_physical_qubit(gsl::narrow<QubitIdType>(i));
-        qubit.reset();
-        assert(qubit.get_logical_qubit() < _device.get_num_qubits());
-    }
     return operation_list;
 }
 
@@ -273,7 +343,7 @@ std::vector<Router::Operation> Router::apsp_routing(Gate const& gate, std::tuple
     auto q0_id = s0_id;
     auto q1_id = s1_id;
 
-    while (!_device.get_physical_qubit(q0_id).is_adjacency(_device.get_physical_qubit(q1_id))) {
+    while (!_device.is_adjacent(q0_id, q1_id)) {
         auto q0_next_cost = _device.get_next_swap_cost(q0_id, s1_id);
         auto q1_next_cost = _device.get_next_swap_cost(q1_id, s0_id);
 
@@ -286,26 +356,26 @@ std::vector<Router::Operation> Router::apsp_routing(Gate const& gate, std::tuple
                                     _device.get_physical_qubit(q0_id).get_logical_qubit() <
                                         _device.get_physical_qubit(q1_id).get_logical_qubit())) {
             Operation oper(GateRotationCategory::swap, dvlab::Phase(0), std::make_tuple(q0_id, q0_next),
-                           std::make_tuple(q0_cost, q0_cost + SWAP_DELAY));
+                           std::make_tuple(q0_cost, q0_cost + _device.get_swap_duration(q0_id, q0_next)));
             _device.apply_gate(oper);
             operation_list.emplace_back(std::move(oper));
             q0_id = q0_next;
         } else {
             Operation oper(GateRotationCategory::swap, dvlab::Phase(0), std::make_tuple(q1_id, q1_next),
-                           std::make_tuple(q0_cost, q0_cost + SWAP_DELAY));
+                           std::make_tuple(q0_cost, q0_cost + _device.get_swap_duration(q1_id, q1_next)));
             _device.apply_gate(oper);
             operation_list.emplace_back(std::move(oper));
             q1_id = q1_next;
         }
     }
-    assert(_device.get_physical_qubit(q1_id).is_adjacency(_device.get_physical_qubit(q0_id)));
+    assert(_device.is_adjacent(q1_id, q0_id));
 
     auto const gate_cost = std::max(_device.get_physical_qubit(q0_id).get_occupied_time(),
                                     _device.get_physical_qubit(q1_id).get_occupied_time());
 
     assert(gate.is_cx() || gate.is_cz());
     Operation cx_gate(gate.get_type(), gate.get_phase(), swapped ? std::make_tuple(q1_id, q0_id) : std::make_tuple(q0_id, q1_id),
-                      std::make_tuple(gate_cost, gate_cost + DOUBLE_DELAY));
+                      std::make_tuple(gate_cost, gate_cost + _device.get_double_duration(q0_id, q1_id)));
     _device.apply_gate(cx_gate);
     cx_gate.set_id(gate.get_id());
     operation_list.emplace_back(cx_gate);
@@ -314,36 +384,35 @@ std::vector<Router::Operation> Router::apsp_routing(Gate const& gate, std::tuple
 }
 
 /**
- * @brief Find adjacencies and put into priority queue until touched
+ * @brief Find adjacencies and put into the open list until touched
  *
  * @param qubit
- * @param pq
  * @param source
  * @return tuple<bool, size_t>
  */
-std::tuple<bool, QubitIdType> Router::_touch_adjacency(PhysicalQubit& qubit, PriorityQueue& pq, bool source) {
-    // mark all the adjacent qubits as seen and push them into the priority queue
-    for (auto& i : qubit.get_adjacencies()) {
-        PhysicalQubit& adj = _device.get_physical_qubit(i);
+std::tuple<bool, QubitIdType> Router::_touch_adjacency(QubitIdType qubit, bool source) {
+    // mark all the adjacent qubits as seen and push them into the open list
+    for (auto const adj : _device.get_adjacencies(qubit)) {
         // see if already in the queue
-        if (adj.is_marked()) {
+        if (_workspace.is_marked(adj)) {
             // see if the taken one is from different path from the original qubit
             // if yes, means the two paths meet each other
-            if (adj.is_taken()) {
+            if (_workspace.is_taken(adj)) {
                 // touch target
-                if (adj.get_source() != source) {
-                    assert(adj.get_id() == i);
-                    return std::make_tuple(true, adj.get_id());
+                if (_workspace.get_source(adj) != source) {
+                    return std::make_tuple(true, adj);
                 }
             }
             continue;
         }
 
-        // push the node into the priority queue
-        auto const cost = std::max(qubit.get_cost(), adj.get_occupied_time()) + SWAP_DELAY;
-        adj.mark(source, qubit.get_id());
+        // push the node into the open list; the penalties only steer the search and are not part of the schedule
+        auto const cost = std::max(_workspace.get_cost(qubit), _device.get_physical_qubit(adj).get_occupied_time()) +
+                          _device.get_swap_duration(qubit, adj) +
+                          _workspace.get_penalty(qubit) + _device.get_swap_penalty(qubit, adj);
+        _workspace.mark(adj, source, qubit);
 
-        pq.push(AStarNode(cost, adj.get_id(), source));
+        _workspace.push(AStarNode(cost, adj, source));
     }
     return std::make_tuple(false, max_qubit_id);
 }
@@ -361,55 +430,53 @@ std::tuple<bool, QubitIdType> Router::_touch_adjacency(PhysicalQubit& qubit, Pri
  * @param swapped if the qubits of gate are swapped when added into Duostra
  * @return vector<Operation>
  */
-std::vector<Router::Operation> Router::_traceback(Gate const& gate, PhysicalQubit& q0, PhysicalQubit& q1, PhysicalQubit& t0, PhysicalQubit& t1, bool swap_ids, bool swapped) {
-    assert(t0.get_id() == t0.get_predecessor());
-    assert(t1.get_id() == t1.get_predecessor());
+std::vector<Router::Operation> Router::_traceback(Gate const& gate, QubitIdType q0, QubitIdType q1, QubitIdType t0, QubitIdType t1, bool swap_ids, bool swapped) {
+    assert(t0 == _workspace.get_predecessor(t0));
+    assert(t1 == _workspace.get_predecessor(t1));
 
-    assert(q0.is_adjacency(q1));
+    assert(_device.is_adjacent(q0, q1));
     std::vector<Operation> operation_list;
 
-    auto const operation_time = std::max(q0.get_cost(), q1.get_cost());
+    auto const operation_time = std::max(_workspace.get_cost(q0), _workspace.get_cost(q1));
 
     assert(gate.is_cx() || gate.is_cz());
 
     // NOTE - Order of qubits in CX matters
-    std::tuple<size_t, size_t> qids = swap_ids ? std::make_tuple(q1.get_id(), q0.get_id()) : std::make_tuple(q0.get_id(), q1.get_id());
+    std::tuple<size_t, size_t> qids = swap_ids ? std::make_tuple(q1, q0) : std::make_tuple(q0, q1);
     if (swapped) {
         qids = std::make_tuple(get<1>(qids), get<0>(qids));
     }
-    Operation cx_gate(gate.get_type(), gate.get_phase(), qids, std::make_tuple(operation_time, operation_time + DOUBLE_DELAY));
+    Operation cx_gate(gate.get_type(), gate.get_phase(), qids, std::make_tuple(operation_time, operation_time + _device.get_double_duration(q0, q1)));
     cx_gate.set_id(gate.get_id());
     operation_list.emplace_back(cx_gate);
 
     // traceback by tracing the parent iteratively
-    auto trace0 = q0.get_id();
-    auto trace1 = q1.get_id();
+    auto trace0 = q0;
+    auto trace1 = q1;
     // traceback by tracing the parent iteratively
     // trace 0
-    while (trace0 != t0.get_id()) {
-        auto const& q_trace0   = _device.get_physical_qubit(trace0);
-        auto const trace_pred0 = q_trace0.get_predecessor();
+    while (trace0 != t0) {
+        auto const trace_pred0 = _workspace.get_predecessor(trace0);
 
-        auto const swap_time = q_trace0.get_swap_time();
+        auto const swap_time = _workspace.get_swap_time(trace0);
         operation_list.emplace_back(
             GateRotationCategory::swap,
             dvlab::Phase(0),
             std::make_tuple(trace0, trace_pred0),
-            std::make_tuple(swap_time, swap_time + SWAP_DELAY));
+            std::make_tuple(swap_time, swap_time + _device.get_swap_duration(trace0, trace_pred0)));
 
         trace0 = trace_pred0;
     }
-    while (trace1 != t1.get_id())  // trace 1
+    while (trace1 != t1)  // trace 1
     {
-        auto& q_trace1   = _device.get_physical_qubit(trace1);
-        auto trace_pred1 = q_trace1.get_predecessor();
+        auto const trace_pred1 = _workspace.get_predecessor(trace1);
 
-        auto swap_time = q_trace1.get_swap_time();
+        auto const swap_time = _workspace.get_swap_time(trace1);
         operation_list.emplace_back(
             GateRotationCategory::swap,
             dvlab::Phase(0),
             std::make_tuple(trace1, trace_pred1),
-            std::make_tuple(swap_time, swap_time + SWAP_DELAY));
+            std::make_tuple(swap_time, swap_time + _device.get_swap_duration(trace1, trace_pred1)));
 
         trace1 = trace_pred1;
     }
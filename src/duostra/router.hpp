@@ -8,8 +8,9 @@
 
 #pragma once
 
-#include <queue>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include "./duostra_def.hpp"
 #include "device/device.hpp"
@@ -41,6 +42,51 @@ public:
     }
 };
 
+/**
+ * @brief Scratch space of a Duostra routing call. The per-qubit search state lives in flat
+ *        arrays and is invalidated by bumping an epoch counter, so starting a new search is
+ *        O(1) and the buffers are reused across calls.
+ *
+ */
+class RoutingWorkspace {
+public:
+    RoutingWorkspace() = default;
+    // the buffers carry no state between calls, so copies of a router start with an empty workspace
+    RoutingWorkspace(RoutingWorkspace const&) {}
+    RoutingWorkspace& operator=(RoutingWorkspace const&) { return *this; }
+    RoutingWorkspace(RoutingWorkspace&&) noexcept            = default;
+    RoutingWorkspace& operator=(RoutingWorkspace&&) noexcept = default;
+    ~RoutingWorkspace()                                      = default;
+
+    void begin(size_t num_qubits);
+
+    bool is_marked(QubitIdType q) const { return _marked_epoch[q] == _epoch; }
+    bool is_taken(QubitIdType q) const { return _taken_epoch[q] == _epoch; }
+    bool get_source(QubitIdType q) const { return _source[q]; }
+    QubitIdType get_predecessor(QubitIdType q) const { return _predecessor[q]; }
+    size_t get_cost(QubitIdType q) const { return _cost[q]; }
+    size_t get_swap_time(QubitIdType q) const { return _swap_time[q]; }
+    size_t get_penalty(QubitIdType q) const { return _penalty[q]; }
+
+    void mark(QubitIdType q, bool source, QubitIdType pred);
+    void take_route(QubitIdType q, size_t cost, size_t swap_time, size_t penalty = 0);
+
+    // NOTE - open list, popped in the same order as a std::priority_queue with AStarComp
+    void push(AStarNode const& node);
+    AStarNode pop();
+
+private:
+    uint32_t _epoch = 0;
+    std::vector<uint32_t> _marked_epoch;
+    std::vector<uint32_t> _taken_epoch;
+    std::vector<QubitIdType> _predecessor;
+    std::vector<size_t> _cost;
+    std::vector<size_t> _swap_time;
+    std::vector<size_t> _penalty;  // SWAP penalties along the route, added to the cost to order the open list
+    std::vector<unsigned char> _source;  // 0: q0 propagate, 1: q1 propagate
+    std::vector<AStarNode> _open_list;
+};
+
 class Router {
 public:
     using Device        = qsyn::device::Device;
@@ -50,13 +96,13 @@ public:
     enum CostStrategyType { start,
                             end };
 
-    using PriorityQueue = std::priority_queue<AStarNode, std::vector<AStarNode>, AStarComp>;
     Router(Device&& device, CostStrategyType cost_strategy, MinMaxOptionType tie_breaking_strategy);
 
     std::unique_ptr<Router> clone() const;
 
     auto& get_device() { return _device; }
     auto const& get_device() const { return _device; }
+    std::vector<QubitIdType> const& get_logical_to_physical() const { return _logical_to_physical; }
 
     size_t get_gate_cost(Gate const&, MinMaxOptionType min_max, size_t apsp_coeff);
     bool is_executable(Gate const&);
@@ -74,12 +120,13 @@ private:
     bool _apsp : 1;
     bool _duostra : 1;
     bool _greedy_type : 1;
+    RoutingWorkspace _workspace;
 
     void _initialize();
     std::tuple<QubitIdType, QubitIdType> _get_physical_qubits(Gate const& gate) const;
 
-    std::tuple<bool, QubitIdType> _touch_adjacency(PhysicalQubit& qubit, PriorityQueue& pq, bool source);  // return <if touch target, target id>, swtch: false q0 propagate, true q1 propagate
-    std::vector<Operation> _traceback(Gate const& gate, PhysicalQubit& q0, PhysicalQubit& q1, PhysicalQubit& t0, PhysicalQubit& t1, bool swap_ids, bool swapped);
+    std::tuple<bool, QubitIdType> _touch_adjacency(QubitIdType qubit, bool source);  // return <if touch target, target id>, swtch: false q0 propagate, true q1 propagate
+    std::vector<Operation> _traceback(Gate const& gate, QubitIdType q0, QubitIdType q1, QubitIdType t0, QubitIdType t1, bool swap_ids, bool swapped);
 };
 
 }  // namespace qsyn::duostra
@@ -27,7 +27,7 @@ namespace qsyn::duostra {
  * @return unique_ptr<BaseScheduler>
  */
 std::unique_ptr<BaseScheduler> get_scheduler(std::unique_ptr<CircuitTopology> topo, bool tqdm) {
-    // 0:base 1:static 2:random 3:greedy 4:search
+    // 0:base 1:static 2:random 3:greedy 4:search 5:beam
     if (DuostraConfig::SCHEDULER_TYPE == SchedulerType::random) {
         return std::make_unique<RandomScheduler>(*topo.get(), tqdm);
     } else if (DuostraConfig::SCHEDULER_TYPE == SchedulerType::naive) {
@@ -36,6 +36,8 @@ std::unique_ptr<BaseScheduler> get_scheduler(std::unique_ptr<CircuitTopology> to
         return std::make_unique<GreedyScheduler>(*topo.get(), tqdm);
     } else if (DuostraConfig::SCHEDULER_TYPE == SchedulerType::search) {
         return std::make_unique<SearchScheduler>(*topo.get(), tqdm);
+    } else if (DuostraConfig::SCHEDULER_TYPE == SchedulerType::beam) {
+        return std::make_unique<BeamScheduler>(*topo.get(), tqdm);
     } else if (DuostraConfig::SCHEDULER_TYPE == SchedulerType::base) {
         return std::make_unique<BaseScheduler>(*topo.get(), tqdm);
     }
@@ -170,9 +172,11 @@ size_t BaseScheduler::route_one_gate(Router& router, size_t gate_id, bool forget
         if (op.get_time_end() > max_cost)
             max_cost = op.get_time_end();
     }
-    if (!forget)
+    // search-tree nodes forget their history so that cloning them stays cheap
+    if (!forget) {
         _operations.insert(_operations.end(), ops.begin(), ops.end());
-    _assign_order.emplace_back(gate_id);
+        _assign_order.emplace_back(gate_id);
+    }
     _circuit_topology.update_available_gates(gate_id);
     return max_cost;
 }
@@ -239,6 +239,39 @@ protected:
     void _cache_when_necessary();
 };
 
+class BeamScheduler : public GreedyScheduler {  // NOLINT(hicpp-special-member-functions, cppcoreguidelines-special-member-functions) : copy-swap idiom
+public:
+    using Device    = GreedyScheduler::Device;
+    using Operation = GreedyScheduler::Operation;
+    BeamScheduler(CircuitTopology const&, bool = true);
+    ~BeamScheduler() override = default;
+    BeamScheduler(BeamScheduler const&);
+    BeamScheduler(BeamScheduler&&) noexcept;
+
+    BeamScheduler& operator=(BeamScheduler copy) {
+        copy.swap(*this);
+        return *this;
+    }
+
+    void swap(BeamScheduler& other) noexcept {
+        std::swap(static_cast<GreedyScheduler&>(*this), static_cast<GreedyScheduler&>(other));
+        std::swap(_beam_width, other._beam_width);
+        std::swap(_lookahead, other._lookahead);
+    }
+
+    friend void swap(BeamScheduler& a, BeamScheduler& b) noexcept {
+        a.swap(b);
+    }
+
+    std::unique_ptr<BaseScheduler> clone() const override;
+
+protected:
+    size_t _beam_width;
+    size_t _lookahead;
+
+    Device _assign_gates(std::unique_ptr<Router> /*unused*/) override;
+};
+
 std::unique_ptr<BaseScheduler> get_scheduler(std::unique_ptr<CircuitTopology>, bool = true);
 
 }  // namespace qsyn::duostra
@@ -0,0 +1,250 @@
+/****************************************************************************
+  PackageName  [ duostra ]
+  Synopsis     [ Define class Beam Scheduler member functions ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "./duostra.hpp"
+#include "./scheduler.hpp"
+#include "util/util.hpp"
+
+extern bool stop_requested();
+
+namespace qsyn::duostra {
+
+namespace {
+
+/**
+ * @brief A partial schedule kept in the beam. `decisions` holds the gates routed since the
+ *        last committed step, one entry per branching decision.
+ *
+ */
+struct BeamState {
+    std::unique_ptr<Router> router;
+    std::unique_ptr<BaseScheduler> scheduler;
+    size_t max_cost      = 0;
+    size_t occupied_time = 0;  // sum over physical qubits; breaks ties between equal max_cost
+    uint64_t key         = 0;  // hash of (logical-to-physical mapping, front layer)
+    std::deque<std::vector<size_t>> decisions;
+
+    bool done() const { return scheduler->get_available_gates().empty(); }
+};
+
+/**
+ * @brief Route the gates that need no SWAPs, as the greedy scheduler would.
+ *
+ * @param state
+ * @param routed the routed gates are appended here
+ */
+void route_executable_gates(BeamState& state, std::vector<size_t>& routed) {
+    std::optional<size_t> gate_id;
+    while ((gate_id = state.scheduler->get_executable_gate(*state.router)) != std::nullopt) {
+        state.max_cost = std::max(state.max_cost, state.scheduler->route_one_gate(*state.router, gate_id.value(), true));
+        routed.emplace_back(gate_id.value());
+    }
+}
+
+/**
+ * @brief Recompute the tie-breaking cost and the transposition key of the state.
+ *        Two states with the same key have executed the same set of gates and
+ *        placed the logical qubits the same way, so only the cheaper one is kept.
+ *
+ * @param state
+ */
+void update_state_summary(BeamState& state) {
+    state.occupied_time = 0;
+    for (auto const& qubit : state.router->get_device().get_physical_qubit_list()) {
+        state.occupied_time += qubit.get_occupied_time();
+    }
+
+    auto front = state.scheduler->get_available_gates();
+    std::ranges::sort(front);
+
+    // FNV-1a over the mapping, a separator, and the sorted front layer
+    uint64_t hash   = 14695981039346656037ULL;
+    auto const feed = [&hash](uint64_t value) {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    };
+    for (auto const physical : state.router->get_logical_to_physical()) feed(static_cast<uint64_t>(physical));
+    feed(UINT64_MAX);
+    for (auto const gate_id : front) feed(gate_id);
+    state.key = hash;
+}
+
+/**
+ * @brief Branch on `gate_id` from `parent`: route it, then route every gate that becomes executable.
+ *
+ * @param parent
+ * @param gate_id
+ * @return BeamState
+ */
+BeamState expand(BeamState const& parent, size_t gate_id) {
+    BeamState child{parent.router->clone(), parent.scheduler->clone(), parent.max_cost, 0, 0, parent.decisions};
+    std::vector<size_t> routed{gate_id};
+    child.max_cost = std::max(child.max_cost, child.scheduler->route_one_gate(*child.router, gate_id, true));
+    route_executable_gates(child, routed);
+    child.decisions.emplace_back(std::move(routed));
+    update_state_summary(child);
+    return child;
+}
+
+bool is_better(BeamState const& a, BeamState const& b) {
+    return std::tie(a.max_cost, a.occupied_time) < std::tie(b.max_cost, b.occupied_time);
+}
+
+}  // namespace
+
+// SECTION - Class Beam Scheduler Member Functions
+
+/**
+ * @brief Construct a new Beam Scheduler:: Beam Scheduler object
+ *
+ * @param topo
+ * @param tqdm
+ */
+BeamScheduler::BeamScheduler(CircuitTopology const& topo, bool tqdm)
+    : GreedyScheduler(topo, tqdm),
+      _beam_width(std::max<size_t>(DuostraConfig::BEAM_WIDTH, 1)),
+      _lookahead(std::max<size_t>(DuostraConfig::SEARCH_DEPTH, 1)) {}
+
+/**
+ * @brief Construct a new Beam Scheduler:: Beam Scheduler object
+ *
+ * @param other
+ */
+BeamScheduler::BeamScheduler(BeamScheduler const& other)
+    : GreedyScheduler(other),
+      _beam_width(other._beam_width),
+      _lookahead(other._lookahead) {}
+
+/**
+ * @brief Construct a new Beam Scheduler:: Beam Scheduler object
+ *
+ * @param other
+ */
+BeamScheduler::BeamScheduler(BeamScheduler&& other) noexcept
+    : GreedyScheduler(std::move(other)),
+      _beam_width(other._beam_width),
+      _lookahead(other._lookahead) {}
+
+/**
+ * @brief Clone scheduler
+ *
+ * @return unique_ptr<BaseScheduler>
+ */
+std::unique_ptr<BaseScheduler> BeamScheduler::clone() const {
+    return std::make_unique<BeamScheduler>(*this);
+}
+
+/**
+ * @brief Assign gates by beam search. Each step branches every kept state on its
+ *        candidate gates in parallel, drops states that reach the same mapping and
+ *        front layer as a cheaper one, and keeps the best `_beam_width` states.
+ *        Once the best state is `_lookahead` decisions ahead, its first decision is
+ *        committed and the states that disagree with it are discarded.
+ *
+ * @param router
+ * @return Device
+ */
+BeamScheduler::Device BeamScheduler::_assign_gates(std::unique_ptr<Router> router) {
+    dvlab::TqdmWrapper bar{_circuit_topology.get_num_gates(), _tqdm};
+
+    auto const commit = [&](std::vector<size_t> const& gate_ids) {
+        for (auto const gate_id : gate_ids) {
+            route_one_gate(*router, gate_id);
+            ++bar;
+        }
+    };
+
+    std::vector<BeamState> beam;
+    {
+        BeamState root{router->clone(), clone(), 0, 0, 0, {}};
+        std::vector<size_t> routed;
+        route_executable_gates(root, routed);
+        commit(routed);
+        update_state_summary(root);
+        beam.emplace_back(std::move(root));
+    }
+
+    while (!beam.front().done()) {
+        if (stop_requested()) {
+            return router->get_device();
+        }
+
+        // NOTE - enumerate the branches first so that the expansion can be distributed evenly
+        std::vector<std::pair<size_t, size_t>> branches;  // (state index, gate id)
+        std::vector<BeamState> next_beam;
+        for (size_t i = 0; i < beam.size(); ++i) {
+            if (beam[i].done()) {
+                next_beam.emplace_back(std::move(beam[i]));
+                continue;
+            }
+            auto const& avail_gates = beam[i].scheduler->get_available_gates();
+            auto const num_branches = std::min(avail_gates.size(), _conf.num_candidates);
+            for (size_t j = 0; j < num_branches; ++j) {
+                branches.emplace_back(i, avail_gates[j]);
+            }
+        }
+
+        std::vector<BeamState> children(branches.size());
+#pragma omp parallel for schedule(dynamic)
+        for (size_t i = 0; i < branches.size(); ++i) {
+            children[i] = expand(beam[branches[i].first], branches[i].second);
+        }
+        std::ranges::move(children, std::back_inserter(next_beam));
+
+        // NOTE - transposition table: keep the best state for each (mapping, front layer)
+        std::unordered_map<uint64_t, size_t> best_by_key;
+        best_by_key.reserve(next_beam.size());
+        std::vector<bool> pruned(next_beam.size(), false);
+        for (size_t i = 0; i < next_beam.size(); ++i) {
+            auto const [it, inserted] = best_by_key.emplace(next_beam[i].key, i);
+            if (inserted) continue;
+            if (is_better(next_beam[i], next_beam[it->second])) {
+                pruned[it->second] = true;
+                it->second         = i;
+            } else {
+                pruned[i] = true;
+            }
+        }
+
+        beam.clear();
+        for (size_t i = 0; i < next_beam.size(); ++i) {
+            if (!pruned[i]) beam.emplace_back(std::move(next_beam[i]));
+        }
+        std::ranges::stable_sort(beam, is_better);
+        if (beam.size() > _beam_width) {
+            beam.erase(dvlab::iterator::next(beam.begin(), _beam_width), beam.end());
+        }
+
+        if (beam.front().done() || beam.front().decisions.size() < _lookahead) continue;
+
+        // commit the first decision of the best state
+        auto const committed = beam.front().decisions.front();
+        commit(committed);
+        std::erase_if(beam, [&committed](BeamState const& state) {
+            return state.decisions.empty() || state.decisions.front() != committed;
+        });
+        for (auto& state : beam) state.decisions.pop_front();
+    }
+
+    for (auto const& gate_ids : beam.front().decisions) {
+        commit(gate_ids);
+    }
+
+    return router->get_device();
+}
+
+}  // namespace qsyn::duostra
@@ -7,6 +7,7 @@
 
 #include "./extract.hpp"
 
+#include <atomic>
 #include <cassert>
 #include <memory>
 #include <ranges>
@@ -458,11 +459,14 @@ void Extractor::column_optimal_swap() {
     }
     std::vector<ZXVertex*> neb_vec(_neighbors.begin(), _neighbors.end());
     std::vector<ZXVertex*> new_neb_vec = neb_vec;
+    std::vector<size_t> new_to_old(col_cnt);
     for (size_t i = 0; i < neb_vec.size(); i++) {
         new_neb_vec[i] = neb_vec[perm[i]];
+        new_to_old[i]  = perm[i];
     }
     _neighbors.clear();
     for (auto& v : new_neb_vec) _neighbors.emplace(v);
+    _biadjacency.permute_columns(new_to_old);
 }
 
 /**
@@ -615,17 +619,31 @@ bool Extractor::biadjacency_eliminations(bool check) {
     if (OPTIMIZE_LEVEL != 2) {
         // NOTE - opt = 0, 1 or 3
         column_optimal_swap();
-        update_matrix();
 
         if (OPTIMIZE_LEVEL == 0) {
             _biadjacency.gaussian_elimination_skip(BLOCK_SIZE, true, true);
             if (FILTER_DUPLICATE_CXS) _filter_duplicate_cxs();
             _cnots = _biadjacency.get_row_operations();
         } else if (OPTIMIZE_LEVEL == 1 || OPTIMIZE_LEVEL == 3) {
-            auto min_cnots = SIZE_MAX;
+            // NOTE - The block sizes are tried concurrently. A candidate is abandoned once it needs more CXs than
+            //        the best one so far; ties go to the smallest block size, as in a sequential sweep
+            std::atomic<size_t> min_cnots = SIZE_MAX;
+            size_t best_block             = SIZE_MAX;
             dvlab::BooleanMatrix best_matrix;
-            for (size_t blk = 1; blk < _biadjacency.num_cols(); blk++) {
-                _block_elimination(best_matrix, min_cnots, blk);
+            auto const num_blocks = _biadjacency.num_cols();
+#pragma omp parallel for schedule(dynamic)
+            for (size_t blk = 1; blk < num_blocks; blk++) {
+                auto candidate = _block_elimination(blk, min_cnots.load(std::memory_order_relaxed));
+                if (!candidate.has_value()) continue;
+                auto const n_cnots = candidate->get_row_operations().size();
+#pragma omp critical
+                {
+                    if (n_cnots < min_cnots || (n_cnots == min_cnots && blk < best_block)) {
+                        min_cnots   = n_cnots;
+                        best_block  = blk;
+                        best_matrix = std::move(*candidate);
+                    }
+                }
             }
             if (OPTIMIZE_LEVEL == 1) {
                 _biadjacency = best_matrix;
@@ -658,20 +676,17 @@ bool Extractor::biadjacency_eliminations(bool check) {
 }
 
 /**
- * @brief Perform Gaussian Elimination with block size `blockSize`
+ * @brief Perform Gaussian Elimination with block size `block_size` on a copy of the biadjacency matrix
  *
- * @param bestMatrix Currently best matrix
- * @param minCnots Minimum value
- * @param blockSize
+ * @param block_size
+ * @param max_n_cxs give up if more CXs than this are needed
+ * @return the eliminated matrix, or std::nullopt if given up
  */
-void Extractor::_block_elimination(dvlab::BooleanMatrix& best_matrix, size_t& min_n_cxs, size_t block_size) {
+std::optional<dvlab::BooleanMatrix> Extractor::_block_elimination(size_t block_size, size_t max_n_cxs) const {
     dvlab::BooleanMatrix copied_matrix = _biadjacency;
-    copied_matrix.gaussian_elimination_skip(block_size, true, true);
-    if (FILTER_DUPLICATE_CXS) _filter_duplicate_cxs();
-    if (copied_matrix.get_row_operations().size() < min_n_cxs) {
-        min_n_cxs   = copied_matrix.get_row_operations().size();
-        best_matrix = copied_matrix;
-    }
+    copied_matrix.gaussian_elimination_skip(block_size, true, true, max_n_cxs);
+    if (copied_matrix.get_row_operations().size() > max_n_cxs) return std::nullopt;
+    return copied_matrix;
 }
 
 void Extractor::_block_elimination(size_t& best_block, dvlab::BooleanMatrix& best_matrix, size_t& min_cost, size_t block_size) {
@@ -813,17 +828,37 @@ void Extractor::update_neighbors() {
  * @param et EdgeType, default: EdgeType::HADAMARD
  */
 void Extractor::update_graph_by_matrix(EdgeType et) {
-    size_t r = 0;
     spdlog::debug("Updating graph by matrix");
+    std::unordered_map<ZXVertex*, size_t> neighbor_to_col;
+    neighbor_to_col.reserve(_neighbors.size());
+    size_t c = 0;
+    for (auto& nb : _neighbors) {
+        neighbor_to_col.emplace(nb, c);
+        c++;
+    }
+
+    size_t r = 0;
     for (auto& f : _frontier) {
-        size_t c = 0;
-        for (auto& nb : _neighbors) {
-            if (_biadjacency[r][c] == 1 && !_graph->is_neighbor(nb, f, et)) {  // NOTE - Should connect but not connected
-                _graph->add_edge(f, nb, et);
-            } else if (_biadjacency[r][c] == 0 && _graph->is_neighbor(nb, f, et)) {  // NOTE - Should not connect but connected
-                _graph->remove_edge(f, nb, et);
+        // NOTE - XOR the row with the current connectivity of f; only the differing entries touch the graph
+        auto diff = _biadjacency[r];
+        for (auto& [nb, etype] : _graph->get_neighbors(f)) {
+            if (etype != et) continue;
+            if (auto const itr = neighbor_to_col.find(nb); itr != neighbor_to_col.end()) diff[itr->second] += 1;
+        }
+        if (!diff.is_zeros()) {
+            std::vector<std::pair<ZXVertex*, bool>> toggles;
+            c = 0;
+            for (auto& nb : _neighbors) {
+                if (diff[c] == 1) toggles.emplace_back(nb, _biadjacency[r][c] == 1);
+                c++;
+            }
+            for (auto& [nb, should_connect] : toggles) {
+                if (should_connect) {  // NOTE - Should connect but not connected
+                    _graph->add_edge(f, nb, et);
+                } else {  // NOTE - Should not connect but connected
+                    _graph->remove_edge(f, nb, et);
+                }
             }
-            c++;
         }
         r++;
     }
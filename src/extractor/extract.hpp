@@ -96,7 +96,7 @@ private:
     dvlab::BooleanMatrix _biadjacency;
     std::vector<dvlab::BooleanMatrix::RowOperation> _cnots;
 
-    void _block_elimination(dvlab::BooleanMatrix& matrix, size_t& min_n_cxs, size_t block_size);
+    std::optional<dvlab::BooleanMatrix> _block_elimination(size_t block_size, size_t max_n_cxs) const;
     void _block_elimination(size_t& best_block, dvlab::BooleanMatrix& best_matrix, size_t& min_cost, size_t block_size);
     void _filter_duplicate_cxs();
     std::vector<Operation> _duostra_assigned;
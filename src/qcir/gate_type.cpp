@@ -7,74 +7,170 @@
 
 #include "qcir/gate_type.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string_view>
+
 #include "util/util.hpp"
 
 namespace qsyn::qcir {
 
+namespace {
+
+/**
+ * @brief A gate name after stripping the control prefix, and the rotation it stands for.
+ *        `phase_den == 0` means the phase is not fixed by the name.
+ */
+struct BaseGateName {
+    std::string_view name;
+    GateRotationCategory category;
+    int phase_num = 0;
+    int phase_den = 0;
+};
+
+constexpr std::array base_gate_names{
+    // single-qubit Z-rotation gates
+    BaseGateName{"pz", GateRotationCategory::pz},
+    BaseGateName{"p", GateRotationCategory::pz},
+    BaseGateName{"rz", GateRotationCategory::rz},
+    BaseGateName{"z", GateRotationCategory::pz, 1, 1},
+    BaseGateName{"s", GateRotationCategory::pz, 1, 2},
+    BaseGateName{"s*", GateRotationCategory::pz, -1, 2},
+    BaseGateName{"sdg", GateRotationCategory::pz, -1, 2},
+    BaseGateName{"sd", GateRotationCategory::pz, -1, 2},
+    BaseGateName{"t", GateRotationCategory::pz, 1, 4},
+    BaseGateName{"t*", GateRotationCategory::pz, -1, 4},
+    BaseGateName{"tdg", GateRotationCategory::pz, -1, 4},
+    BaseGateName{"td", GateRotationCategory::pz, -1, 4},
+    // single-qubit X-rotation gates
+    BaseGateName{"px", GateRotationCategory::px},
+    BaseGateName{"rx", GateRotationCategory::rx},
+    BaseGateName{"x", GateRotationCategory::px, 1, 1},
+    BaseGateName{"not", GateRotationCategory::px, 1, 1},
+    BaseGateName{"sx", GateRotationCategory::px, 1, 2},
+    BaseGateName{"x_1_2", GateRotationCategory::px, 1, 2},
+    BaseGateName{"sx*", GateRotationCategory::px, -1, 2},
+    BaseGateName{"sxdg", GateRotationCategory::px, -1, 2},
+    BaseGateName{"sxd", GateRotationCategory::px, -1, 2},
+    // single-qubit Y-rotation gates
+    BaseGateName{"py", GateRotationCategory::py},
+    BaseGateName{"ry", GateRotationCategory::ry},
+    BaseGateName{"y", GateRotationCategory::py, 1, 1},
+    BaseGateName{"sy", GateRotationCategory::py, 1, 2},
+    BaseGateName{"y_1_2", GateRotationCategory::py, 1, 2},
+    BaseGateName{"sy*", GateRotationCategory::py, -1, 2},
+    BaseGateName{"sydg", GateRotationCategory::py, -1, 2},
+    BaseGateName{"syd", GateRotationCategory::py, -1, 2},
+};
+
+constexpr size_t base_gate_table_size = 128;
+
+// gate names are ASCII; unlike std::tolower, this is usable in constant expressions
+constexpr char ascii_tolower(char ch) {
+    return (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch;
+}
+
+/**
+ * @brief Check if `str` equals the lowercase string `lower`, ignoring the case of `str`
+ *
+ */
+constexpr bool equals_ignoring_case(std::string_view str, std::string_view lower) {
+    return str.size() == lower.size() && std::ranges::equal(str, lower, {}, ascii_tolower);
+}
+
+constexpr bool starts_with_ignoring_case(std::string_view str, std::string_view lower) {
+    return str.size() >= lower.size() && equals_ignoring_case(str.substr(0, lower.size()), lower);
+}
+
+// hashes the lowercase form of `str` so that the lookup is case-insensitive
+constexpr size_t hash_gate_name(std::string_view str, uint64_t seed) {
+    uint64_t h = 0xcbf29ce484222325 ^ seed;
+    for (auto const ch : str) {
+        h = (h ^ static_cast<unsigned char>(ascii_tolower(ch))) * 0x100000001b3;
+    }
+    // FNV-1a alone barely mixes the seed into the top bits; finalize as in MurmurHash3
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccd;
+    h ^= h >> 33;
+    return static_cast<size_t>(h >> 57);  // the top 7 bits index the table
+}
+
+static_assert(base_gate_table_size == size_t{1} << 7);
+
+constexpr bool is_perfect_seed(uint64_t seed) {
+    std::array<bool, base_gate_table_size> used{};
+    for (auto const& entry : base_gate_names) {
+        auto const slot = hash_gate_name(entry.name, seed);
+        if (used[slot]) return false;
+        used[slot] = true;
+    }
+    return true;
+}
+
+constexpr uint64_t find_perfect_seed() {
+    uint64_t seed = 0;
+    while (!is_perfect_seed(seed)) ++seed;
+    return seed;
+}
+
+constexpr uint64_t base_gate_seed = find_perfect_seed();
+
+// maps each slot to an index of `base_gate_names`, or -1 if empty
+constexpr std::array<int, base_gate_table_size> build_base_gate_table() {
+    std::array<int, base_gate_table_size> table{};
+    table.fill(-1);
+    for (size_t i = 0; i < base_gate_names.size(); ++i) {
+        table[hash_gate_name(base_gate_names[i].name, base_gate_seed)] = static_cast<int>(i);
+    }
+    return table;
+}
+
+constexpr auto base_gate_table = build_base_gate_table();
+
+/**
+ * @brief Look up a gate name without the control prefix in a perfect hash table. The lookup ignores case.
+ *
+ */
+BaseGateName const* find_base_gate_name(std::string_view str) {
+    auto const idx = base_gate_table[hash_gate_name(str, base_gate_seed)];
+    if (idx < 0 || !equals_ignoring_case(str, base_gate_names[static_cast<size_t>(idx)].name)) return nullptr;
+    return &base_gate_names[static_cast<size_t>(idx)];
+}
+
+}  // namespace
+
+/**
+ * @brief Parse a gate type from its name. The name is case-insensitive.
+ *
+ */
 std::optional<GateType> str_to_gate_type(std::string_view str) {
     // Misc
-    if (str == "id")
+    if (equals_ignoring_case(str, "id"))
         return GateType{GateRotationCategory::id, 1, dvlab::Phase(0)};
-    if (str == "h")
+    if (equals_ignoring_case(str, "h"))
         return GateType{GateRotationCategory::h, 1, dvlab::Phase(1)};
-    if (str == "swap")
+    if (equals_ignoring_case(str, "swap"))
         return GateType{GateRotationCategory::swap, 2, dvlab::Phase(1)};
 
     std::optional<size_t> num_qubits = 1;
-    if (str.starts_with("mc")) {
+    if (starts_with_ignoring_case(str, "mc")) {
         num_qubits = std::nullopt;
         str.remove_prefix(2);
     } else {
-        while (str.starts_with("c")) {
+        while (starts_with_ignoring_case(str, "c")) {
             (*num_qubits)++;
             str.remove_prefix(1);
         }
     }
-    // single-qubit Z-rotation gates
-    if (str == "pz" || str == "p")
-        return GateType{GateRotationCategory::pz, num_qubits, std::nullopt};
-    if (str == "rz")
-        return GateType{GateRotationCategory::rz, num_qubits, std::nullopt};
-    if (str == "z")
-        return GateType{GateRotationCategory::pz, num_qubits, dvlab::Phase(1)};
-    if (str == "s")
-        return GateType{GateRotationCategory::pz, num_qubits, dvlab::Phase(1, 2)};
-    if (str == "s*" || str == "sdg" || str == "sd")
-        return GateType{GateRotationCategory::pz, num_qubits, dvlab::Phase(-1, 2)};
-    if (str == "t")
-        return GateType{GateRotationCategory::pz, num_qubits, dvlab::Phase(1, 4)};
-    if (str == "t*" || str == "tdg" || str == "td")
-        return GateType{GateRotationCategory::pz, num_qubits, dvlab::Phase(-1, 4)};
-
-    // single-qubit X-rotation gates
-    if (str == "px")
-        return GateType{GateRotationCategory::px, num_qubits, std::nullopt};
 
-    if (str == "rx")
-        return GateType{GateRotationCategory::rx, num_qubits, std::nullopt};
+    auto const base = find_base_gate_name(str);
+    if (base == nullptr) return std::nullopt;
 
-    if (str == "x" || str == "not")
-        return GateType{GateRotationCategory::px, num_qubits, dvlab::Phase(1)};
-
-    if (str == "sx" || str == "x_1_2")
-        return GateType{GateRotationCategory::px, num_qubits, dvlab::Phase(1, 2)};
-
-    if (str == "sx*" || str == "sxdg" || str == "sxd")
-        return GateType{GateRotationCategory::px, num_qubits, dvlab::Phase(-1, 2)};
-
-    // single-qubit Y-rotation gates
-    if (str == "py")
-        return GateType{GateRotationCategory::py, num_qubits, std::nullopt};
-    if (str == "ry")
-        return GateType{GateRotationCategory::ry, num_qubits, std::nullopt};
-    if (str == "y")
-        return GateType{GateRotationCategory::py, num_qubits, dvlab::Phase(1)};
-    if (str == "sy" || str == "y_1_2")
-        return GateType{GateRotationCategory::py, num_qubits, dvlab::Phase(1, 2)};
-    if (str == "sy*" || str == "sydg" || str == "syd")
-        return GateType{GateRotationCategory::py, num_qubits, dvlab::Phase(-1, 2)};
-
-    return std::nullopt;
+    return GateType{
+        base->category,
+        num_qubits,
+        base->phase_den == 0 ? std::nullopt : std::make_optional(dvlab::Phase(base->phase_num, base->phase_den))};
 }
 std::string gate_type_to_str(GateRotationCategory category, std::optional<size_t> num_qubits, std::optional<dvlab::Phase> phase) {
     DVLAB_ASSERT(num_qubits > 0, "a gate should have at least one qubit");
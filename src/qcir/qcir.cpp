@@ -13,6 +13,7 @@
 #include <cassert>
 #include <cstdlib>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "./qcir_gate.hpp"
@@ -41,6 +42,11 @@ QCir::QCir(QCir const &other) {
 
         new_gate->set_id(gate->get_id());
     }
+    // the ids were reassigned after insertion, so the index has to be rebuilt
+    _id_to_gates.clear();
+    for (auto *gate : _qgates) {
+        _id_to_gates.emplace(gate->get_id(), gate);
+    }
     if (other._qgates.size() > 0) {
         this->_set_next_gate_id(1 + std::ranges::max(
                                         other._qgates | views::transform(
@@ -67,11 +73,8 @@ QCir::QCir(QCir const &other) {
  * @return QCirGate*
  */
 QCirGate *QCir::get_gate(size_t id) const {
-    for (size_t i = 0; i < _qgates.size(); i++) {
-        if (_qgates[i]->get_id() == id)
-            return _qgates[i];
-    }
-    return nullptr;
+    auto const it = _id_to_gates.find(id);
+    return it == _id_to_gates.end() ? nullptr : it->second;
 }
 
 /**
@@ -81,6 +84,9 @@ QCirGate *QCir::get_gate(size_t id) const {
  * @return QCirQubit
  */
 QCirQubit *QCir::get_qubit(QubitIdType id) const {
+    // qubits are usually numbered by their position, e.g., right after being read from a file
+    if (id >= 0 && static_cast<size_t>(id) < _qubits.size() && _qubits[static_cast<size_t>(id)]->get_id() == id)
+        return _qubits[static_cast<size_t>(id)];
     for (size_t i = 0; i < _qubits.size(); i++) {
         if (_qubits[i]->get_id() == id)
             return _qubits[i];
@@ -192,16 +198,15 @@ QCirGate *QCir::add_single_rz(QubitIdType bit, dvlab::Phase phase, bool append)
  *
  * @return QCirGate*
  */
-QCirGate *QCir::add_gate(std::string type, QubitIdList bits, dvlab::Phase phase, bool append) {
-    type           = dvlab::str::tolower_string(type);
-    auto gate_type = str_to_gate_type(type);
+QCirGate *QCir::add_gate(std::string_view type_str, QubitIdList bits, dvlab::Phase phase, bool append) {
+    auto gate_type = str_to_gate_type(type_str);
     if (!gate_type.has_value()) {
-        spdlog::error("Gate type {} is not supported!!", type);
+        spdlog::error("Gate type {} is not supported!!", type_str);
         return nullptr;
     }
     auto const &[category, num_qubits, gate_phase] = gate_type.value();
     if (num_qubits.has_value() && num_qubits.value() != bits.size()) {
-        spdlog::error("Gate {} requires {} qubits, but {} qubits are given.", type, num_qubits.value(), bits.size());
+        spdlog::error("Gate {} requires {} qubits, but {} qubits are given.", type_str, num_qubits.value(), bits.size());
         return nullptr;
     }
     if (gate_phase.has_value()) {
@@ -242,6 +247,7 @@ QCirGate *QCir::add_gate(std::string type, QubitIdList bits, dvlab::Phase phase,
         _dirty = true;
     }
     _qgates.emplace_back(temp);
+    _id_to_gates.emplace(temp->get_id(), temp);
     _gate_id++;
     return temp;
 }
@@ -273,11 +279,70 @@ bool QCir::remove_gate(size_t id) {
             info[i]._next = nullptr;
         }
         std::erase(_qgates, target);
+        _id_to_gates.erase(id);
         _dirty = true;
         return true;
     }
 }
 
+/**
+ * @brief Remove gates in bulk. The neighbors of each run of consecutive removed
+ *        gates on a qubit are relinked once, and the gate list is compacted in a
+ *        single pass. Nothing is removed if any of the ids is not found.
+ *
+ * @param ids
+ * @return true if all gates are removed
+ * @return false if some gate id is not found
+ */
+bool QCir::remove_gates(std::span<size_t const> ids) {
+    std::unordered_set<QCirGate *> targets;
+    targets.reserve(ids.size());
+    for (auto const id : ids) {
+        auto target = get_gate(id);
+        if (target == nullptr) {
+            spdlog::error("Gate ID {} does not exist!!", id);
+            return false;
+        }
+        targets.insert(target);
+    }
+
+    auto const is_removed = [&targets](QCirGate *g) { return g != nullptr && targets.contains(g); };
+
+    for (auto *target : targets) {
+        for (auto const &info : target->get_qubits()) {
+            // only the first gate of a run of removed gates relinks the run
+            if (is_removed(info._prev)) continue;
+            auto next = info._next;
+            while (is_removed(next)) {
+                next = next->get_qubit(info._qubit)._next;
+            }
+            if (info._prev != nullptr)
+                info._prev->set_child(info._qubit, next);
+            else
+                get_qubit(info._qubit)->set_first(next);
+            if (next != nullptr)
+                next->set_parent(info._qubit, info._prev);
+            else
+                get_qubit(info._qubit)->set_last(info._prev);
+        }
+    }
+
+    // detach the removed gates only after all runs are relinked, since the walks above follow their links
+    for (auto *target : targets) {
+        for (auto const &info : target->get_qubits()) {
+            target->set_parent(info._qubit, nullptr);
+            target->set_child(info._qubit, nullptr);
+        }
+    }
+
+    std::erase_if(_qgates, [&targets](QCirGate *g) { return targets.contains(g); });
+    for (auto const id : ids) {
+        _id_to_gates.erase(id);
+    }
+    _dirty = true;
+    return true;
+}
+
 /**
  * @brief Analysis the quantum circuit and estimate the Clifford and T count
  *
@@ -314,10 +379,17 @@ QCirGateStatistics QCir::get_gate_statistics() const {
     for (auto &g : _qgates) {
         auto type = g->get_rotation_category();
         switch (type) {
+            case GateRotationCategory::id:
+                break;
             case GateRotationCategory::h:
                 stat.h++;
                 stat.clifford++;
                 break;
+            case GateRotationCategory::swap:
+                // three CXs
+                stat.clifford += 3;
+                stat.twoqubit += 3;
+                break;
             case GateRotationCategory::pz:
             case GateRotationCategory::rz:
                 if (get_num_qubits() == 1) {
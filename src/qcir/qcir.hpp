@@ -12,6 +12,7 @@
 #include <ranges>
 #include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -104,6 +105,7 @@ public:
         std::swap(_filename, other._filename);
         std::swap(_procedures, other._procedures);
         std::swap(_qgates, other._qgates);
+        std::swap(_id_to_gates, other._id_to_gates);
         std::swap(_qubits, other._qubits);
         std::swap(_topological_order, other._topological_order);
     }
@@ -137,9 +139,10 @@ public:
     QCirQubit* insert_qubit(QubitIdType id);
     void add_qubits(size_t num);
     bool remove_qubit(QubitIdType qid);
-    QCirGate* add_gate(std::string type, QubitIdList bits, dvlab::Phase phase, bool append);
+    QCirGate* add_gate(std::string_view type, QubitIdList bits, dvlab::Phase phase, bool append);
     QCirGate* add_single_rz(QubitIdType bit, dvlab::Phase phase, bool append);
     bool remove_gate(size_t id);
+    bool remove_gates(std::span<size_t const> ids);
 
     bool read_qcir_file(std::filesystem::path const& filepath);
     bool read_qc(std::filesystem::path const& filepath);
@@ -197,6 +200,7 @@ private:
     std::vector<std::string> _procedures;
 
     std::vector<QCirGate*> _qgates;
+    std::unordered_map<size_t, QCirGate*> _id_to_gates;
     std::vector<QCirQubit*> _qubits;
     std::vector<QCirGate*> mutable _topological_order;
 };
@@ -154,6 +154,7 @@ void QCir::update_gate_time() const {
  */
 void QCir::reset() {
     _qgates.clear();
+    _id_to_gates.clear();
     _qubits.clear();
     _topological_order.clear();
 
@@ -17,6 +17,7 @@
 
 #include "./optimizer/optimizer_cmd.hpp"
 #include "./qcir_gate.hpp"
+#include "./simulator/simulator_cmd.hpp"
 #include "argparse/arg_parser.hpp"
 #include "argparse/arg_type.hpp"
 #include "cli/cli.hpp"
@@ -501,15 +502,17 @@ dvlab::Command qcir_gate_add_cmd(QCirMgr& qcir_mgr) {
 dvlab::Command qcir_gate_delete_cmd(QCirMgr& qcir_mgr) {
     return {"remove",
             [&](ArgumentParser& parser) {
-                parser.description("remove gate");
+                parser.description("remove gates");
 
-                parser.add_argument<size_t>("id")
-                    .constraint(valid_qcir_gate_id(qcir_mgr))
-                    .help("the id to be removed");
+                // NOTE - the ids are checked by QCir::remove_gates, which removes nothing if any of them is unknown
+                parser.add_argument<size_t>("ids")
+                    .nargs(NArgsOption::one_or_more)
+                    .help("the ids to be removed");
             },
             [&](ArgumentParser const& parser) {
                 if (!qcir_mgr_not_empty(qcir_mgr)) return CmdExecResult::error;
-                qcir_mgr.get()->remove_gate(parser.get<size_t>("id"));
+                auto const ids = parser.get<std::vector<size_t>>("ids");
+                if (!qcir_mgr.get()->remove_gates(ids)) return CmdExecResult::error;
                 return CmdExecResult::done;
             }};
 }
@@ -606,6 +609,7 @@ Command qcir_cmd(QCirMgr& qcir_mgr) {
     cmd.add_subcommand(qcir_gate_cmd(qcir_mgr));
     cmd.add_subcommand(qcir_qubit_cmd(qcir_mgr));
     cmd.add_subcommand(qcir_optimize_cmd(qcir_mgr));
+    cmd.add_subcommand(qcir_simulate_cmd(qcir_mgr));
     return cmd;
 }
 
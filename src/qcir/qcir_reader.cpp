@@ -8,16 +8,72 @@
 #include <fmt/std.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <fstream>
+#include <gsl/narrow>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 #include "qcir/qcir.hpp"
 #include "util/dvlab_string.hpp"
+#include "util/mapped_file.hpp"
 #include "util/phase.hpp"
 
 namespace qsyn::qcir {
 
+namespace {
+
+struct heterogeneous_string_hash {
+    using is_transparent = void;
+    [[nodiscard]] size_t operator()(std::string_view str) const noexcept { return std::hash<std::string_view>{}(str); }
+    [[nodiscard]] size_t operator()(std::string const& str) const noexcept { return std::hash<std::string>{}(str); }
+};
+
+constexpr std::string_view whitespaces = " \t\n\v\f\r";
+
+std::string_view trim_view(std::string_view str) {
+    auto const start = str.find_first_not_of(whitespaces);
+    if (start == std::string_view::npos) return {};
+    auto const end = str.find_last_not_of(whitespaces);
+    return str.substr(start, end + 1 - start);
+}
+
+/**
+ * @brief Pop the next token delimited by any of `delims` from the front of `str`.
+ *        Leading delimiters are skipped; an empty view is returned if no token is left.
+ *
+ */
+std::string_view pop_token(std::string_view& str, std::string_view delims = whitespaces) {
+    auto const start = str.find_first_not_of(delims);
+    if (start == std::string_view::npos) {
+        str = {};
+        return {};
+    }
+    str.remove_prefix(start);
+    auto const end   = std::min(str.find_first_of(delims), str.size());
+    auto const token = str.substr(0, end);
+    str.remove_prefix(end);
+    return token;
+}
+
+/**
+ * @brief Extract the text between the first `left` and the next `right` after it.
+ *
+ */
+std::optional<std::string_view> between(std::string_view str, char left, char right) {
+    auto const start = str.find(left);
+    if (start == std::string_view::npos) return std::nullopt;
+    auto const end = str.find(right, start + 1);
+    if (end == std::string_view::npos) return std::nullopt;
+    return str.substr(start + 1, end - start - 1);
+}
+
+}  // namespace
+
 /**
  * @brief Read QCir file
  *
@@ -61,67 +117,88 @@ bool QCir::read_qcir_file(std::filesystem::path const& filepath) {
 }
 
 /**
- * @brief Read QASM
+ * @brief Read QASM. The file is memory-mapped and tokenized in place, so that
+ *        only the gates themselves are allocated.
  *
  * @param filename
  * @return true if successfully read
  * @return false if error in file or not found
  */
 bool QCir::read_qasm(std::filesystem::path const& filepath) {
-    using dvlab::str::str_get_token;
     // read file and open
     _procedures.clear();
-    std::fstream qasm_file{filepath};
+    dvlab::utils::MappedFile const qasm_file{filepath};
     if (!qasm_file.is_open()) {
         spdlog::error("Cannot open the QASM file \"{}\"!!", filepath);
         return false;
     }
-    std::string str;
-    for (int i = 0; i < 6; i++) {
+
+    dvlab::utils::LineCursor lines{qasm_file.view()};
+    _qgates.reserve(_qgates.size() + lines.count_remaining_lines());
+
+    std::optional<size_t> n_qubits;
+    QubitIdList qubit_ids;
+    while (auto const raw_line = lines.next_line()) {
+        auto const line = trim_view(dvlab::str::trim_comments(*raw_line));
+        if (line.empty()) continue;
+
+        auto const type_end = std::min(line.find_first_of(" \t("), line.size());
+        auto const type     = line.substr(0, type_end);
         // OPENQASM 2.0;
         // include "qelib1.inc";
+        if (type == "OPENQASM" || type == "include" || type == "creg") continue;
         // qreg q[int];
-        qasm_file >> str;
-    }
-
-    auto const nqubit = stoul(str.substr(str.find('[') + 1, str.size() - str.find('[') - 3));
-    add_qubits(nqubit);
-    getline(qasm_file, str);
-    while (getline(qasm_file, str)) {
-        str = dvlab::str::trim_spaces(dvlab::str::trim_comments(str));
-        if (str == "") continue;
-        std::string type;
-        auto const type_end   = str_get_token(str, type);
-        std::string phase_str = "0";
-        if (str_get_token(str, phase_str, 0, '(') != std::string::npos) {
-            auto const stop = str_get_token(str, type, 0, '(');
-            str_get_token(str, phase_str, stop + 1, ')');
-        } else
-            phase_str = "0";
-        if (type == "creg" || type == "qreg" || type == "") {
+        if (type == "qreg") {
+            auto const size_str = between(line, '[', ']');
+            auto const size     = size_str ? dvlab::str::from_string<size_t>(*size_str) : std::nullopt;
+            if (!size.has_value()) {
+                spdlog::error("invalid qreg declaration on line {}: {}", lines.line_number(), line);
+                return false;
+            }
+            if (n_qubits.has_value()) {
+                spdlog::error("multiple qreg declarations are not supported (line {})!!", lines.line_number());
+                return false;
+            }
+            n_qubits = size;
+            add_qubits(*size);
             continue;
         }
-        QubitIdList qubit_ids;
-        std::string token;
-        std::string qubit_id_str;
-        size_t n = str_get_token(str, token, type_end, ',');
-        while (token.size()) {
-            str_get_token(token, qubit_id_str, str_get_token(token, qubit_id_str, 0, '[') + 1, ']');
-            auto qubit_id_num = dvlab::str::from_string<unsigned>(qubit_id_str);
-            if (!qubit_id_num.has_value() || qubit_id_num >= nqubit) {
-                spdlog::error("invalid qubit id on line {}!!", str);
+        if (!n_qubits.has_value()) {
+            spdlog::error("gate on line {} appears before the qreg declaration!!", lines.line_number());
+            return false;
+        }
+
+        // NOTE - the phase may be separated from the gate name by whitespace, e.g., `rz (pi/2) q[0];`
+        auto args  = trim_view(line.substr(type_end));
+        auto phase = dvlab::Phase(0);
+        if (args.starts_with('(')) {
+            auto const phase_end = args.find(')');
+            if (phase_end == std::string_view::npos) {
+                spdlog::error("invalid phase on line {}: {}", lines.line_number(), line);
                 return false;
             }
-            qubit_ids.emplace_back(qubit_id_num.value());
-            n = str_get_token(str, token, n, ',');
+            auto const parsed = dvlab::Phase::from_string(std::string{args.substr(1, phase_end - 1)});
+            if (!parsed.has_value()) {
+                spdlog::error("invalid phase on line {}: {}", lines.line_number(), line);
+                return false;
+            }
+            phase = parsed.value();
+            args.remove_prefix(phase_end + 1);
         }
 
-        auto phase = dvlab::Phase::from_string(phase_str);
-        if (!phase.has_value()) {
-            spdlog::error("invalid phase on line {}!!", str);
-            return false;
+        qubit_ids.clear();
+        for (auto token = pop_token(args, ",;"); !token.empty(); token = pop_token(args, ",;")) {
+            if (trim_view(token).empty()) continue;
+            auto const qubit_id_str = between(token, '[', ']');
+            auto const qubit_id_num = qubit_id_str ? dvlab::str::from_string<unsigned>(*qubit_id_str) : std::nullopt;
+            if (!qubit_id_num.has_value() || qubit_id_num >= *n_qubits) {
+                spdlog::error("invalid qubit id on line {}: {}", lines.line_number(), line);
+                return false;
+            }
+            qubit_ids.emplace_back(qubit_id_num.value());
         }
-        add_gate(type, qubit_ids, phase.value(), true);
+
+        add_gate(type, qubit_ids, phase, true);
     }
     update_gate_time();
     return true;
@@ -135,58 +212,48 @@ bool QCir::read_qasm(std::filesystem::path const& filepath) {
  * @return false if error in file or not found
  */
 bool QCir::read_qc(std::filesystem::path const& filepath) {
-    using dvlab::str::str_get_token;
     // read file and open
-    std::fstream qc_file{filepath};
+    dvlab::utils::MappedFile const qc_file{filepath};
     if (!qc_file.is_open()) {
         spdlog::error("Cannot open the QC file \"{}\"!!", filepath);
         return false;
     }
 
-    // ex: qubit_labels = {A,B,C,1,2,3,result}
-    //     qubit_id = distance(qubit_labels.begin(), find(qubit_labels.begin(), qubit_labels.end(), token));
-    std::vector<std::string> qubit_labels;
-    qubit_labels.clear();
-    std::string line;
-    size_t n_qubit = 0;
+    dvlab::utils::LineCursor lines{qc_file.view()};
+    _qgates.reserve(_qgates.size() + lines.count_remaining_lines());
 
-    while (getline(qc_file, line)) {
-        line = line[line.size() - 1] == '\r' ? line.substr(0, line.size() - 1) : line;
+    // ex: qubit_labels = {A: 0, B: 1, C: 2, 1: 3, 2: 4, 3: 5, result: 6}
+    std::unordered_map<std::string, QubitIdType, heterogeneous_string_hash, std::equal_to<>> qubit_labels;
+    QubitIdList qubit_ids;
 
-        if (line.find('.') == 0)  // find initial statement
-        {
+    while (auto const raw_line = lines.next_line()) {
+        auto line = *raw_line;
+
+        if (line.starts_with('.')) {  // find initial statement
             // erase .v .i or .o
-            line.erase(0, line.find(' ') + 1);
-            size_t pos = 0;
-            while (pos != std::string::npos) {
-                std::string token;
-
-                pos = str_get_token(line, token, pos);
-                if (!count(qubit_labels.begin(), qubit_labels.end(), token)) {
-                    qubit_labels.emplace_back(token);
-                    n_qubit++;
+            pop_token(line);
+            for (auto token = pop_token(line); !token.empty(); token = pop_token(line)) {
+                if (!qubit_labels.contains(token)) {
+                    qubit_labels.emplace(token, gsl::narrow<QubitIdType>(qubit_labels.size()));
                 }
             }
-        } else if (line.find('#') == 0 || line == "")
+        } else if (line.starts_with('#') || line.empty())
             continue;
-        else if (line.find("BEGIN") == 0) {
-            add_qubits(n_qubit);
-        } else if (line.find("END") == 0) {
+        else if (line.starts_with("BEGIN")) {
+            add_qubits(qubit_labels.size());
+        } else if (line.starts_with("END")) {
             return true;
         } else  // find a gate
         {
-            std::string type, qubit_label;
-            QubitIdList qubit_ids;
-            size_t pos = str_get_token(line, type, 0);
-            while (pos != std::string::npos) {
-                pos = str_get_token(line, qubit_label, pos);
-                if (count(qubit_labels.begin(), qubit_labels.end(), qubit_label)) {
-                    auto const qubit_id = distance(qubit_labels.begin(), find(qubit_labels.begin(), qubit_labels.end(), qubit_label));
-                    qubit_ids.emplace_back(qubit_id);
-                } else {
-                    spdlog::error("encountered a undefined qubit ({})!!", qubit_label);
+            auto const type = pop_token(line);
+            qubit_ids.clear();
+            for (auto qubit_label = pop_token(line); !qubit_label.empty(); qubit_label = pop_token(line)) {
+                auto const it = qubit_labels.find(qubit_label);
+                if (it == qubit_labels.end()) {
+                    spdlog::error("encountered a undefined qubit ({}) on line {}!!", qubit_label, lines.line_number());
                     return false;
                 }
+                qubit_ids.emplace_back(it->second);
             }
             if (type == "Tof" || type == "tof") {
                 if (qubit_ids.size() == 1)
@@ -215,57 +282,70 @@ bool QCir::read_qc(std::filesystem::path const& filepath) {
  */
 bool QCir::read_qsim(std::filesystem::path const& filepath) {
     // read file and open
-    std::ifstream qsim_file{filepath};
+    dvlab::utils::MappedFile const qsim_file{filepath};
     if (!qsim_file.is_open()) {
         spdlog::error("Cannot open the QSIM file \"{}\"!!", filepath);
         return false;
     }
 
-    std::string line;
-    static std::vector<std::string> const single_gate_list{"x", "y", "z", "h", "t", "x_1_2", "y_1_2", "rx", "rz", "s"};
+    dvlab::utils::LineCursor lines{qsim_file.view()};
+    _qgates.reserve(_qgates.size() + lines.count_remaining_lines());
+
+    constexpr std::array<std::string_view, 10> single_gate_list{"x", "y", "z", "h", "t", "x_1_2", "y_1_2", "rx", "rz", "s"};
     // decide qubit number
-    int n_qubit = 0;
-    getline(qsim_file, line);
-    n_qubit = stoi(line);
-    add_qubits(n_qubit);
+    auto const n_qubits = dvlab::str::from_string<size_t>(trim_view(lines.next_line().value_or("")));
+    if (!n_qubits.has_value()) {
+        spdlog::error("invalid qubit number on line {}!!", lines.line_number());
+        return false;
+    }
+    add_qubits(*n_qubits);
+
+    auto const parse_qubit = [&lines, &n_qubits](std::string_view str) -> std::optional<QubitIdType> {
+        auto const qubit = dvlab::str::from_string<QubitIdType>(str);
+        if (!qubit.has_value() || *qubit < 0 || static_cast<size_t>(*qubit) >= *n_qubits) {
+            spdlog::error("invalid qubit id on line {}: {}", lines.line_number(), str);
+            return std::nullopt;
+        }
+        return qubit;
+    };
 
     // add the gate
     // Todo: implentment hz_1_2 gate and fs gate
-
-    while (getline(qsim_file, line)) {
-        using dvlab::str::str_get_token;
-        if (line == "") continue;
-        std::string time, type, phase_str, qubit_id;
-        QubitIdList qubit_ids;
-        size_t pos = 0;
-        pos        = str_get_token(line, time, pos);
-        pos        = str_get_token(line, type, pos);
+    QubitIdList qubit_ids;
+    while (auto const raw_line = lines.next_line()) {
+        auto line = *raw_line;
+        if (trim_view(line).empty()) continue;
+        pop_token(line);  // time
+        auto const type = pop_token(line);
+        qubit_ids.clear();
         if (type == "cx" || type == "cz") {
             // add 2 qubit gate
-            pos = str_get_token(line, qubit_id, pos);
-            qubit_ids.emplace_back(stoul(qubit_id));
-            str_get_token(line, qubit_id, pos);
-            qubit_ids.emplace_back(stoul(qubit_id));
+            for (size_t i = 0; i < 2; ++i) {
+                auto const qubit = parse_qubit(pop_token(line));
+                if (!qubit.has_value()) return false;
+                qubit_ids.emplace_back(*qubit);
+            }
             add_gate(type, qubit_ids, dvlab::Phase(1), true);
         } else if (type == "rx" || type == "rz") {
             // add phase gate
-            pos = str_get_token(line, qubit_id, pos);
-            qubit_ids.emplace_back(stoul(qubit_id));
-            str_get_token(line, phase_str, pos);
-            auto phase = dvlab::Phase::from_string(phase_str);
+            auto const qubit = parse_qubit(pop_token(line));
+            if (!qubit.has_value()) return false;
+            qubit_ids.emplace_back(*qubit);
+            auto const phase = dvlab::Phase::from_string(std::string{pop_token(line)});
             if (!phase.has_value()) {
-                spdlog::error("invalid phase on line {}!!", line);
+                spdlog::error("invalid phase on line {}: {}", lines.line_number(), *raw_line);
                 return false;
             }
             add_gate(type, qubit_ids, phase.value(), true);
-        } else if (count(single_gate_list.begin(), single_gate_list.end(), type)) {
+        } else if (std::ranges::find(single_gate_list, type) != single_gate_list.end()) {
             // add single qubit gate
-            str_get_token(line, qubit_id, pos);
-            qubit_ids.emplace_back(stoul(qubit_id));
+            auto const qubit = parse_qubit(pop_token(line));
+            if (!qubit.has_value()) return false;
+            qubit_ids.emplace_back(*qubit);
             // FIXME - pass in the correct phase
             add_gate(type, qubit_ids, dvlab::Phase(0), true);
         } else {
-            spdlog::error("Gate type {} is not supported!!", type);
+            spdlog::error("Gate type {} on line {} is not supported!!", type, lines.line_number());
             return false;
         }
     }
@@ -281,93 +361,99 @@ bool QCir::read_qsim(std::filesystem::path const& filepath) {
  */
 bool QCir::read_quipper(std::filesystem::path const& filepath) {
     // read file and open
-    std::ifstream quipper_file{filepath};
+    dvlab::utils::MappedFile const quipper_file{filepath};
     if (!quipper_file.is_open()) {
         spdlog::error("Cannot open the QUIPPER file \"{}\"!!", filepath);
         return false;
     }
 
-    std::string line;
-    size_t n_qubit = 0;
-    std::vector<std::string> single_list{"X", "T", "S", "H", "Z", "not"};
+    dvlab::utils::LineCursor lines{quipper_file.view()};
+    _qgates.reserve(_qgates.size() + lines.count_remaining_lines());
+
+    constexpr std::array<std::string_view, 6> single_list{"X", "T", "S", "H", "Z", "not"};
 
     // Count qubit number
-    getline(quipper_file, line);
-    n_qubit = count(line.begin(), line.end(), 'Q');
-    add_qubits(n_qubit);
+    auto const header = lines.next_line().value_or("");
+    add_qubits(gsl::narrow<size_t>(std::ranges::count(header, 'Q')));
+
+    auto const parse_qubit = [&lines](std::string_view str) -> std::optional<QubitIdType> {
+        auto const qubit = dvlab::str::from_string<QubitIdType>(trim_view(str));
+        if (!qubit.has_value()) {
+            spdlog::error("invalid qubit id on line {}: {}", lines.line_number(), str);
+        }
+        return qubit;
+    };
 
-    while (getline(quipper_file, line)) {
-        if (line.find("QGate") == 0) {
+    std::string type;
+    QubitIdList qubit_ids;
+    while (auto const raw_line = lines.next_line()) {
+        auto const line = *raw_line;
+        if (line.starts_with("QGate")) {
             // addgate
-            std::string type    = line.substr(line.find('[') + 2, line.find(']') - line.find('[') - 3);
-            size_t qubit_target = 0;
-            if (find(single_list.begin(), single_list.end(), type) != single_list.end()) {
-                qubit_target = stoul(line.substr(line.find('(') + 1, line.find(')') - line.find('(') - 1));
-                QubitIdList qubit_ids;
-
-                if (line.find("controls=") != std::string::npos) {
-                    // have control
-                    std::string ctrls_info;
-                    ctrls_info = line.substr(line.find_last_of('[') + 1, line.find_last_of(']') - line.find_last_of('[') - 1);
-
-                    if (ctrls_info.find(std::to_string(qubit_target)) != std::string::npos) {
+            auto const type_str = between(line, '[', ']').value_or("");
+            // strip the quotes
+            type.assign(type_str.size() >= 2 ? type_str.substr(1, type_str.size() - 2) : type_str);
+            if (std::ranges::find(single_list, type) == single_list.end()) {
+                spdlog::error("Unsupported gate type {}!!", type);
+                return false;
+            }
+            auto const qubit_target = parse_qubit(between(line, '(', ')').value_or(""));
+            if (!qubit_target.has_value()) return false;
+            qubit_ids.clear();
+
+            if (auto const ctrls_pos = line.find("controls="); ctrls_pos != std::string_view::npos) {
+                // have control
+                auto ctrls_info = between(line.substr(ctrls_pos), '[', ']').value_or("");
+                for (auto ctrl = pop_token(ctrls_info, ", +"); !ctrl.empty(); ctrl = pop_token(ctrls_info, ", +")) {
+                    auto const qubit_control = parse_qubit(ctrl);
+                    if (!qubit_control.has_value()) return false;
+                    if (qubit_control == qubit_target) {
                         spdlog::error("Control qubit and target cannot be the same!!");
                         return false;
                     }
+                    qubit_ids.emplace_back(*qubit_control);
+                }
+                qubit_ids.emplace_back(*qubit_target);
 
-                    if (count(line.begin(), line.end(), '+') == 1) {
-                        // one control
-                        if (type != "not" && type != "X" && type != "Z") {
-                            spdlog::error("Unsupported controlled gate type!! Only `cnot`, `CX` and `CZ` are supported.");
-                            return false;
-                        }
-                        auto const qubit_control = stoul(ctrls_info.substr(1));
-                        qubit_ids.emplace_back(qubit_control);
-                        qubit_ids.emplace_back(qubit_target);
-                        type.insert(0, "C");
-                        add_gate(type, qubit_ids, dvlab::Phase(1), true);
-                    } else if (count(line.begin(), line.end(), '+') == 2) {
-                        // 2 controls
-                        if (type != "not" && type != "X" && type != "Z") {
-                            spdlog::error("Unsupported doubly-controlled gate type!! Only `ccx` and `ccz` are supported.");
-                            return false;
-                        }
-                        size_t qubit_control1 = 0, qubit_control2 = 0;
-                        qubit_control1 = stoul(ctrls_info.substr(1, ctrls_info.find(',') - 1));
-                        qubit_control2 = stoul(ctrls_info.substr(ctrls_info.find(',') + 2));
-                        qubit_ids.emplace_back(qubit_control1);
-                        qubit_ids.emplace_back(qubit_control2);
-                        qubit_ids.emplace_back(qubit_target);
-                        type.insert(0, "CC");
-                        add_gate(type, qubit_ids, dvlab::Phase(1), true);
-                    } else {
-                        spdlog::error("Controlled gates with more than 2 controls are not supported!!");
+                if (qubit_ids.size() == 2) {
+                    // one control
+                    if (type != "not" && type != "X" && type != "Z") {
+                        spdlog::error("Unsupported controlled gate type!! Only `cnot`, `CX` and `CZ` are supported.");
+                        return false;
+                    }
+                    type.insert(0, "C");
+                    add_gate(type, qubit_ids, dvlab::Phase(1), true);
+                } else if (qubit_ids.size() == 3) {
+                    // 2 controls
+                    if (type != "not" && type != "X" && type != "Z") {
+                        spdlog::error("Unsupported doubly-controlled gate type!! Only `ccx` and `ccz` are supported.");
                         return false;
                     }
+                    type.insert(0, "CC");
+                    add_gate(type, qubit_ids, dvlab::Phase(1), true);
                 } else {
-                    // without control
-                    qubit_ids.emplace_back(qubit_target);
-                    // FIXME - pass in the correct phase
-                    add_gate(type, qubit_ids, dvlab::Phase(0), true);
+                    spdlog::error("Controlled gates with more than 2 controls are not supported!!");
+                    return false;
                 }
-
             } else {
-                spdlog::error("Unsupported gate type {}!!", type);
-                return false;
+                // without control
+                qubit_ids.emplace_back(*qubit_target);
+                // FIXME - pass in the correct phase
+                add_gate(type, qubit_ids, dvlab::Phase(0), true);
             }
             continue;
-        } else if (line.find("Outputs") == 0) {
+        } else if (line.starts_with("Outputs")) {
             return true;
-        } else if (line.find("Comment") == 0 || line.find("QTerm0") == 0 || line.find("QMeas") == 0 || line.find("QDiscard") == 0)
+        } else if (line.starts_with("Comment") || line.starts_with("QTerm0") || line.starts_with("QMeas") || line.starts_with("QDiscard"))
             continue;
-        else if (line.find("QInit0") == 0) {
+        else if (line.starts_with("QInit0")) {
             spdlog::error("Unsupported expression: QInit0");
             return false;
-        } else if (line.find("QRot") == 0) {
+        } else if (line.starts_with("QRot")) {
             spdlog::error("Unsupported expression: QRot");
             return false;
         } else {
-            spdlog::error("Unsupported expression: {}", line);
+            spdlog::error("Unsupported expression on line {}: {}", lines.line_number(), line);
         }
     }
     return true;
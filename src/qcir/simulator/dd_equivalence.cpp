@@ -0,0 +1,188 @@
+/****************************************************************************
+  PackageName  [ qcir/simulator ]
+  Synopsis     [ Define decision-diagram-based equivalence checking of QCirs ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include "./dd_equivalence.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <unordered_map>
+#include <vector>
+
+#include "./decision_diagram.hpp"
+#include "./simulator.hpp"
+#include "qcir/gate_type.hpp"
+#include "qcir/qcir.hpp"
+#include "qcir/qcir_gate.hpp"
+#include "qcir/qcir_qubit.hpp"
+
+extern bool stop_requested();
+
+namespace qsyn::qcir {
+
+namespace {
+
+// collect garbage when the number of nodes exceeds this, or twice the live nodes after the last collection
+constexpr size_t initial_gc_threshold = size_t{1} << 16;
+
+/**
+ * @brief A gate on DD qubits: `matrix` acts on `target` if all `controls` are |1>.
+ *
+ */
+struct ControlledMatrix {
+    Matrix2 matrix;
+    size_t target;
+    std::vector<size_t> controls;
+
+    bool operator==(ControlledMatrix const& other) const = default;
+};
+
+Matrix2 adjoint(Matrix2 const& m) {
+    return {std::conj(m[0]), std::conj(m[2]), std::conj(m[1]), std::conj(m[3])};
+}
+
+/**
+ * @brief List the gates of `qcir` in topological order on the qubits sorted by ID.
+ *        SWAP gates become three CX gates, and identity gates are skipped.
+ *
+ */
+std::optional<std::vector<ControlledMatrix>> to_controlled_matrices(QCir const& qcir) {
+    std::vector<QubitIdType> qubit_ids;
+    for (auto const* qubit : qcir.get_qubits()) {
+        qubit_ids.emplace_back(qubit->get_id());
+    }
+    std::ranges::sort(qubit_ids);
+    std::unordered_map<QubitIdType, size_t> positions;
+    for (size_t i = 0; i < qubit_ids.size(); ++i) {
+        positions.emplace(qubit_ids[i], i);
+    }
+
+    std::vector<ControlledMatrix> gates;
+    for (auto const* gate : qcir.update_topological_order()) {
+        auto const& qubits = gate->get_qubits();
+        if (gate->get_rotation_category() == GateRotationCategory::id) continue;
+        if (gate->get_rotation_category() == GateRotationCategory::swap && qubits.size() == 2) {
+            Matrix2 const x = {0., 1., 1., 0.};
+            auto const q0   = positions.at(qubits[0]._qubit);
+            auto const q1   = positions.at(qubits[1]._qubit);
+            gates.emplace_back(x, q1, std::vector{q0});
+            gates.emplace_back(x, q0, std::vector{q1});
+            gates.emplace_back(x, q1, std::vector{q0});
+            continue;
+        }
+
+        auto const matrix = get_target_matrix(*gate);
+        if (!matrix.has_value()) {
+            spdlog::error("Gate {} ({}) is not supported by the decision diagram!!", gate->get_id(), gate->get_type_str());
+            return std::nullopt;
+        }
+        std::vector<size_t> controls;
+        for (size_t i = 0; i + 1 < qubits.size(); ++i) {
+            controls.emplace_back(positions.at(qubits[i]._qubit));
+        }
+        gates.emplace_back(*matrix, positions.at(qubits.back()._qubit), std::move(controls));
+    }
+    return gates;
+}
+
+}  // namespace
+
+/**
+ * @brief Check if two QCirs are equivalent up to a global phase by building U V^dagger as a
+ *        decision diagram and checking if it is the identity. The gates of U are multiplied
+ *        from the left and the adjoints of the gates of V from the right, alternating in
+ *        proportion to their counts so that the intermediate operator stays close to the
+ *        identity when the two QCirs are similar.
+ *
+ *        Gates shared by both QCirs at the beginning or the end are skipped, as
+ *        (S U P)(S V P)^dagger = S (U V^dagger) S^dagger is the identity iff U V^dagger is.
+ *
+ * @param lhs
+ * @param rhs
+ * @param config the time and memory budget
+ * @return the result, which is unknown if the budget is exhausted or the check is interrupted;
+ *         std::nullopt if a gate is not supported
+ */
+std::optional<DDEquivalenceReport> check_equivalence_by_dd(QCir const& lhs, QCir const& rhs, DDEquivalenceConfig const& config) {
+    if (lhs.get_num_qubits() != rhs.get_num_qubits()) {
+        spdlog::error("The two QCirs should have the same number of qubits!!");
+        return std::nullopt;
+    }
+
+    auto const lhs_gates = to_controlled_matrices(lhs);
+    auto const rhs_gates = to_controlled_matrices(rhs);
+    if (!lhs_gates.has_value() || !rhs_gates.has_value()) return std::nullopt;
+
+    auto const [lhs_mismatch, rhs_mismatch] = std::ranges::mismatch(*lhs_gates, *rhs_gates);
+    auto const prefix                       = static_cast<size_t>(lhs_mismatch - lhs_gates->begin());
+    auto const [lhs_rmismatch, rhs_rmismatch] =
+        std::ranges::mismatch(lhs_gates->rbegin(), lhs_gates->rend() - static_cast<std::ptrdiff_t>(prefix),
+                              rhs_gates->rbegin(), rhs_gates->rend() - static_cast<std::ptrdiff_t>(prefix));
+    auto const suffix = static_cast<size_t>(lhs_rmismatch - lhs_gates->rbegin());
+    auto const n_lhs  = lhs_gates->size() - prefix - suffix;
+    auto const n_rhs  = rhs_gates->size() - prefix - suffix;
+    spdlog::info("Skipped {} common gates at the beginning and {} at the end", prefix, suffix);
+
+    auto const start_time = std::chrono::steady_clock::now();
+    auto const timed_out  = [&]() {
+        return config.timeout > 0. &&
+               std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count() > config.timeout;
+    };
+
+    DecisionDiagram dd{lhs.get_num_qubits()};
+    DDEquivalenceReport report;
+    auto product      = dd.identity();
+    auto gc_threshold = initial_gc_threshold;
+
+    // apply the i-th gate of U when i / n_lhs <= j / n_rhs, where j gates of V have been applied
+    for (size_t i = 0, j = 0; i < n_lhs || j < n_rhs;) {
+        if (stop_requested()) {
+            spdlog::warn("Equivalence checking interrupted.");
+            return report;
+        }
+        if (timed_out()) {
+            spdlog::warn("Exceeded the time limit of {} seconds.", config.timeout);
+            return report;
+        }
+
+        if (j == n_rhs || (i < n_lhs && i * n_rhs <= j * n_lhs)) {
+            auto const& [matrix, target, controls] = (*lhs_gates)[prefix + i++];
+            product                                = dd.multiply(dd.make_gate(matrix, target, controls), product);
+        } else {
+            auto const& [matrix, target, controls] = (*rhs_gates)[prefix + j++];
+            product                                = dd.multiply(product, dd.make_gate(adjoint(matrix), target, controls));
+        }
+
+        report.peak_num_nodes = std::max(report.peak_num_nodes, dd.get_num_nodes());
+        if (dd.get_num_nodes() > gc_threshold) {
+            dd.collect_garbage({&product, 1});
+            gc_threshold = std::max(gc_threshold, 2 * dd.get_num_nodes());
+            spdlog::debug("Collected garbage; {} nodes left", dd.get_num_nodes());
+        }
+        if (config.max_num_nodes > 0 && dd.get_num_nodes() > config.max_num_nodes) {
+            // the limit may be exceeded by garbage only
+            dd.collect_garbage({&product, 1});
+            if (dd.get_num_nodes() > config.max_num_nodes) {
+                spdlog::warn("Exceeded the limit of {} decision diagram nodes.", config.max_num_nodes);
+                return report;
+            }
+        }
+    }
+
+    if (dd.is_identity(product)) {
+        report.result       = DDEquivalenceResult::equivalent;
+        // U V^dagger = c I means V = c^* U
+        report.global_phase = dvlab::Phase(-std::arg(product.weight));
+    } else {
+        report.result = DDEquivalenceResult::not_equivalent;
+    }
+    return report;
+}
+
+}  // namespace qsyn::qcir
@@ -0,0 +1,38 @@
+/****************************************************************************
+  PackageName  [ qcir/simulator ]
+  Synopsis     [ Define decision-diagram-based equivalence checking of QCirs ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+#include "util/phase.hpp"
+
+namespace qsyn::qcir {
+
+class QCir;
+
+struct DDEquivalenceConfig {
+    double timeout       = 0.;  // in seconds; 0 for no limit
+    size_t max_num_nodes = 0;   // 0 for no limit
+};
+
+enum class DDEquivalenceResult {
+    equivalent,
+    not_equivalent,
+    unknown  // the time or memory budget is exhausted
+};
+
+struct DDEquivalenceReport {
+    DDEquivalenceResult result = DDEquivalenceResult::unknown;
+    dvlab::Phase global_phase;  // rhs = e^(i * global_phase) lhs if equivalent
+    size_t peak_num_nodes = 0;
+};
+
+std::optional<DDEquivalenceReport> check_equivalence_by_dd(QCir const& lhs, QCir const& rhs, DDEquivalenceConfig const& config = {});
+
+}  // namespace qsyn::qcir
@@ -0,0 +1,253 @@
+/****************************************************************************
+  PackageName  [ qcir/simulator ]
+  Synopsis     [ Define class DecisionDiagram member functions ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include "./decision_diagram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <functional>
+
+namespace qsyn::qcir {
+
+namespace {
+
+void hash_combine(size_t& seed, size_t value) {
+    seed ^= value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2);
+}
+
+void hash_combine(size_t& seed, Amplitude const& c) {
+    hash_combine(seed, std::bit_cast<uint64_t>(c.real()));
+    hash_combine(seed, std::bit_cast<uint64_t>(c.imag()));
+}
+
+}  // namespace
+
+bool DecisionDiagram::NodeKey::operator==(NodeKey const& other) const {
+    return level == other.level &&
+           std::ranges::equal(children, other.children, [](Edge const& a, Edge const& b) {
+               return a.node == b.node && a.weight == b.weight;
+           });
+}
+
+size_t DecisionDiagram::NodeKeyHash::operator()(NodeKey const& key) const {
+    size_t seed = key.level;
+    for (auto const& child : key.children) {
+        hash_combine(seed, std::hash<Node*>{}(child.node));
+        hash_combine(seed, child.weight);
+    }
+    return seed;
+}
+
+size_t DecisionDiagram::ComputeKeyHash::operator()(std::tuple<Node*, Node*, Amplitude> const& key) const {
+    size_t seed = std::hash<Node*>{}(std::get<0>(key));
+    hash_combine(seed, std::hash<Node*>{}(std::get<1>(key)));
+    hash_combine(seed, std::get<2>(key));
+    return seed;
+}
+
+DecisionDiagram::DecisionDiagram(size_t n_qubits) : _num_qubits{n_qubits} {
+    // keep the exact values that gate matrices use the most
+    _snap(1.);
+    _snap(-1.);
+    for (size_t z = 0; z < n_qubits; ++z) {
+        _identities.emplace_back(_make_node(z, {identity(z), Edge{}, Edge{}, identity(z)}));
+    }
+}
+
+/**
+ * @brief Return the representative of `x`, i.e., a previously seen number within `tolerance`
+ *        of `x` if any, or `x` itself otherwise. Numbers within `tolerance` of 0 become 0.
+ *
+ */
+double DecisionDiagram::_snap(double x) {
+    if (std::abs(x) < tolerance) return 0.;
+    // too large to bucket; such numbers only appear in transient ratios
+    if (std::abs(x) > 1e6) return x;
+
+    auto const key = std::llround(x / tolerance);
+    for (auto const k : {key, key - 1, key + 1}) {
+        auto const it = _real_table.find(k);
+        if (it == _real_table.end()) continue;
+        for (auto const value : it->second) {
+            if (std::abs(value - x) <= tolerance) return value;
+        }
+    }
+    _real_table[key].emplace_back(x);
+    return x;
+}
+
+/**
+ * @brief Scale an edge. The weight is not snapped, as only the normalized child weights are;
+ *        the weight above a node may be arbitrarily small, e.g., 2^(-n/2) for n Hadamards.
+ *
+ */
+DecisionDiagram::Edge DecisionDiagram::_scale(Edge const& e, Amplitude const& factor) {
+    if (e.is_zero() || factor == 0.) return {};
+    return {e.node, e.weight * factor};
+}
+
+/**
+ * @brief Return the edge to the normalized node with the given children. The weight of the
+ *        first child of the largest magnitude is factored out to the returned edge, and the
+ *        other weights are snapped relative to it.
+ *
+ */
+DecisionDiagram::Edge DecisionDiagram::_make_node(size_t level, std::array<Edge, 4> children) {
+    double max_magnitude = 0.;
+    for (auto const& child : children) {
+        max_magnitude = std::max(max_magnitude, std::abs(child.weight));
+    }
+    if (max_magnitude == 0.) return {};
+
+    auto const pivot  = std::ranges::find_if(children, [&](Edge const& child) { return std::abs(child.weight) >= max_magnitude * (1. - tolerance); });
+    auto const weight = pivot->weight;
+    for (auto& child : children) {
+        if (child.is_zero()) continue;
+        child.weight = (&child == &*pivot) ? Amplitude{1.} : _snap(child.weight / weight);
+        if (child.is_zero()) child = Edge{};
+    }
+
+    auto key = NodeKey{level, children};
+    if (auto const it = _unique_table.find(key); it != _unique_table.end()) {
+        return {it->second, weight};
+    }
+    auto* node = _node_pool.create(Node{.children = children, .level = level});
+    _unique_table.emplace(std::move(key), node);
+    return {node, weight};
+}
+
+bool DecisionDiagram::is_identity(Edge const& e) const {
+    return !e.is_zero() && e.node == identity().node;
+}
+
+/**
+ * @brief Return the operator that applies `matrix` to `target` if all `controls` are |1>.
+ *
+ */
+DecisionDiagram::Edge DecisionDiagram::make_gate(Matrix2 const& matrix, size_t target, std::span<size_t const> controls) {
+    std::vector<bool> is_control(_num_qubits, false);
+    for (auto const c : controls) is_control[c] = true;
+
+    // the blocks of the operator by the row and column bits of the target
+    std::array<Edge, 4> blocks;
+    for (size_t i = 0; i < 4; ++i) {
+        blocks[i] = _scale(Edge{nullptr, 1.}, _snap(matrix[i]));
+    }
+    for (size_t z = 0; z < target; ++z) {
+        for (size_t i = 0; i < 4; ++i) {
+            auto const is_diagonal = (i == 0 || i == 3);
+            blocks[i]              = is_control[z]
+                                         ? _make_node(z, {is_diagonal ? identity(z) : Edge{}, Edge{}, Edge{}, blocks[i]})
+                                         : _make_node(z, {blocks[i], Edge{}, Edge{}, blocks[i]});
+        }
+    }
+
+    auto e = _make_node(target, blocks);
+    for (size_t z = target + 1; z < _num_qubits; ++z) {
+        e = is_control[z]
+                ? _make_node(z, {identity(z), Edge{}, Edge{}, e})
+                : _make_node(z, {e, Edge{}, Edge{}, e});
+    }
+    return e;
+}
+
+DecisionDiagram::Edge DecisionDiagram::multiply(Edge const& a, Edge const& b) {
+    if (a.is_zero() || b.is_zero()) return {};
+    auto const weight = a.weight * b.weight;
+    // both are the terminal, or either is the identity
+    if (a.node == nullptr || a.node == _identities[a.node->level].node) return _scale(Edge{b.node, 1.}, weight);
+    if (b.node == _identities[b.node->level].node) return _scale(Edge{a.node, 1.}, weight);
+
+    auto const key = std::tuple{a.node, b.node, Amplitude{}};
+    if (auto const it = _multiply_table.find(key); it != _multiply_table.end()) {
+        return _scale(it->second, weight);
+    }
+
+    std::array<Edge, 4> children;
+    for (size_t row = 0; row < 2; ++row) {
+        for (size_t col = 0; col < 2; ++col) {
+            children[2 * row + col] = add(multiply(a.node->children[2 * row], b.node->children[col]),
+                                          multiply(a.node->children[2 * row + 1], b.node->children[2 + col]));
+        }
+    }
+    auto const result = _make_node(a.node->level, children);
+    _multiply_table.emplace(key, result);
+    return _scale(result, weight);
+}
+
+DecisionDiagram::Edge DecisionDiagram::add(Edge const& a, Edge const& b) {
+    if (a.is_zero()) return b;
+    if (b.is_zero()) return a;
+    if (a.node == b.node) {
+        // the sum cancels out if it is negligible relative to the operands
+        auto const weight = a.weight + b.weight;
+        if (std::abs(weight) <= tolerance * std::max(std::abs(a.weight), std::abs(b.weight))) return {};
+        return {a.node, weight};
+    }
+    // a + b = a.weight * (a.node + ratio * b.node); order the operands to share the cached results
+    if (std::less<Node*>{}(b.node, a.node)) return add(b, a);
+
+    auto const ratio = _snap(b.weight / a.weight);
+    auto const key   = std::tuple{a.node, b.node, ratio};
+    if (auto const it = _add_table.find(key); it != _add_table.end()) {
+        return _scale(it->second, a.weight);
+    }
+
+    std::array<Edge, 4> children;
+    for (size_t i = 0; i < 4; ++i) {
+        children[i] = add(a.node->children[i], _scale(b.node->children[i], ratio));
+    }
+    auto const result = _make_node(a.node->level, children);
+    _add_table.emplace(key, result);
+    return _scale(result, a.weight);
+}
+
+/**
+ * @brief Free the nodes unreachable from `roots` and the identities, and clear the compute tables.
+ *
+ */
+void DecisionDiagram::collect_garbage(std::span<Edge const> roots) {
+    std::vector<Node*> stack;
+    auto const visit = [&stack](Edge const& e) {
+        if (e.node != nullptr && !e.node->marked) {
+            e.node->marked = true;
+            stack.emplace_back(e.node);
+        }
+    };
+    std::ranges::for_each(roots, visit);
+    std::ranges::for_each(_identities, visit);
+    while (!stack.empty()) {
+        auto* node = stack.back();
+        stack.pop_back();
+        std::ranges::for_each(node->children, visit);
+    }
+
+    _real_table.clear();
+    _snap(1.);
+    _snap(-1.);
+    for (auto it = _unique_table.begin(); it != _unique_table.end();) {
+        auto* node = it->second;
+        if (!node->marked) {
+            _node_pool.destroy(node);
+            it = _unique_table.erase(it);
+            continue;
+        }
+        node->marked = false;
+        // the weights are representatives already, so this only re-registers them
+        for (auto const& child : node->children) {
+            _snap(child.weight.real());
+            _snap(child.weight.imag());
+        }
+        ++it;
+    }
+
+    _multiply_table.clear();
+    _add_table.clear();
+}
+
+}  // namespace qsyn::qcir
@@ -0,0 +1,107 @@
+/****************************************************************************
+  PackageName  [ qcir/simulator ]
+  Synopsis     [ Define class DecisionDiagram structure ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "./statevector.hpp"
+#include "util/object_pool.hpp"
+
+namespace qsyn::qcir {
+
+/**
+ * @brief A package of quantum multiple-valued decision diagrams (QMDDs) for n-qubit operators.
+ *        A node at level z splits the operator into 2x2 blocks by the row and column bits of
+ *        qubit z; its children are the blocks, each an edge to a node at level z - 1 (or the
+ *        terminal for level 0) with a complex weight. Nodes are normalized so that their first
+ *        largest child weight is 1, and they are hash-consed in a unique table, so equal
+ *        operators up to a scalar share the same node. In particular, checking whether an
+ *        operator is the identity up to a global phase takes O(1) time.
+ *
+ *        Normalized child weights are snapped to representatives within `tolerance` to absorb
+ *        rounding errors. Edge weights above the nodes are relative to nothing and never snapped.
+ *        Unreachable nodes are freed by `collect_garbage`.
+ *
+ */
+class DecisionDiagram {
+public:
+    struct Node;
+
+    struct Edge {
+        Node* node = nullptr;  // nullptr is the terminal
+        Amplitude weight;
+
+        bool is_zero() const { return weight == 0.; }
+    };
+
+    struct Node {
+        std::array<Edge, 4> children;  // indexed by 2 * row + column
+        size_t level = 0;
+        bool marked  = false;
+    };
+
+    static constexpr double tolerance = 1e-12;
+
+    explicit DecisionDiagram(size_t n_qubits);
+
+    size_t get_num_qubits() const { return _num_qubits; }
+    size_t get_num_nodes() const { return _unique_table.size(); }
+
+    /**
+     * @brief Return the identity on qubits 0 to `n - 1`; `identity()` is the identity on all qubits.
+     *
+     */
+    Edge identity(size_t n) const { return n == 0 ? Edge{nullptr, 1.} : _identities[n - 1]; }
+    Edge identity() const { return identity(_num_qubits); }
+    bool is_identity(Edge const& e) const;
+
+    Edge make_gate(Matrix2 const& matrix, size_t target, std::span<size_t const> controls);
+    Edge multiply(Edge const& a, Edge const& b);
+    Edge add(Edge const& a, Edge const& b);
+
+    void collect_garbage(std::span<Edge const> roots);
+
+private:
+    struct NodeKey {
+        size_t level;
+        std::array<Edge, 4> children;
+
+        bool operator==(NodeKey const& other) const;
+    };
+    struct NodeKeyHash {
+        size_t operator()(NodeKey const& key) const;
+    };
+    struct ComputeKeyHash {
+        size_t operator()(std::tuple<Node*, Node*, Amplitude> const& key) const;
+    };
+
+    size_t _num_qubits;
+    dvlab::utils::ObjectPool<Node> _node_pool;
+    std::unordered_map<NodeKey, Node*, NodeKeyHash> _unique_table;
+    // representatives of real numbers by their rounded multiples of `tolerance`
+    std::unordered_map<int64_t, std::vector<double>> _real_table;
+    std::vector<Edge> _identities;
+
+    // a * b, with unit weights
+    std::unordered_map<std::tuple<Node*, Node*, Amplitude>, Edge, ComputeKeyHash> _multiply_table;
+    // a + ratio * b, with unit weights
+    std::unordered_map<std::tuple<Node*, Node*, Amplitude>, Edge, ComputeKeyHash> _add_table;
+
+    double _snap(double x);
+    Amplitude _snap(Amplitude const& c) { return {_snap(c.real()), _snap(c.imag())}; }
+    Edge _make_node(size_t level, std::array<Edge, 4> children);
+    Edge _scale(Edge const& e, Amplitude const& factor);
+};
+
+}  // namespace qsyn::qcir
@@ -0,0 +1,413 @@
+/****************************************************************************
+  PackageName  [ qcir/simulator ]
+  Synopsis     [ Define statevector simulation of QCir ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include "./simulator.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <complex>
+#include <numbers>
+#include <unordered_map>
+#include <vector>
+
+#include "qcir/gate_type.hpp"
+#include "qcir/qcir.hpp"
+#include "qcir/qcir_gate.hpp"
+#include "qcir/qcir_qubit.hpp"
+#include "util/phase.hpp"
+
+extern bool stop_requested();
+
+namespace qsyn::qcir {
+
+namespace {
+
+/**
+ * @brief The kernel to apply an operation with. Every kind but SWAP also carries the full matrix.
+ *
+ */
+enum class OperationKind {
+    h,
+    x,
+    phase,     // diag(1, f)
+    diagonal,  // diag(d0, d1)
+    matrix,
+    swap
+};
+
+/**
+ * @brief A gate on simulator qubits: `matrix` acts on `target` if all `controls` are |1>.
+ *        A SWAP exchanges `target` and `other`.
+ *
+ */
+struct Operation {
+    OperationKind kind;
+    size_t target;
+    size_t other    = 0;
+    size_t controls = 0;
+    Matrix2 matrix{};
+};
+
+/**
+ * @brief Return e^(i * phase). Multiples of pi/2 are exact, so that, e.g., Px(pi) is exactly X.
+ *
+ */
+Amplitude phase_factor(dvlab::Phase const& phase) {
+    if (phase == dvlab::Phase(0)) return 1.;
+    if (phase == dvlab::Phase(1)) return -1.;
+    if (phase == dvlab::Phase(1, 2)) return {0., 1.};
+    if (phase == dvlab::Phase(-1, 2)) return {0., -1.};
+    return std::polar(1., dvlab::Phase::phase_to_floating_point<double>(phase));
+}
+
+Matrix2 multiply(Matrix2 const& a, Matrix2 const& b) {
+    return {a[0] * b[0] + a[1] * b[2], a[0] * b[1] + a[1] * b[3],
+            a[2] * b[0] + a[3] * b[2], a[2] * b[1] + a[3] * b[3]};
+}
+
+Matrix4 multiply(Matrix4 const& a, Matrix4 const& b) {
+    Matrix4 result{};
+    for (size_t r = 0; r < 4; ++r) {
+        for (size_t k = 0; k < 4; ++k) {
+            for (size_t c = 0; c < 4; ++c) {
+                result[4 * r + c] += a[4 * r + k] * b[4 * k + c];
+            }
+        }
+    }
+    return result;
+}
+
+Matrix2 scale(Matrix2 m, Amplitude factor) {
+    for (auto& entry : m) entry *= factor;
+    return m;
+}
+
+/**
+ * @brief Classify a product of matrices so that the cheapest kernel can apply it.
+ *        Products of diagonal matrices stay exactly diagonal.
+ *
+ */
+OperationKind classify(Matrix2 const& m) {
+    if (m[1] != 0. || m[2] != 0.) return OperationKind::matrix;
+    return m[0] == 1. ? OperationKind::phase : OperationKind::diagonal;
+}
+
+bool is_identity(Operation const& op) {
+    return op.kind == OperationKind::phase && op.matrix[3] == 1.;
+}
+
+std::optional<Operation> to_operation(QCirGate const& gate, std::unordered_map<QubitIdType, size_t> const& positions) {
+    auto const& qubits = gate.get_qubits();
+
+    Operation op{.kind = OperationKind::matrix, .target = positions.at(qubits.back()._qubit)};
+    for (size_t i = 0; i + 1 < qubits.size(); ++i) {
+        op.controls |= size_t{1} << positions.at(qubits[i]._qubit);
+    }
+
+    auto const category = gate.get_rotation_category();
+    if (category == GateRotationCategory::swap) {
+        if (qubits.size() != 2) return std::nullopt;
+        op.kind     = OperationKind::swap;
+        op.target   = positions.at(qubits[0]._qubit);
+        op.other    = positions.at(qubits[1]._qubit);
+        op.controls = 0;
+        return op;
+    }
+
+    auto const matrix = get_target_matrix(gate);
+    if (!matrix.has_value() || category == GateRotationCategory::id) return std::nullopt;
+    op.matrix = *matrix;
+    switch (category) {
+        case GateRotationCategory::h:
+            op.kind = OperationKind::h;
+            break;
+        case GateRotationCategory::pz:
+            op.kind = OperationKind::phase;
+            break;
+        case GateRotationCategory::rz:
+            op.kind = OperationKind::diagonal;
+            break;
+        case GateRotationCategory::px:
+            if (gate.get_phase() == dvlab::Phase(1)) op.kind = OperationKind::x;
+            break;
+        default:
+            break;
+    }
+    return op;
+}
+
+/**
+ * @brief Embed an operation on `qubit0` and `qubit1` into a 4x4 matrix.
+ *
+ */
+Matrix4 to_matrix4(Operation const& op, size_t qubit0, size_t qubit1) {
+    Matrix4 result{};
+    if (op.kind == OperationKind::swap) {
+        result[0] = result[6] = result[9] = result[15] = 1.;
+        return result;
+    }
+    assert(op.target == qubit0 || op.target == qubit1);
+    size_t const target_bit = (op.target == qubit0) ? 0 : 1;
+    size_t const other_bit  = 1 - target_bit;
+    bool const controlled   = op.controls != 0;
+    assert(!controlled || op.controls == (size_t{1} << (target_bit == 0 ? qubit1 : qubit0)));
+
+    for (size_t r = 0; r < 4; ++r) {
+        for (size_t c = 0; c < 4; ++c) {
+            auto const other_value = (r >> other_bit) & 1;
+            if (other_value != ((c >> other_bit) & 1)) continue;
+            if (controlled && other_value == 0) {
+                result[4 * r + c] = (r == c) ? 1. : 0.;
+            } else {
+                result[4 * r + c] = op.matrix[2 * ((r >> target_bit) & 1) + ((c >> target_bit) & 1)];
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Fuses gates before applying them to the state. Uncontrolled single-qubit gates on
+ *        the same qubit are multiplied into one 2x2 matrix. Gates on the same two qubits,
+ *        together with the single-qubit gates around them, are multiplied into one 4x4 matrix.
+ *        A pending block is applied once a gate touches one of its qubits from outside the
+ *        block; pending blocks act on disjoint qubits, so they commute with each other.
+ *
+ */
+class GateFuser {
+public:
+    explicit GateFuser(StateVector& state) : _state{state}, _singles(state.get_num_qubits()), _partners(state.get_num_qubits()), _pairs(state.get_num_qubits()) {}
+
+    void add(Operation const& op);
+    void flush_all();
+
+    size_t get_num_kernels() const { return _num_kernels; }
+
+private:
+    /**
+     * @brief A pending block on two qubits. `op` is kept while the block holds a single gate,
+     *        so that the gate can still be applied with its own kernel.
+     *
+     */
+    struct PairBlock {
+        size_t qubit0;
+        size_t qubit1;
+        Matrix4 matrix;
+        std::optional<Operation> op;
+    };
+
+    StateVector& _state;
+    std::vector<std::optional<Operation>> _singles;
+    std::vector<std::optional<size_t>> _partners;
+    std::vector<std::optional<PairBlock>> _pairs;  // indexed by the smaller qubit of the pair
+    size_t _num_kernels = 0;
+
+    PairBlock& _get_pair(size_t qubit) { return *_pairs[std::min(qubit, *_partners[qubit])]; }
+    void _flush(size_t qubit);
+    void _apply(Operation const& op);
+};
+
+void GateFuser::add(Operation const& op) {
+    auto const is_single = op.kind != OperationKind::swap && op.controls == 0;
+    if (is_single) {
+        if (_partners[op.target].has_value()) {
+            auto& pair = _get_pair(op.target);
+            pair.matrix = multiply(to_matrix4(op, pair.qubit0, pair.qubit1), pair.matrix);
+            pair.op.reset();
+        } else if (_singles[op.target].has_value()) {
+            auto& pending  = *_singles[op.target];
+            pending.matrix = multiply(op.matrix, pending.matrix);
+            pending.kind   = classify(pending.matrix);
+        } else {
+            _singles[op.target] = op;
+        }
+        return;
+    }
+
+    auto const is_pair = (op.kind == OperationKind::swap) ? op.controls == 0 : std::has_single_bit(op.controls);
+    if (!is_pair) {
+        for (auto controls = op.controls; controls != 0; controls &= controls - 1) {
+            _flush(static_cast<size_t>(std::countr_zero(controls)));
+        }
+        _flush(op.target);
+        if (op.kind == OperationKind::swap) _flush(op.other);
+        _apply(op);
+        return;
+    }
+
+    auto const qubit0 = (op.kind == OperationKind::swap) ? op.other : static_cast<size_t>(std::countr_zero(op.controls));
+    auto const qubit1 = op.target;
+    if (_partners[qubit0] == qubit1) {
+        auto& pair  = _get_pair(qubit0);
+        pair.matrix = multiply(to_matrix4(op, pair.qubit0, pair.qubit1), pair.matrix);
+        pair.op.reset();
+        return;
+    }
+
+    // start a new block, absorbing the pending single-qubit gates on its qubits
+    for (auto const qubit : {qubit0, qubit1}) {
+        if (_partners[qubit].has_value()) _flush(qubit);
+    }
+    PairBlock pair{qubit0, qubit1, to_matrix4(op, qubit0, qubit1), op};
+    for (auto const qubit : {qubit0, qubit1}) {
+        if (!_singles[qubit].has_value()) continue;
+        pair.matrix = multiply(pair.matrix, to_matrix4(*_singles[qubit], qubit0, qubit1));
+        pair.op.reset();
+        _singles[qubit].reset();
+    }
+    _pairs[std::min(qubit0, qubit1)] = pair;
+    _partners[qubit0]                = qubit1;
+    _partners[qubit1]                = qubit0;
+}
+
+void GateFuser::flush_all() {
+    for (size_t qubit = 0; qubit < _singles.size(); ++qubit) {
+        _flush(qubit);
+    }
+}
+
+/**
+ * @brief Apply the pending block on `qubit`, if any.
+ *
+ */
+void GateFuser::_flush(size_t qubit) {
+    if (_singles[qubit].has_value()) {
+        _apply(*_singles[qubit]);
+        _singles[qubit].reset();
+    }
+    if (_partners[qubit].has_value()) {
+        auto const partner = *_partners[qubit];
+        auto& pair         = _get_pair(qubit);
+        if (pair.op.has_value()) {
+            _apply(*pair.op);
+        } else {
+            _state.apply_matrix(pair.qubit0, pair.qubit1, pair.matrix);
+            ++_num_kernels;
+        }
+        _pairs[std::min(qubit, partner)].reset();
+        _partners[qubit].reset();
+        _partners[partner].reset();
+    }
+}
+
+void GateFuser::_apply(Operation const& op) {
+    if (is_identity(op)) return;
+    switch (op.kind) {
+        case OperationKind::h:
+            _state.apply_h(op.target, op.controls);
+            break;
+        case OperationKind::x:
+            _state.apply_x(op.target, op.controls);
+            break;
+        case OperationKind::phase:
+            _state.apply_phase(op.target, op.matrix[3], op.controls);
+            break;
+        case OperationKind::diagonal:
+            _state.apply_diagonal(op.target, op.matrix[0], op.matrix[3], op.controls);
+            break;
+        case OperationKind::matrix:
+            _state.apply_matrix(op.target, op.matrix, op.controls);
+            break;
+        case OperationKind::swap:
+            _state.apply_swap(op.target, op.other, op.controls);
+            break;
+    }
+    ++_num_kernels;
+}
+
+}  // namespace
+
+/**
+ * @brief Return the matrix that a gate applies to its target when all its controls are |1>.
+ *
+ * @return the matrix, or std::nullopt for SWAP gates
+ */
+std::optional<Matrix2> get_target_matrix(QCirGate const& gate) {
+    auto const phase = gate.get_phase();
+    auto const f     = phase_factor(phase);
+    // the global phase of R_a(theta) relative to P_a(theta); theta is in (-pi, pi], so halving it does not wrap around
+    auto const half_angle = std::conj(phase_factor(phase / 2));
+    Matrix2 const px      = {(1. + f) / 2., (1. - f) / 2., (1. - f) / 2., (1. + f) / 2.};
+    // Py = S^dagger Px S, i.e., S is applied first, as in QTensor::pygate and the ZX form of Py
+    Matrix2 const py = {px[0], px[1] * Amplitude{0., 1.}, px[2] * Amplitude{0., -1.}, px[3]};
+
+    switch (gate.get_rotation_category()) {
+        case GateRotationCategory::id:
+            return Matrix2{1., 0., 0., 1.};
+        case GateRotationCategory::h: {
+            auto const s = std::numbers::sqrt2 / 2;
+            return Matrix2{s, s, s, -s};
+        }
+        case GateRotationCategory::pz:
+            return Matrix2{1., 0., 0., f};
+        case GateRotationCategory::rz:
+            return Matrix2{half_angle, 0., 0., half_angle * f};
+        case GateRotationCategory::px:
+            return px;
+        case GateRotationCategory::rx:
+            return scale(px, half_angle);
+        case GateRotationCategory::py:
+            return py;
+        case GateRotationCategory::ry:
+            return scale(py, half_angle);
+        default:
+            return std::nullopt;
+    }
+}
+
+/**
+ * @brief Apply the gates of `qcir` to `state` in topological order, fusing gates on one or
+ *        two qubits on the way. The qubits of `qcir`, sorted by ID, are the qubits of `state`
+ *        in order.
+ *
+ * @param qcir
+ * @param state the input state; it holds the output state when the simulation succeeds
+ * @return the statistics, or std::nullopt if a gate is not supported or the simulation is interrupted
+ */
+std::optional<SimulationStatistics> simulate(QCir const& qcir, StateVector& state) {
+    if (state.get_num_qubits() != qcir.get_num_qubits()) {
+        spdlog::error("The state has {} qubits, but the QCir has {} qubits!!", state.get_num_qubits(), qcir.get_num_qubits());
+        return std::nullopt;
+    }
+
+    std::vector<QubitIdType> qubit_ids;
+    for (auto const* qubit : qcir.get_qubits()) {
+        qubit_ids.emplace_back(qubit->get_id());
+    }
+    std::ranges::sort(qubit_ids);
+    std::unordered_map<QubitIdType, size_t> positions;
+    for (size_t i = 0; i < qubit_ids.size(); ++i) {
+        positions.emplace(qubit_ids[i], i);
+    }
+
+    SimulationStatistics stats;
+    GateFuser fuser{state};
+    for (auto const* gate : qcir.update_topological_order()) {
+        if (stop_requested()) {
+            spdlog::warn("Simulation interrupted.");
+            return std::nullopt;
+        }
+        ++stats.num_gates;
+        if (gate->get_rotation_category() == GateRotationCategory::id) continue;
+
+        auto const op = to_operation(*gate, positions);
+        if (!op.has_value()) {
+            spdlog::error("Gate {} ({}) is not supported by the simulator!!", gate->get_id(), gate->get_type_str());
+            return std::nullopt;
+        }
+        fuser.add(*op);
+    }
+    fuser.flush_all();
+
+    stats.num_kernels = fuser.get_num_kernels();
+    return stats;
+}
+
+}  // namespace qsyn::qcir
@@ -0,0 +1,28 @@
+/****************************************************************************
+  PackageName  [ qcir/simulator ]
+  Synopsis     [ Define statevector simulation of QCir ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+#include "./statevector.hpp"
+
+namespace qsyn::qcir {
+
+class QCir;
+class QCirGate;
+
+struct SimulationStatistics {
+    size_t num_gates   = 0;
+    size_t num_kernels = 0;  // the number of passes over the state after gate fusion
+};
+
+std::optional<Matrix2> get_target_matrix(QCirGate const& gate);
+std::optional<SimulationStatistics> simulate(QCir const& qcir, StateVector& state);
+
+}  // namespace qsyn::qcir
@@ -0,0 +1,209 @@
+/****************************************************************************
+  PackageName  [ qcir/simulator ]
+  Synopsis     [ Define simulator package commands ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include "./simulator_cmd.hpp"
+
+#include <fmt/core.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../qcir.hpp"
+#include "../qcir_cmd.hpp"
+#include "../qcir_mgr.hpp"
+#include "./simulator.hpp"
+#include "./statevector.hpp"
+#include "cli/cli.hpp"
+#include "util/phase.hpp"
+#include "util/text_format.hpp"
+
+using namespace dvlab::argparse;
+using dvlab::CmdExecResult;
+using dvlab::Command;
+
+namespace qsyn::qcir {
+
+namespace {
+
+// 2^40 amplitudes take 16 TiB
+constexpr size_t max_num_qubits = 40;
+
+/**
+ * @brief Parse a basis state such as "0110", where the i-th character is the value of qubit i.
+ *
+ */
+std::optional<size_t> parse_basis_state(std::string const& str, size_t n_qubits) {
+    if (str.size() != n_qubits || !std::ranges::all_of(str, [](char c) { return c == '0' || c == '1'; })) {
+        spdlog::error("The input state should be a string of {} 0s and 1s!!", n_qubits);
+        return std::nullopt;
+    }
+    size_t index = 0;
+    for (size_t i = 0; i < n_qubits; ++i) {
+        if (str[i] == '1') index |= size_t{1} << i;
+    }
+    return index;
+}
+
+std::string get_basis_state_str(size_t index, size_t n_qubits) {
+    std::string str;
+    for (size_t i = 0; i < n_qubits; ++i) {
+        str += ((index >> i) & 1) ? '1' : '0';
+    }
+    return str;
+}
+
+/**
+ * @brief Print the `n` amplitudes with the largest probabilities in the order of their indices,
+ *        skipping negligible ones. Ties are broken by the index.
+ *
+ */
+void print_largest_amplitudes(StateVector const& state, size_t n) {
+    using Entry = std::pair<double, size_t>;  // (probability, index)
+    // `is_better` puts the worst kept amplitude at the top of the heap
+    auto const is_better = [](Entry const& a, Entry const& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    };
+    std::priority_queue<Entry, std::vector<Entry>, decltype(is_better)> largest{is_better};
+    for (size_t i = 0; i < state.size() && n > 0; ++i) {
+        auto const entry = Entry{std::norm(state[i]), i};
+        if (entry.first < 1e-12) continue;
+        if (largest.size() < n) {
+            largest.push(entry);
+        } else if (is_better(entry, largest.top())) {
+            largest.pop();
+            largest.push(entry);
+        }
+    }
+
+    std::vector<Entry> entries;
+    for (; !largest.empty(); largest.pop()) entries.emplace_back(largest.top());
+    std::ranges::sort(entries, {}, &Entry::second);
+
+    auto const clean = [](double x) { return std::abs(x) < 5e-7 ? 0. : x; };
+    for (auto const& [probability, index] : entries) {
+        fmt::println("|{}>: {:.6f}{:+.6f}i (probability: {:.6f})",
+                     get_basis_state_str(index, state.get_num_qubits()), clean(state[index].real()), clean(state[index].imag()), probability);
+    }
+}
+
+bool run_simulation(QCir const& qcir, StateVector& state) {
+    auto const stats = simulate(qcir, state);
+    if (!stats.has_value()) return false;
+    spdlog::info("Applied {} gates in {} passes over the state", stats->num_gates, stats->num_kernels);
+    return true;
+}
+
+}  // namespace
+
+Command qcir_simulate_cmd(QCirMgr const& qcir_mgr) {
+    return {"simulate",
+            [&](ArgumentParser& parser) {
+                parser.description("simulate QCir on a statevector");
+
+                auto mutex = parser.add_mutually_exclusive_group();
+
+                mutex.add_argument<std::string>("-i", "--input")
+                    .help("the input basis state, where the i-th character is the value of the i-th qubit in ascending ID order (default: all 0s)");
+                mutex.add_argument<bool>("-r", "--random")
+                    .action(store_true)
+                    .help("use random input states");
+
+                parser.add_argument<size_t>("--seed")
+                    .help("the seed of the random input states. If not specified, a random seed is used");
+                parser.add_argument<size_t>("-t", "--trials")
+                    .default_value(1)
+                    .help("the number of random input states to compare on. Only meaningful with both `--random` and `--compare` (default: 1)");
+                parser.add_argument<size_t>("-c", "--compare")
+                    .constraint(valid_qcir_id(qcir_mgr))
+                    .help("compare the output states with those of the QCir with this ID instead of printing them");
+                parser.add_argument<double>("-e", "--epsilon")
+                    .metavar("eps")
+                    .default_value(1e-6)
+                    .help("output \"equivalent\" if the fidelity of every trial is at least 1 - eps (default: 1e-6)");
+                parser.add_argument<size_t>("-n", "--num-amplitudes")
+                    .default_value(8)
+                    .help("the number of the largest amplitudes of the output state to print (default: 8)");
+            },
+            [&](ArgumentParser const& parser) {
+                if (!qcir_mgr_not_empty(qcir_mgr)) return CmdExecResult::error;
+
+                auto const& qcir    = *qcir_mgr.get();
+                auto const n_qubits = qcir.get_num_qubits();
+                if (n_qubits > max_num_qubits) {
+                    spdlog::error("Cannot simulate more than {} qubits!!", max_num_qubits);
+                    return CmdExecResult::error;
+                }
+
+                QCir const* other = parser.parsed("--compare") ? qcir_mgr.find_by_id(parser.get<size_t>("--compare")) : nullptr;
+                if (other != nullptr && other->get_num_qubits() != n_qubits) {
+                    spdlog::error("The two QCirs should have the same number of qubits!!");
+                    return CmdExecResult::error;
+                }
+
+                size_t basis_index = 0;
+                if (parser.parsed("--input")) {
+                    auto const index = parse_basis_state(parser.get<std::string>("--input"), n_qubits);
+                    if (!index.has_value()) return CmdExecResult::error;
+                    basis_index = *index;
+                }
+
+                auto const random   = parser.get<bool>("--random");
+                auto const seed     = parser.parsed("--seed") ? parser.get<size_t>("--seed") : size_t{std::random_device{}()};
+                auto const n_trials = (random && other != nullptr) ? std::max<size_t>(parser.get<size_t>("--trials"), 1) : 1;
+                if (random) spdlog::info("Random seed: {}", seed);
+                spdlog::info("Simulating {} qubits with the {} kernels...", n_qubits, get_simulation_kernel_name());
+
+                auto const get_input_state = [&](size_t trial) {
+                    return random ? StateVector::random_state(n_qubits, seed + trial) : StateVector::basis_state(n_qubits, basis_index);
+                };
+
+                try {
+                    if (other == nullptr) {
+                        auto state = get_input_state(0);
+                        if (!run_simulation(qcir, state)) return CmdExecResult::error;
+                        print_largest_amplitudes(state, parser.get<size_t>("--num-amplitudes"));
+                        return CmdExecResult::done;
+                    }
+
+                    double fidelity = 1.;
+                    dvlab::Phase phase;
+                    for (size_t trial = 0; trial < n_trials; ++trial) {
+                        auto lhs = get_input_state(trial);
+                        auto rhs = lhs;
+                        if (!run_simulation(qcir, lhs) || !run_simulation(*other, rhs)) return CmdExecResult::error;
+                        auto const overlap = lhs.inner_product(rhs);
+                        fidelity           = std::min(fidelity, std::norm(overlap));
+                        if (trial == 0) phase = dvlab::Phase(std::arg(overlap));
+                    }
+
+                    using namespace dvlab;
+                    if (fidelity >= 1 - parser.get<double>("--epsilon")) {
+                        fmt::println("{}", fmt_ext::styled_if_ansi_supported("Equivalent", fmt::fg(fmt::terminal_color::green) | fmt::emphasis::bold));
+                        fmt::println("- Fidelity    : {:.6}", fidelity);
+                        fmt::println("- Global Phase: {}", phase);
+                    } else {
+                        fmt::println("{}", fmt_ext::styled_if_ansi_supported("Not Equivalent", fmt::fg(fmt::terminal_color::red) | fmt::emphasis::bold));
+                        fmt::println("- Fidelity    : {:.6}", fidelity);
+                    }
+                } catch (std::bad_alloc const&) {
+                    spdlog::error("Not enough memory to simulate {} qubits!!", n_qubits);
+                    return CmdExecResult::error;
+                }
+
+                return CmdExecResult::done;
+            }};
+}
+
+}  // namespace qsyn::qcir
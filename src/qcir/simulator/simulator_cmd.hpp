@@ -0,0 +1,17 @@
+/****************************************************************************
+  PackageName  [ qcir/simulator ]
+  Synopsis     [ Define simulator package commands ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#pragma once
+
+#include "cli/cli.hpp"
+#include "qcir/qcir_mgr.hpp"
+
+namespace qsyn::qcir {
+
+dvlab::Command qcir_simulate_cmd(QCirMgr const& qcir_mgr);
+
+}
@@ -0,0 +1,362 @@
+/****************************************************************************
+  PackageName  [ qcir/simulator ]
+  Synopsis     [ Define class StabilizerTableau member functions ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include "./stabilizer_tableau.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <ranges>
+#include <tl/to.hpp>
+#include <utility>
+
+namespace qsyn::qcir {
+
+using dvlab::bit_kernels::bits_per_word;
+using dvlab::bit_kernels::num_words;
+using WordType = dvlab::bit_kernels::WordType;
+
+namespace {
+
+// row operations over fewer rows than this run on a single thread
+constexpr size_t parallel_threshold = 512;
+
+/**
+ * @brief dst := src * dst as Pauli strings, including the sign.
+ *        The phase of the product is accumulated in powers of i over all qubits:
+ *        XY, YZ and ZX contribute +1, while YX, ZY and XZ contribute -1.
+ *        If the two strings anticommute, the sign is meaningless, which is fine for destabilizers.
+ *
+ */
+void multiply_into(WordType* dst_x, WordType* dst_z, unsigned char& dst_sign,
+                   WordType const* src_x, WordType const* src_z, unsigned char src_sign, size_t n_words) {
+    int64_t phase = 2 * (dst_sign + src_sign);
+    for (size_t w = 0; w < n_words; ++w) {
+        auto const x1 = src_x[w], z1 = src_z[w], x2 = dst_x[w], z2 = dst_z[w];
+
+        auto const plus  = (x1 & z1 & ~x2 & z2) | (x1 & ~z1 & x2 & z2) | (~x1 & z1 & x2 & ~z2);
+        auto const minus = (x1 & z1 & x2 & ~z2) | (x1 & ~z1 & ~x2 & z2) | (~x1 & z1 & x2 & z2);
+        phase += std::popcount(plus) - std::popcount(minus);
+
+        dst_x[w] = x2 ^ x1;
+        dst_z[w] = z2 ^ z1;
+    }
+    dst_sign = static_cast<unsigned char>((phase & 3) >> 1);
+}
+
+/**
+ * @brief A set of commuting Pauli strings under Gaussian elimination.
+ *
+ */
+class PauliRows {
+public:
+    PauliRows(size_t n_qubits, size_t n_rows)
+        : _num_words{num_words(n_qubits)}, _x_bits(n_rows * _num_words, 0), _z_bits(n_rows * _num_words, 0), _signs(n_rows, 0) {}
+
+    size_t num_rows() const { return _signs.size(); }
+
+    WordType* x_row(size_t row) { return _x_bits.data() + row * _num_words; }
+    WordType* z_row(size_t row) { return _z_bits.data() + row * _num_words; }
+    unsigned char& sign(size_t row) { return _signs[row]; }
+
+    bool get(bool is_x, size_t row, size_t qubit) const {
+        auto const& bits = is_x ? _x_bits : _z_bits;
+        return (bits[row * _num_words + qubit / bits_per_word] >> (qubit % bits_per_word)) & 1;
+    }
+    void set(bool is_x, size_t row, size_t qubit) {
+        auto& bits = is_x ? _x_bits : _z_bits;
+        bits[row * _num_words + qubit / bits_per_word] |= WordType{1} << (qubit % bits_per_word);
+    }
+
+    /**
+     * @brief Make row `pivot_row` the only row with the given bit set, choosing the pivot among rows
+     *        at or after `pivot_row`. Returns false if there is no such row.
+     *
+     */
+    bool eliminate(bool is_x, size_t qubit, size_t pivot_row) {
+        auto const n_rows = num_rows();
+        auto row          = pivot_row;
+        while (row < n_rows && !get(is_x, row, qubit)) ++row;
+        if (row == n_rows) return false;
+        _swap_rows(row, pivot_row);
+
+#pragma omp parallel for schedule(static) if (n_rows >= parallel_threshold)
+        for (size_t i = 0; i < n_rows; ++i) {
+            if (i == pivot_row || !get(is_x, i, qubit)) continue;
+            multiply_into(x_row(i), z_row(i), _signs[i], x_row(pivot_row), z_row(pivot_row), _signs[pivot_row], _num_words);
+        }
+        return true;
+    }
+
+private:
+    size_t _num_words;
+    std::vector<WordType> _x_bits;
+    std::vector<WordType> _z_bits;
+    std::vector<unsigned char> _signs;
+
+    void _swap_rows(size_t i, size_t j) {
+        if (i == j) return;
+        std::swap_ranges(x_row(i), x_row(i) + _num_words, x_row(j));
+        std::swap_ranges(z_row(i), z_row(i) + _num_words, z_row(j));
+        std::swap(_signs[i], _signs[j]);
+    }
+};
+
+/**
+ * @brief Bring the stabilizer rows of a state into reduced row echelon form, pivoting on the
+ *        X bits and then the Z bits of `qubits` in order, and write them out with qubit `qubits[i]`
+ *        renamed to i. The other qubits must be in a computational basis state; their Z bits are
+ *        eliminated first so that the remaining rows generate the stabilizers of `qubits` alone.
+ *
+ */
+std::optional<CanonicalStabilizers> canonicalize(PauliRows& rows, size_t n_qubits, std::span<size_t const> qubits) {
+    auto is_kept = std::vector<bool>(n_qubits, false);
+    for (auto q : qubits) is_kept[q] = true;
+
+    size_t pivot_row = 0;
+    for (size_t q = 0; q < n_qubits; ++q) {
+        if (is_kept[q]) continue;
+        for (size_t row = 0; row < rows.num_rows(); ++row) {
+            if (rows.get(true, row, q)) return std::nullopt;
+        }
+        if (!rows.eliminate(false, q, pivot_row)) return std::nullopt;
+        ++pivot_row;
+    }
+    auto const first_kept_row = pivot_row;
+
+    for (auto const is_x : {true, false}) {
+        for (auto q : qubits) {
+            if (rows.eliminate(is_x, q, pivot_row)) ++pivot_row;
+        }
+    }
+    assert(pivot_row == rows.num_rows());
+
+    auto result       = CanonicalStabilizers{};
+    result.num_qubits = qubits.size();
+    auto const n_kept = qubits.size();
+    auto const words  = num_words(n_kept);
+    result.x_bits.assign(n_kept * words, 0);
+    result.z_bits.assign(n_kept * words, 0);
+    result.signs.assign(n_kept, 0);
+    for (size_t row = 0; row < n_kept; ++row) {
+        auto const src = first_kept_row + row;
+        for (size_t i = 0; i < n_kept; ++i) {
+            auto const mask = WordType{1} << (i % bits_per_word);
+            if (rows.get(true, src, qubits[i])) result.x_bits[row * words + i / bits_per_word] |= mask;
+            if (rows.get(false, src, qubits[i])) result.z_bits[row * words + i / bits_per_word] |= mask;
+        }
+        result.signs[row] = rows.sign(src);
+    }
+    return result;
+}
+
+}  // namespace
+
+/**
+ * @brief Construct the tableau of |0...0>, whose destabilizers are X_i and stabilizers are Z_i.
+ *
+ */
+StabilizerTableau::StabilizerTableau(size_t n_qubits)
+    : _num_qubits{n_qubits},
+      _num_words{num_words(n_qubits)},
+      _x_bits((2 * n_qubits + 1) * _num_words, 0),
+      _z_bits((2 * n_qubits + 1) * _num_words, 0),
+      _signs(2 * n_qubits + 1, 0) {
+    for (size_t i = 0; i < n_qubits; ++i) {
+        _x_row(i)[i / bits_per_word] |= WordType{1} << (i % bits_per_word);
+        _z_row(n_qubits + i)[i / bits_per_word] |= WordType{1} << (i % bits_per_word);
+    }
+}
+
+void StabilizerTableau::h(size_t qubit) {
+    _update_column(qubit, [](WordType& x_word, WordType& z_word, unsigned char& sign, WordType mask) {
+        bool const x = x_word & mask, z = z_word & mask;
+        sign ^= x & z;
+        if (x != z) {
+            x_word ^= mask;
+            z_word ^= mask;
+        }
+    });
+}
+
+void StabilizerTableau::s(size_t qubit) {
+    _update_column(qubit, [](WordType& x_word, WordType& z_word, unsigned char& sign, WordType mask) {
+        bool const x = x_word & mask, z = z_word & mask;
+        sign ^= x & z;
+        if (x) z_word ^= mask;
+    });
+}
+
+void StabilizerTableau::sdg(size_t qubit) {
+    _update_column(qubit, [](WordType& x_word, WordType& z_word, unsigned char& sign, WordType mask) {
+        bool const x = x_word & mask, z = z_word & mask;
+        sign ^= x & !z;
+        if (x) z_word ^= mask;
+    });
+}
+
+void StabilizerTableau::x(size_t qubit) {
+    _update_column(qubit, [](WordType& /* x_word */, WordType& z_word, unsigned char& sign, WordType mask) {
+        sign ^= (z_word & mask) != 0;
+    });
+}
+
+void StabilizerTableau::y(size_t qubit) {
+    _update_column(qubit, [](WordType& x_word, WordType& z_word, unsigned char& sign, WordType mask) {
+        sign ^= ((x_word ^ z_word) & mask) != 0;
+    });
+}
+
+void StabilizerTableau::z(size_t qubit) {
+    _update_column(qubit, [](WordType& x_word, WordType& /* z_word */, unsigned char& sign, WordType mask) {
+        sign ^= (x_word & mask) != 0;
+    });
+}
+
+void StabilizerTableau::cx(size_t control, size_t target) {
+    for (size_t row = 0; row < 2 * _num_qubits; ++row) {
+        bool const xc = _get_x(row, control), zc = _get_z(row, control);
+        bool const xt = _get_x(row, target), zt = _get_z(row, target);
+        _signs[row] ^= xc & zt & !(xt ^ zc);
+        if (xc) _x_row(row)[target / bits_per_word] ^= WordType{1} << (target % bits_per_word);
+        if (zt) _z_row(row)[control / bits_per_word] ^= WordType{1} << (control % bits_per_word);
+    }
+}
+
+void StabilizerTableau::cz(size_t qubit0, size_t qubit1) {
+    for (size_t row = 0; row < 2 * _num_qubits; ++row) {
+        bool const x0 = _get_x(row, qubit0), z0 = _get_z(row, qubit0);
+        bool const x1 = _get_x(row, qubit1), z1 = _get_z(row, qubit1);
+        _signs[row] ^= x0 & x1 & (z0 ^ z1);
+        if (x1) _z_row(row)[qubit0 / bits_per_word] ^= WordType{1} << (qubit0 % bits_per_word);
+        if (x0) _z_row(row)[qubit1 / bits_per_word] ^= WordType{1} << (qubit1 % bits_per_word);
+    }
+}
+
+void StabilizerTableau::swap(size_t qubit0, size_t qubit1) {
+    auto const mask0 = WordType{1} << (qubit0 % bits_per_word);
+    auto const mask1 = WordType{1} << (qubit1 % bits_per_word);
+    for (size_t row = 0; row < 2 * _num_qubits; ++row) {
+        for (auto* bits : {&_x_bits, &_z_bits}) {
+            auto& word0 = (*bits)[row * _num_words + qubit0 / bits_per_word];
+            auto& word1 = (*bits)[row * _num_words + qubit1 / bits_per_word];
+            if (((word0 & mask0) != 0) != ((word1 & mask1) != 0)) {
+                word0 ^= mask0;
+                word1 ^= mask1;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Measure the qubit in the Z basis and project the state onto `outcome`.
+ *
+ * @return false if `outcome` has zero probability, in which case the state is unchanged
+ */
+bool StabilizerTableau::postselect(size_t qubit, bool outcome) {
+    auto const n = _num_qubits;
+
+    size_t pivot = n;
+    while (pivot < 2 * n && !_get_x(pivot, qubit)) ++pivot;
+
+    if (pivot == 2 * n) {
+        // the outcome is deterministic; compute it in the scratch row
+        _clear_row(2 * n);
+        for (size_t i = 0; i < n; ++i) {
+            if (_get_x(i, qubit)) _rowsum(2 * n, i + n);
+        }
+        return _signs[2 * n] == static_cast<unsigned char>(outcome);
+    }
+
+#pragma omp parallel for schedule(static) if (2 * n >= parallel_threshold)
+    for (size_t i = 0; i < 2 * n; ++i) {
+        if (i != pivot && _get_x(i, qubit)) _rowsum(i, pivot);
+    }
+
+    std::ranges::copy(_x_row(pivot), _x_row(pivot - n).begin());
+    std::ranges::copy(_z_row(pivot), _z_row(pivot - n).begin());
+    _signs[pivot - n] = _signs[pivot];
+
+    _clear_row(pivot);
+    _z_row(pivot)[qubit / bits_per_word] |= WordType{1} << (qubit % bits_per_word);
+    _signs[pivot] = static_cast<unsigned char>(outcome);
+    return true;
+}
+
+/**
+ * @brief Get the canonical stabilizers of the state on `qubits`, where qubit `qubits[i]` becomes qubit i.
+ *        The other qubits should be in a computational basis state, e.g., after being postselected.
+ *
+ * @return std::nullopt if the other qubits are not in a computational basis state
+ */
+std::optional<CanonicalStabilizers> StabilizerTableau::get_canonical_stabilizers(std::span<size_t const> qubits) const {
+    auto rows = PauliRows(_num_qubits, _num_qubits);
+    for (size_t i = 0; i < _num_qubits; ++i) {
+        std::copy_n(_x_bits.data() + (_num_qubits + i) * _num_words, _num_words, rows.x_row(i));
+        std::copy_n(_z_bits.data() + (_num_qubits + i) * _num_words, _num_words, rows.z_row(i));
+        rows.sign(i) = _signs[_num_qubits + i];
+    }
+    return canonicalize(rows, _num_qubits, qubits);
+}
+
+CanonicalStabilizers StabilizerTableau::get_canonical_stabilizers() const {
+    auto const qubits = std::views::iota(size_t{0}, _num_qubits) | tl::to<std::vector>();
+    return get_canonical_stabilizers(qubits).value();
+}
+
+/**
+ * @brief Regarding this tableau as that of a Clifford unitary U, i.e., U applied to |0...0>,
+ *        get the canonical stabilizers of its Choi state (I tensor U) sum_i |i>|i>.
+ *        Qubit i is the i-th input and qubit n + i is the i-th output. The state is stabilized by
+ *        X_i tensor U X_i U^dagger and Z_i tensor U Z_i U^dagger, which are the rows of the tableau.
+ *
+ */
+CanonicalStabilizers StabilizerTableau::get_choi_stabilizers() const {
+    auto const n = _num_qubits;
+    auto rows    = PauliRows(2 * n, 2 * n);
+    for (size_t row = 0; row < 2 * n; ++row) {
+        // destabilizer i is the image of X_i, and stabilizer i is the image of Z_i
+        rows.set(row < n, row, row % n);
+        for (size_t q = 0; q < n; ++q) {
+            if (_get_x(row, q)) rows.set(true, row, n + q);
+            if (_get_z(row, q)) rows.set(false, row, n + q);
+        }
+        rows.sign(row) = _signs[row];
+    }
+    auto const qubits = std::views::iota(size_t{0}, 2 * n) | tl::to<std::vector>();
+    return canonicalize(rows, 2 * n, qubits).value();
+}
+
+/**
+ * @brief Compare every row but the scratch row. If both tableaux are obtained by applying Clifford
+ *        circuits to |0...0>, they are equal iff the circuits are equal up to a global phase.
+ *
+ */
+bool StabilizerTableau::operator==(StabilizerTableau const& other) const {
+    if (_num_qubits != other._num_qubits) return false;
+    auto const n_words = 2 * _num_qubits * _num_words;
+    return std::equal(_x_bits.begin(), _x_bits.begin() + n_words, other._x_bits.begin()) &&
+           std::equal(_z_bits.begin(), _z_bits.begin() + n_words, other._z_bits.begin()) &&
+           std::equal(_signs.begin(), _signs.begin() + 2 * _num_qubits, other._signs.begin());
+}
+
+/**
+ * @brief Row `dst` := row `src` * row `dst`.
+ *
+ */
+void StabilizerTableau::_rowsum(size_t dst, size_t src) {
+    multiply_into(_x_row(dst).data(), _z_row(dst).data(), _signs[dst], _x_row(src).data(), _z_row(src).data(), _signs[src], _num_words);
+}
+
+void StabilizerTableau::_clear_row(size_t row) {
+    std::ranges::fill(_x_row(row), 0);
+    std::ranges::fill(_z_row(row), 0);
+    _signs[row] = 0;
+}
+
+}  // namespace qsyn::qcir
@@ -0,0 +1,104 @@
+/****************************************************************************
+  PackageName  [ qcir/simulator ]
+  Synopsis     [ Define class StabilizerTableau structure ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "util/bit_kernels.hpp"
+
+namespace qsyn::qcir {
+
+/**
+ * @brief The stabilizer group of an n-qubit stabilizer state in reduced row echelon form.
+ *        Two stabilizer states are equal up to a global scalar iff their canonical forms are equal.
+ *
+ */
+struct CanonicalStabilizers {
+    using WordType = dvlab::bit_kernels::WordType;
+
+    size_t num_qubits = 0;
+    std::vector<WordType> x_bits;      // row-major; each row takes num_words(num_qubits) words
+    std::vector<WordType> z_bits;      // ditto
+    std::vector<unsigned char> signs;  // 1 for a -1 sign
+
+    bool operator==(CanonicalStabilizers const& other) const = default;
+};
+
+/**
+ * @brief A CHP stabilizer tableau (Aaronson and Gottesman, 2004).
+ *        Rows 0 to n-1 are the destabilizers and rows n to 2n-1 are the stabilizers;
+ *        each row is a Pauli string bit-packed into words, plus a sign bit.
+ *        Starting from |0...0>, the tableau after applying a Clifford circuit U holds
+ *        U X_i U^dagger and U Z_i U^dagger, i.e., it determines U up to a global phase.
+ *
+ *        Gates take O(n) time and measurements take O(n^2 / 64) time.
+ *
+ */
+class StabilizerTableau {
+public:
+    using WordType = dvlab::bit_kernels::WordType;
+
+    explicit StabilizerTableau(size_t n_qubits);
+
+    size_t get_num_qubits() const { return _num_qubits; }
+
+    void h(size_t qubit);
+    void s(size_t qubit);
+    void sdg(size_t qubit);
+    void x(size_t qubit);
+    void y(size_t qubit);
+    void z(size_t qubit);
+    void cx(size_t control, size_t target);
+    void cz(size_t qubit0, size_t qubit1);
+    void swap(size_t qubit0, size_t qubit1);
+
+    bool postselect(size_t qubit, bool outcome);
+
+    std::optional<CanonicalStabilizers> get_canonical_stabilizers(std::span<size_t const> qubits) const;
+    CanonicalStabilizers get_canonical_stabilizers() const;
+    CanonicalStabilizers get_choi_stabilizers() const;
+
+    bool operator==(StabilizerTableau const& other) const;
+
+private:
+    size_t _num_qubits;
+    size_t _num_words;
+    // (2n + 1) rows; the last row is the scratch row for deterministic measurements
+    std::vector<WordType> _x_bits;
+    std::vector<WordType> _z_bits;
+    std::vector<unsigned char> _signs;
+
+    std::span<WordType> _x_row(size_t row) { return {_x_bits.data() + row * _num_words, _num_words}; }
+    std::span<WordType> _z_row(size_t row) { return {_z_bits.data() + row * _num_words, _num_words}; }
+
+    bool _get_x(size_t row, size_t qubit) const { return (_x_bits[row * _num_words + qubit / dvlab::bit_kernels::bits_per_word] >> (qubit % dvlab::bit_kernels::bits_per_word)) & 1; }
+    bool _get_z(size_t row, size_t qubit) const { return (_z_bits[row * _num_words + qubit / dvlab::bit_kernels::bits_per_word] >> (qubit % dvlab::bit_kernels::bits_per_word)) & 1; }
+
+    void _rowsum(size_t dst, size_t src);
+    void _clear_row(size_t row);
+
+    /**
+     * @brief Update the bits of `qubit` in every row with `update(x_word, z_word, sign, mask)`,
+     *        where `mask` selects the qubit in the two words.
+     *
+     */
+    template <typename F>
+    void _update_column(size_t qubit, F update) {
+        auto const word = qubit / dvlab::bit_kernels::bits_per_word;
+        auto const mask = WordType{1} << (qubit % dvlab::bit_kernels::bits_per_word);
+        for (size_t row = 0; row < 2 * _num_qubits; ++row) {
+            update(_x_bits[row * _num_words + word], _z_bits[row * _num_words + word], _signs[row], mask);
+        }
+    }
+};
+
+}  // namespace qsyn::qcir
@@ -0,0 +1,433 @@
+/****************************************************************************
+  PackageName  [ qcir/simulator ]
+  Synopsis     [ Define class StateVector member functions and gate kernels ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include "./statevector.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <utility>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define QSYN_STATEVECTOR_X86 1
+#include <immintrin.h>
+#endif
+
+namespace qsyn::qcir {
+
+namespace {
+
+// kernels acting on fewer amplitude groups than this run on a single thread
+constexpr size_t parallel_threshold = size_t{1} << 12;
+
+constexpr double inv_sqrt2 = std::numbers::sqrt2 / 2;
+
+/**
+ * @brief The qubits a kernel fixes, i.e., its targets and controls, in ascending order.
+ *        The k-th group of amplitudes a kernel acts on is based at `base(k)`, which is
+ *        k with a zero bit inserted at each fixed position.
+ *
+ */
+struct FixedBits {
+    std::array<size_t, 64> positions{};
+    size_t count = 0;
+
+    explicit FixedBits(size_t mask) {
+        for (; mask != 0; mask &= mask - 1) {
+            positions[count++] = static_cast<size_t>(std::countr_zero(mask));
+        }
+    }
+
+    size_t base(size_t k) const {
+        for (size_t i = 0; i < count; ++i) {
+            auto const low = k & ((size_t{1} << positions[i]) - 1);
+            k              = ((k ^ low) << 1) | low;
+        }
+        return k;
+    }
+
+    size_t num_groups(size_t n_qubits) const { return size_t{1} << (n_qubits - count); }
+
+    // if qubit 0 is free, groups 2j and 2j+1 are based at adjacent amplitudes
+    bool is_pairwise_contiguous() const { return count > 0 && positions[0] > 0; }
+};
+
+size_t bit(size_t qubit) { return size_t{1} << qubit; }
+
+struct KernelSet {
+    void (*h)(Amplitude*, size_t, size_t, size_t);
+    void (*phase)(Amplitude*, size_t, size_t, Amplitude);
+    void (*diagonal)(Amplitude*, size_t, size_t, size_t, Amplitude, Amplitude);
+    void (*matrix1)(Amplitude*, size_t, size_t, size_t, Matrix2 const&);
+    void (*matrix2)(Amplitude*, size_t, size_t, size_t, Matrix4 const&);
+    std::string_view name;
+};
+
+//------------------------------------------------------------------------
+//   portable kernels
+//------------------------------------------------------------------------
+
+void h_scalar(Amplitude* data, size_t n_qubits, size_t target, size_t controls) {
+    FixedBits const bits{controls | bit(target)};
+    auto const n_groups = bits.num_groups(n_qubits);
+#pragma omp parallel for schedule(static) if (n_groups >= parallel_threshold)
+    for (size_t k = 0; k < n_groups; ++k) {
+        auto const i0 = bits.base(k) | controls;
+        auto const i1 = i0 | bit(target);
+        auto const a0 = data[i0];
+        auto const a1 = data[i1];
+        data[i0]      = (a0 + a1) * inv_sqrt2;
+        data[i1]      = (a0 - a1) * inv_sqrt2;
+    }
+}
+
+/**
+ * @brief Multiply the amplitudes whose bits in `mask` are all set by `factor`.
+ *
+ */
+void phase_scalar(Amplitude* data, size_t n_qubits, size_t mask, Amplitude factor) {
+    FixedBits const bits{mask};
+    auto const n_groups = bits.num_groups(n_qubits);
+#pragma omp parallel for schedule(static) if (n_groups >= parallel_threshold)
+    for (size_t k = 0; k < n_groups; ++k) {
+        data[bits.base(k) | mask] *= factor;
+    }
+}
+
+void diagonal_scalar(Amplitude* data, size_t n_qubits, size_t target, size_t controls, Amplitude d0, Amplitude d1) {
+    FixedBits const bits{controls | bit(target)};
+    auto const n_groups = bits.num_groups(n_qubits);
+#pragma omp parallel for schedule(static) if (n_groups >= parallel_threshold)
+    for (size_t k = 0; k < n_groups; ++k) {
+        auto const i0 = bits.base(k) | controls;
+        data[i0] *= d0;
+        data[i0 | bit(target)] *= d1;
+    }
+}
+
+void matrix1_scalar(Amplitude* data, size_t n_qubits, size_t target, size_t controls, Matrix2 const& m) {
+    FixedBits const bits{controls | bit(target)};
+    auto const n_groups = bits.num_groups(n_qubits);
+#pragma omp parallel for schedule(static) if (n_groups >= parallel_threshold)
+    for (size_t k = 0; k < n_groups; ++k) {
+        auto const i0 = bits.base(k) | controls;
+        auto const i1 = i0 | bit(target);
+        auto const a0 = data[i0];
+        auto const a1 = data[i1];
+        data[i0]      = m[0] * a0 + m[1] * a1;
+        data[i1]      = m[2] * a0 + m[3] * a1;
+    }
+}
+
+void matrix2_scalar(Amplitude* data, size_t n_qubits, size_t qubit0, size_t qubit1, Matrix4 const& m) {
+    FixedBits const bits{bit(qubit0) | bit(qubit1)};
+    auto const n_groups = bits.num_groups(n_qubits);
+#pragma omp parallel for schedule(static) if (n_groups >= parallel_threshold)
+    for (size_t k = 0; k < n_groups; ++k) {
+        auto const base               = bits.base(k);
+        std::array<size_t, 4> const i = {base, base | bit(qubit0), base | bit(qubit1), base | bit(qubit0) | bit(qubit1)};
+        std::array<Amplitude, 4> const a = {data[i[0]], data[i[1]], data[i[2]], data[i[3]]};
+        for (size_t r = 0; r < 4; ++r) {
+            data[i[r]] = m[4 * r] * a[0] + m[4 * r + 1] * a[1] + m[4 * r + 2] * a[2] + m[4 * r + 3] * a[3];
+        }
+    }
+}
+
+#ifdef QSYN_STATEVECTOR_X86
+
+//------------------------------------------------------------------------
+//   AVX2 kernels
+//   Each register holds two adjacent amplitudes as (re, im, re, im), so the
+//   kernels process two groups at a time and fall back to the portable
+//   kernels when qubit 0 is fixed.
+//------------------------------------------------------------------------
+
+__attribute__((target("avx2,fma"))) inline __m256d load_pair(Amplitude const* p) {
+    return _mm256_loadu_pd(reinterpret_cast<double const*>(p));
+}
+
+__attribute__((target("avx2,fma"))) inline void store_pair(Amplitude* p, __m256d v) {
+    _mm256_storeu_pd(reinterpret_cast<double*>(p), v);
+}
+
+/**
+ * @brief Broadcast a complex number into its real and imaginary registers for `complex_mul`.
+ *
+ */
+struct BroadcastAmplitude {
+    __m256d re;
+    __m256d im;
+};
+
+__attribute__((target("avx2,fma"))) inline BroadcastAmplitude broadcast(Amplitude c) {
+    return {_mm256_set1_pd(c.real()), _mm256_set1_pd(c.imag())};
+}
+
+__attribute__((target("avx2,fma"))) inline __m256d complex_mul(__m256d v, BroadcastAmplitude const& c) {
+    // (a + bi)(c + di) = (ac - bd) + (bc + ad)i; the swapped operand is (b, a)
+    return _mm256_fmaddsub_pd(v, c.re, _mm256_mul_pd(_mm256_permute_pd(v, 0b0101), c.im));
+}
+
+__attribute__((target("avx2,fma"))) void h_avx2(Amplitude* data, size_t n_qubits, size_t target, size_t controls) {
+    FixedBits const bits{controls | bit(target)};
+    if (!bits.is_pairwise_contiguous()) return h_scalar(data, n_qubits, target, controls);
+    auto const n_groups = bits.num_groups(n_qubits);
+    auto const scale    = _mm256_set1_pd(inv_sqrt2);
+#pragma omp parallel for schedule(static) if (n_groups >= parallel_threshold)
+    for (size_t k = 0; k < n_groups; k += 2) {
+        auto const i0 = bits.base(k) | controls;
+        auto const i1 = i0 | bit(target);
+        auto const a0 = load_pair(data + i0);
+        auto const a1 = load_pair(data + i1);
+        store_pair(data + i0, _mm256_mul_pd(_mm256_add_pd(a0, a1), scale));
+        store_pair(data + i1, _mm256_mul_pd(_mm256_sub_pd(a0, a1), scale));
+    }
+}
+
+__attribute__((target("avx2,fma"))) void phase_avx2(Amplitude* data, size_t n_qubits, size_t mask, Amplitude factor) {
+    FixedBits const bits{mask};
+    if (!bits.is_pairwise_contiguous()) return phase_scalar(data, n_qubits, mask, factor);
+    auto const n_groups = bits.num_groups(n_qubits);
+    auto const f        = broadcast(factor);
+#pragma omp parallel for schedule(static) if (n_groups >= parallel_threshold)
+    for (size_t k = 0; k < n_groups; k += 2) {
+        auto const i = bits.base(k) | mask;
+        store_pair(data + i, complex_mul(load_pair(data + i), f));
+    }
+}
+
+__attribute__((target("avx2,fma"))) void diagonal_avx2(Amplitude* data, size_t n_qubits, size_t target, size_t controls, Amplitude d0, Amplitude d1) {
+    FixedBits const bits{controls | bit(target)};
+    if (!bits.is_pairwise_contiguous()) return diagonal_scalar(data, n_qubits, target, controls, d0, d1);
+    auto const n_groups = bits.num_groups(n_qubits);
+    auto const f0       = broadcast(d0);
+    auto const f1       = broadcast(d1);
+#pragma omp parallel for schedule(static) if (n_groups >= parallel_threshold)
+    for (size_t k = 0; k < n_groups; k += 2) {
+        auto const i0 = bits.base(k) | controls;
+        auto const i1 = i0 | bit(target);
+        store_pair(data + i0, complex_mul(load_pair(data + i0), f0));
+        store_pair(data + i1, complex_mul(load_pair(data + i1), f1));
+    }
+}
+
+__attribute__((target("avx2,fma"))) void matrix1_avx2(Amplitude* data, size_t n_qubits, size_t target, size_t controls, Matrix2 const& m) {
+    FixedBits const bits{controls | bit(target)};
+    if (!bits.is_pairwise_contiguous()) return matrix1_scalar(data, n_qubits, target, controls, m);
+    auto const n_groups = bits.num_groups(n_qubits);
+    auto const m00      = broadcast(m[0]);
+    auto const m01      = broadcast(m[1]);
+    auto const m10      = broadcast(m[2]);
+    auto const m11      = broadcast(m[3]);
+#pragma omp parallel for schedule(static) if (n_groups >= parallel_threshold)
+    for (size_t k = 0; k < n_groups; k += 2) {
+        auto const i0 = bits.base(k) | controls;
+        auto const i1 = i0 | bit(target);
+        auto const a0 = load_pair(data + i0);
+        auto const a1 = load_pair(data + i1);
+        store_pair(data + i0, _mm256_add_pd(complex_mul(a0, m00), complex_mul(a1, m01)));
+        store_pair(data + i1, _mm256_add_pd(complex_mul(a0, m10), complex_mul(a1, m11)));
+    }
+}
+
+__attribute__((target("avx2,fma"))) void matrix2_avx2(Amplitude* data, size_t n_qubits, size_t qubit0, size_t qubit1, Matrix4 const& m) {
+    FixedBits const bits{bit(qubit0) | bit(qubit1)};
+    if (!bits.is_pairwise_contiguous()) return matrix2_scalar(data, n_qubits, qubit0, qubit1, m);
+    auto const n_groups = bits.num_groups(n_qubits);
+    std::array<BroadcastAmplitude, 16> mb;
+    for (size_t i = 0; i < 16; ++i) mb[i] = broadcast(m[i]);
+#pragma omp parallel for schedule(static) if (n_groups >= parallel_threshold)
+    for (size_t k = 0; k < n_groups; k += 2) {
+        auto const base               = bits.base(k);
+        std::array<size_t, 4> const i = {base, base | bit(qubit0), base | bit(qubit1), base | bit(qubit0) | bit(qubit1)};
+        __m256d const a[4]            = {load_pair(data + i[0]), load_pair(data + i[1]), load_pair(data + i[2]), load_pair(data + i[3])};
+        for (size_t r = 0; r < 4; ++r) {
+            auto const lo = _mm256_add_pd(complex_mul(a[0], mb[4 * r]), complex_mul(a[1], mb[4 * r + 1]));
+            auto const hi = _mm256_add_pd(complex_mul(a[2], mb[4 * r + 2]), complex_mul(a[3], mb[4 * r + 3]));
+            store_pair(data + i[r], _mm256_add_pd(lo, hi));
+        }
+    }
+}
+
+#endif  // QSYN_STATEVECTOR_X86
+
+KernelSet select_kernels() {
+#ifdef QSYN_STATEVECTOR_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return {h_avx2, phase_avx2, diagonal_avx2, matrix1_avx2, matrix2_avx2, "avx2"};
+    }
+#endif
+    return {h_scalar, phase_scalar, diagonal_scalar, matrix1_scalar, matrix2_scalar, "scalar"};
+}
+
+KernelSet const& kernels() {
+    static KernelSet const selected = select_kernels();
+    return selected;
+}
+
+}  // namespace
+
+std::string_view get_simulation_kernel_name() {
+    return kernels().name;
+}
+
+// SECTION - Class StateVector Member Functions
+
+/**
+ * @brief Construct the state |0...0> of `n_qubits` qubits.
+ *
+ * @param n_qubits
+ */
+StateVector::StateVector(size_t n_qubits) : _num_qubits{n_qubits}, _amplitudes(size_t{1} << n_qubits) {
+    assert(n_qubits < 64);
+    _amplitudes[0] = 1.;
+}
+
+/**
+ * @brief Construct a computational basis state.
+ *
+ * @param n_qubits
+ * @param index the i-th bit is the value of qubit i
+ * @return StateVector
+ */
+StateVector StateVector::basis_state(size_t n_qubits, size_t index) {
+    StateVector state{n_qubits};
+    assert(index < state.size());
+    state._amplitudes[0]     = 0.;
+    state._amplitudes[index] = 1.;
+    return state;
+}
+
+/**
+ * @brief Construct a random normalized state. The amplitudes are drawn from independent
+ *        complex Gaussians block by block, so the state depends on the seed but not on
+ *        the number of threads.
+ *
+ * @param n_qubits
+ * @param seed
+ * @return StateVector
+ */
+StateVector StateVector::random_state(size_t n_qubits, uint64_t seed) {
+    StateVector state{n_qubits};
+    constexpr size_t block_size = size_t{1} << 14;
+    auto const n_blocks         = (state.size() + block_size - 1) / block_size;
+#pragma omp parallel for schedule(dynamic)
+    for (size_t b = 0; b < n_blocks; ++b) {
+        std::seed_seq seq{seed, static_cast<uint64_t>(b)};
+        std::mt19937_64 rng{seq};
+        std::normal_distribution<double> dist;
+        auto const end = std::min(state.size(), (b + 1) * block_size);
+        for (size_t i = b * block_size; i < end; ++i) {
+            auto const re        = dist(rng);
+            state._amplitudes[i] = {re, dist(rng)};
+        }
+    }
+
+    auto const scale = 1. / state.norm();
+#pragma omp parallel for schedule(static) if (state.size() >= parallel_threshold)
+    for (size_t i = 0; i < state.size(); ++i) {
+        state._amplitudes[i] *= scale;
+    }
+    return state;
+}
+
+void StateVector::apply_h(size_t target, size_t controls) {
+    assert(target < _num_qubits && (controls & bit(target)) == 0);
+    kernels().h(_amplitudes.data(), _num_qubits, target, controls);
+}
+
+/**
+ * @brief Apply X, CX, CCX, etc. The amplitudes are only permuted, so the kernel is portable.
+ *
+ */
+void StateVector::apply_x(size_t target, size_t controls) {
+    assert(target < _num_qubits && (controls & bit(target)) == 0);
+    FixedBits const bits{controls | bit(target)};
+    auto const n_groups = bits.num_groups(_num_qubits);
+#pragma omp parallel for schedule(static) if (n_groups >= parallel_threshold)
+    for (size_t k = 0; k < n_groups; ++k) {
+        auto const i0 = bits.base(k) | controls;
+        std::swap(_amplitudes[i0], _amplitudes[i0 | bit(target)]);
+    }
+}
+
+/**
+ * @brief Apply diag(1, factor), e.g., Z, S, T, P, CZ, and CP. Only the amplitudes where the
+ *        target and all controls are |1> are touched.
+ *
+ */
+void StateVector::apply_phase(size_t target, Amplitude factor, size_t controls) {
+    assert(target < _num_qubits && (controls & bit(target)) == 0);
+    kernels().phase(_amplitudes.data(), _num_qubits, controls | bit(target), factor);
+}
+
+/**
+ * @brief Apply diag(d0, d1), e.g., Rz.
+ *
+ */
+void StateVector::apply_diagonal(size_t target, Amplitude d0, Amplitude d1, size_t controls) {
+    assert(target < _num_qubits && (controls & bit(target)) == 0);
+    kernels().diagonal(_amplitudes.data(), _num_qubits, target, controls, d0, d1);
+}
+
+void StateVector::apply_matrix(size_t target, Matrix2 const& matrix, size_t controls) {
+    assert(target < _num_qubits && (controls & bit(target)) == 0);
+    kernels().matrix1(_amplitudes.data(), _num_qubits, target, controls, matrix);
+}
+
+void StateVector::apply_swap(size_t qubit0, size_t qubit1, size_t controls) {
+    assert(qubit0 < _num_qubits && qubit1 < _num_qubits && qubit0 != qubit1);
+    assert((controls & (bit(qubit0) | bit(qubit1))) == 0);
+    FixedBits const bits{controls | bit(qubit0) | bit(qubit1)};
+    auto const n_groups = bits.num_groups(_num_qubits);
+#pragma omp parallel for schedule(static) if (n_groups >= parallel_threshold)
+    for (size_t k = 0; k < n_groups; ++k) {
+        auto const base = bits.base(k) | controls;
+        std::swap(_amplitudes[base | bit(qubit0)], _amplitudes[base | bit(qubit1)]);
+    }
+}
+
+void StateVector::apply_matrix(size_t qubit0, size_t qubit1, Matrix4 const& matrix) {
+    assert(qubit0 < _num_qubits && qubit1 < _num_qubits && qubit0 != qubit1);
+    kernels().matrix2(_amplitudes.data(), _num_qubits, qubit0, qubit1, matrix);
+}
+
+/**
+ * @brief Return the Euclidean norm of the state.
+ *
+ */
+double StateVector::norm() const {
+    double sum = 0.;
+#pragma omp parallel for schedule(static) reduction(+ : sum) if (size() >= parallel_threshold)
+    for (size_t i = 0; i < size(); ++i) {
+        sum += std::norm(_amplitudes[i]);
+    }
+    return std::sqrt(sum);
+}
+
+/**
+ * @brief Return <this|other>.
+ *
+ */
+Amplitude StateVector::inner_product(StateVector const& other) const {
+    assert(size() == other.size());
+    double re = 0.;
+    double im = 0.;
+#pragma omp parallel for schedule(static) reduction(+ : re, im) if (size() >= parallel_threshold)
+    for (size_t i = 0; i < size(); ++i) {
+        auto const product = std::conj(_amplitudes[i]) * other._amplitudes[i];
+        re += product.real();
+        im += product.imag();
+    }
+    return {re, im};
+}
+
+}  // namespace qsyn::qcir
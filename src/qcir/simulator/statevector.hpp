@@ -0,0 +1,66 @@
+/****************************************************************************
+  PackageName  [ qcir/simulator ]
+  Synopsis     [ Define class StateVector structure ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace qsyn::qcir {
+
+using Amplitude = std::complex<double>;
+// row-major 2x2 matrix
+using Matrix2 = std::array<Amplitude, 4>;
+// row-major 4x4 matrix; the first qubit is the lower bit of the row and column indices
+using Matrix4 = std::array<Amplitude, 16>;
+
+/**
+ * @brief The state of n qubits as 2^n amplitudes. Qubit i is bit i of the amplitude index.
+ *        In the gate kernels, `controls` is a bit mask of the control qubits, all of which
+ *        have to be |1> for the gate to act.
+ *
+ */
+class StateVector {
+public:
+    explicit StateVector(size_t n_qubits);
+
+    static StateVector basis_state(size_t n_qubits, size_t index);
+    static StateVector random_state(size_t n_qubits, uint64_t seed);
+
+    size_t get_num_qubits() const { return _num_qubits; }
+    size_t size() const { return _amplitudes.size(); }
+    Amplitude const& operator[](size_t index) const { return _amplitudes[index]; }
+    std::span<Amplitude const> get_amplitudes() const { return _amplitudes; }
+
+    void apply_h(size_t target, size_t controls = 0);
+    void apply_x(size_t target, size_t controls = 0);
+    void apply_phase(size_t target, Amplitude factor, size_t controls = 0);
+    void apply_diagonal(size_t target, Amplitude d0, Amplitude d1, size_t controls = 0);
+    void apply_matrix(size_t target, Matrix2 const& matrix, size_t controls = 0);
+    void apply_swap(size_t qubit0, size_t qubit1, size_t controls = 0);
+    void apply_matrix(size_t qubit0, size_t qubit1, Matrix4 const& matrix);
+
+    double norm() const;
+    Amplitude inner_product(StateVector const& other) const;
+
+private:
+    size_t _num_qubits;
+    std::vector<Amplitude> _amplitudes;
+};
+
+/**
+ * @brief Return the name of the kernel set selected for this machine, e.g., "avx2".
+ *
+ */
+std::string_view get_simulation_kernel_name();
+
+}  // namespace qsyn::qcir
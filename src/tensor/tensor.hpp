@@ -14,7 +14,7 @@
 #include <concepts>
 #include <exception>
 #include <iosfwd>
-#include <unordered_map>
+#include <numeric>
 #include <vector>
 #include <xtensor-blas/xlinalg.hpp>
 #include <xtensor/xadapt.hpp>
@@ -22,6 +22,7 @@
 #include <xtensor/xio.hpp>
 
 #include "./tensor_util.hpp"
+#include "./tensordot_kernels.hpp"
 #include "util/util.hpp"
 
 namespace qsyn::tensor {
@@ -33,6 +34,8 @@ protected:
     using InternalType = xt::xarray<DataType>;
 
 public:
+    using value_type = DT;
+
     // NOTE - the initialization of _tensor must use (...) because {...} is list initialization
     Tensor(xt::nested_initializer_list_t<DT, 0> il) : _tensor(il) { reset_axis_history(); }
     Tensor(xt::nested_initializer_list_t<DT, 1> il) : _tensor(il) { reset_axis_history(); }
@@ -43,6 +46,11 @@ public:
 
     virtual ~Tensor() = default;
 
+    Tensor(Tensor const&)                = default;
+    Tensor(Tensor&&) noexcept            = default;
+    Tensor& operator=(Tensor const&)     = default;
+    Tensor& operator=(Tensor&&) noexcept = default;
+
     Tensor(TensorShape const& shape) : _tensor(shape) { reset_axis_history(); }
     Tensor(TensorShape&& shape) : _tensor(shape) { reset_axis_history(); }
 
@@ -52,7 +60,7 @@ public:
 
     template <typename From>
     requires std::convertible_to<From, InternalType>
-    Tensor(From&& internal) : _tensor(internal) { reset_axis_history(); }
+    Tensor(From&& internal) : _tensor(std::forward<From>(internal)) { reset_axis_history(); }
 
     template <typename... Args>
     DT& operator()(Args const&... args);
@@ -98,6 +106,11 @@ public:
     friend Tensor<U> tensordot(Tensor<U> const& t1, Tensor<U> const& t2,
                                TensorAxisList const& ax1, TensorAxisList const& ax2);
 
+    template <typename U>
+    friend void tensordot_into(Tensor<U> const& t1, Tensor<U> const& t2,
+                               TensorAxisList const& ax1, TensorAxisList const& ax2,
+                               Tensor<U>& result, TensordotWorkspace<U>& workspace);
+
     template <typename U>
     friend Tensor<U> tensor_product_pow(Tensor<U> const& t, size_t n);
 
@@ -116,7 +129,7 @@ public:
 protected:
     friend struct fmt::formatter<Tensor>;
     InternalType _tensor;
-    std::unordered_map<size_t, size_t> _axis_history;
+    std::vector<size_t> _axis_history;  // the new axis of each old axis, or SIZE_MAX if contracted
 };
 
 //------------------------------
@@ -215,19 +228,13 @@ std::vector<size_t> Tensor<DT>::shape() const {
 // reset the tensor axis history to (0, 0), (1, 1), ..., (n-1, n-1)
 template <typename DT>
 void Tensor<DT>::reset_axis_history() {
-    _axis_history.clear();
-    for (size_t i = 0; i < _tensor.dimension(); ++i) {
-        _axis_history.emplace(i, i);
-    }
+    _axis_history.resize(_tensor.dimension());
+    std::iota(_axis_history.begin(), _axis_history.end(), 0);
 }
 
 template <typename DT>
 size_t Tensor<DT>::get_new_axis_id(size_t const& old_id) {
-    if (!_axis_history.contains(old_id)) {
-        return SIZE_MAX;
-    } else {
-        return _axis_history[old_id];
-    }
+    return old_id < _axis_history.size() ? _axis_history[old_id] : SIZE_MAX;
 }
 
 //------------------------------
@@ -297,27 +304,84 @@ double cosine_similarity(Tensor<U> const& t1, Tensor<U> const& t2) {
     return inner_product(t1, t2) / std::sqrt(inner_product(t1, t1) * inner_product(t2, t2));
 }
 
-// tensor-dot two tensors
-// dots the two tensors along the axes in ax1 and ax2
+/**
+ * @brief Tensor-dot two tensors along the axes in ax1 and ax2 into `result`, whose axes are the
+ *        remaining axes of t1 and then those of t2. For BLAS types, the operands are laid out as
+ *        matrices in `workspace`, unless they already are, and multiplied with GEMM directly
+ *        into the storage of `result`, which is reused if its size is unchanged. Hence, a loop
+ *        that alternates between two result tensors and keeps one workspace allocates nothing
+ *        once the sizes settle. Other types, and all types if TENSORDOT_USE_BLAS is false, go
+ *        through xt::linalg::tensordot.
+ *
+ * @param result must not be t1 or t2
+ */
 template <typename U>
-Tensor<U> tensordot(Tensor<U> const& t1, Tensor<U> const& t2,
-                    TensorAxisList const& ax1 = {}, TensorAxisList const& ax2 = {}) {
+void tensordot_into(Tensor<U> const& t1, Tensor<U> const& t2,
+                    TensorAxisList const& ax1, TensorAxisList const& ax2,
+                    Tensor<U>& result, TensordotWorkspace<U>& workspace) {
     if (ax1.size() != ax2.size()) {
         throw std::invalid_argument("The two index orders should contain the same number of indices.");
     }
-    Tensor<U> t        = xt::linalg::tensordot(t1._tensor, t2._tensor, ax1, ax2);
-    size_t tmp_axis_id = 0;
-    t._axis_history.clear();
-    for (size_t i = 0; i < t1._tensor.dimension(); ++i) {
-        if (std::find(ax1.begin(), ax1.end(), i) != ax1.end()) continue;
-        t._axis_history.emplace(i, tmp_axis_id);
-        ++tmp_axis_id;
+    assert(&result != &t1 && &result != &t2);
+
+    auto const dim1 = t1._tensor.dimension();
+    auto const dim2 = t2._tensor.dimension();
+    TensorAxisList free1, free2;
+    for (size_t i = 0; i < dim1; ++i) {
+        if (std::find(ax1.begin(), ax1.end(), i) == ax1.end()) free1.emplace_back(i);
+    }
+    for (size_t i = 0; i < dim2; ++i) {
+        if (std::find(ax2.begin(), ax2.end(), i) == ax2.end()) free2.emplace_back(i);
     }
-    for (size_t i = 0; i < t2._tensor.dimension(); ++i) {
-        if (std::find(ax2.begin(), ax2.end(), i) != ax2.end()) continue;
-        t._axis_history.emplace(i + t1._tensor.dimension(), tmp_axis_id);
-        ++tmp_axis_id;
+
+    auto contracted = false;
+    if constexpr (BlasType<U>) {
+        if (TENSORDOT_USE_BLAS) {
+            size_t m = 1, n = 1, k = 1;
+            TensorShape shape;
+            for (auto const i : free1) {
+                m *= t1._tensor.shape(i);
+                shape.push_back(t1._tensor.shape(i));
+            }
+            for (auto const i : free2) {
+                n *= t2._tensor.shape(i);
+                shape.push_back(t2._tensor.shape(i));
+            }
+            for (size_t i = 0; i < ax1.size(); ++i) {
+                if (t1._tensor.shape(ax1[i]) != t2._tensor.shape(ax2[i])) {
+                    throw std::invalid_argument("The contracted axes should have the same dimensions.");
+                }
+                k *= t1._tensor.shape(ax1[i]);
+            }
+
+            auto const [a, transpose_a] = arrange_as_matrix<U>(t1._tensor.data(), {t1._tensor.shape().data(), dim1}, free1, ax1, workspace.lhs);
+            auto const [b, transpose_b] = arrange_as_matrix<U>(t2._tensor.data(), {t2._tensor.shape().data(), dim2}, ax2, free2, workspace.rhs);
+            result._tensor.resize(shape);
+            gemm(m, n, k, a, transpose_a, b, transpose_b, result._tensor.data());
+            contracted = true;
+        }
+    }
+    if (!contracted) {
+        result._tensor = xt::linalg::tensordot(t1._tensor, t2._tensor, ax1, ax2);
+    }
+
+    result._axis_history.assign(dim1 + dim2, SIZE_MAX);
+    for (size_t i = 0; i < free1.size(); ++i) {
+        result._axis_history[free1[i]] = i;
+    }
+    for (size_t i = 0; i < free2.size(); ++i) {
+        result._axis_history[dim1 + free2[i]] = free1.size() + i;
     }
+}
+
+// tensor-dot two tensors
+// dots the two tensors along the axes in ax1 and ax2
+template <typename U>
+Tensor<U> tensordot(Tensor<U> const& t1, Tensor<U> const& t2,
+                    TensorAxisList const& ax1 = {}, TensorAxisList const& ax2 = {}) {
+    Tensor<U> t(TensorShape{});
+    TensordotWorkspace<U> workspace;
+    tensordot_into(t1, t2, ax1, ax2, t, workspace);
     return t;
 }
 
@@ -9,6 +9,7 @@
 #include <string>
 
 #include "./tensor_mgr.hpp"
+#include "./tensordot_kernels.hpp"
 #include "cli/cli.hpp"
 #include "util/data_structure_manager_common_cmd.hpp"
 #include "util/phase.hpp"
@@ -122,6 +123,24 @@ Command tensor_equivalence_check_cmd(TensorMgr& tensor_mgr) {
             }};
 }
 
+Command tensor_config_cmd() {
+    return {"config",
+            [](ArgumentParser& parser) {
+                parser.description("print or set the tensor settings");
+
+                parser.add_argument<bool>("--blas")
+                    .help("contract tensors with BLAS GEMM (default); if false, use xtensor-blas tensordot instead, e.g., to cross-check the results");
+            },
+            [](ArgumentParser const& parser) {
+                if (parser.parsed("--blas")) {
+                    TENSORDOT_USE_BLAS = parser.get<bool>("--blas");
+                    return CmdExecResult::done;
+                }
+                fmt::println("BLAS tensordot: {}", TENSORDOT_USE_BLAS ? "true" : "false");
+                return CmdExecResult::done;
+            }};
+}
+
 Command tensor_cmd(TensorMgr& tensor_mgr) {
     using namespace dvlab::utils;
     auto cmd = mgr_root_cmd(tensor_mgr);
@@ -131,6 +150,7 @@ Command tensor_cmd(TensorMgr& tensor_mgr) {
     cmd.add_subcommand(mgr_delete_cmd(tensor_mgr));
     cmd.add_subcommand(tensor_adjoint_cmd(tensor_mgr));
     cmd.add_subcommand(tensor_equivalence_check_cmd(tensor_mgr));
+    cmd.add_subcommand(tensor_config_cmd());
 
     return cmd;
 }
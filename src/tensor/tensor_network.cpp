@@ -0,0 +1,429 @@
+/****************************************************************************
+  PackageName  [ tensor ]
+  Synopsis     [ Define tensor network contraction planners ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include "./tensor_network.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <array>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <ranges>
+#include <unordered_map>
+
+namespace qsyn::tensor {
+
+namespace {
+
+using Edge      = TensorNetwork::Edge;
+using EdgeList  = std::vector<Edge>;  // sorted
+using StepList  = std::vector<std::pair<size_t, size_t>>;
+using Generator = std::mt19937_64;
+
+/**
+ * @brief A tensor alive during planning, identified by its number in the plan
+ *
+ */
+struct PlanNode {
+    size_t id;
+    EdgeList edges;
+};
+
+/**
+ * @brief The edges left after contracting two tensors. Every edge is carried by at most two
+ *        tensors, so the shared edges are exactly those that disappear.
+ *
+ */
+EdgeList contracted_edges(EdgeList const& a, EdgeList const& b) {
+    EdgeList result;
+    result.reserve(a.size() + b.size());
+    std::ranges::set_symmetric_difference(a, b, std::back_inserter(result));
+    return result;
+}
+
+double num_entries(size_t rank) { return std::ldexp(1., static_cast<int>(rank)); }
+
+std::vector<PlanNode> get_input_nodes(TensorNetwork const& network) {
+    std::vector<PlanNode> nodes;
+    nodes.reserve(network.get_num_tensors());
+    for (size_t i = 0; i < network.get_num_tensors(); ++i) {
+        auto edges = network.get_edges(i);
+        std::ranges::sort(edges);
+        nodes.push_back({i, std::move(edges)});
+    }
+    return nodes;
+}
+
+/**
+ * @brief Append steps that contract the nodes one by one in order
+ *
+ * @return the number of the contracted tensor
+ */
+size_t plan_sequential(std::vector<PlanNode> const& nodes, StepList& steps, size_t num_inputs) {
+    auto result = nodes.front().id;
+    for (size_t i = 1; i < nodes.size(); ++i) {
+        steps.emplace_back(result, nodes[i].id);
+        result = num_inputs + steps.size() - 1;
+    }
+    return result;
+}
+
+/**
+ * @brief Append steps that greedily contract the pair of connected tensors that shrinks the
+ *        total size the most. Disconnected parts are joined by outer products at the end,
+ *        smallest first. With a positive temperature, the scores are perturbed by Gumbel
+ *        noise relative to the operand sizes so that repeated runs explore different orders.
+ *
+ * @return the number of the contracted tensor
+ */
+size_t plan_greedy(std::vector<PlanNode> nodes, StepList& steps, size_t num_inputs, double temperature, Generator& gen) {
+    // score, then a sequence number to keep the order deterministic among ties
+    using Candidate = std::tuple<double, size_t, size_t, size_t>;  // (score, seq, lhs, rhs), indices into `nodes`
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> candidates;
+    std::vector<bool> alive(nodes.size(), true);
+    std::unordered_map<Edge, std::pair<size_t, size_t>> owners;  // edge -> (node, node or SIZE_MAX)
+    std::uniform_real_distribution<double> uniform{std::nextafter(0., 1.), 1.};
+    size_t seq = 0;
+
+    auto const push_candidate = [&](size_t a, size_t b) {
+        auto const& lhs   = nodes[a].edges;
+        auto const& rhs   = nodes[b].edges;
+        auto const result = contracted_edges(lhs, rhs).size();
+        auto const input  = num_entries(lhs.size()) + num_entries(rhs.size());
+        auto score        = num_entries(result) - input;
+        if (temperature > 0.) score -= temperature * input * -std::log(-std::log(uniform(gen)));
+        candidates.emplace(score, seq++, a, b);
+    };
+    auto const add_owner = [&](size_t node, Edge edge) {
+        auto [it, inserted] = owners.try_emplace(edge, node, SIZE_MAX);
+        if (inserted) return;
+        it->second.second = node;
+        push_candidate(it->second.first, node);
+    };
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        for (auto const edge : nodes[i].edges) add_owner(i, edge);
+    }
+
+    auto const merge = [&](size_t a, size_t b) {
+        steps.emplace_back(nodes[a].id, nodes[b].id);
+        auto edges = contracted_edges(nodes[a].edges, nodes[b].edges);
+        alive[a] = alive[b] = false;
+        for (auto const edge : nodes[a].edges) {
+            if (!std::ranges::binary_search(edges, edge)) owners.erase(edge);
+        }
+        for (auto const edge : nodes[b].edges) {
+            if (!std::ranges::binary_search(edges, edge)) owners.erase(edge);
+        }
+        auto const c = nodes.size();
+        nodes.push_back({num_inputs + steps.size() - 1, std::move(edges)});
+        alive.emplace_back(true);
+        for (auto const edge : nodes[c].edges) {
+            // the other end of the edge becomes a candidate partner of the new node
+            auto& [first, second] = owners.at(edge);
+            auto& self            = (first == a || first == b) ? first : second;
+            auto const other      = (first == a || first == b) ? second : first;
+            self                  = c;
+            if (other != SIZE_MAX) push_candidate(other, c);
+        }
+        return c;
+    };
+
+    size_t num_alive = nodes.size();
+    while (num_alive > 1 && !candidates.empty()) {
+        auto const a = std::get<2>(candidates.top());
+        auto const b = std::get<3>(candidates.top());
+        candidates.pop();
+        if (!alive[a] || !alive[b]) continue;
+        merge(a, b);
+        --num_alive;
+    }
+
+    // NOTE - outer products between disconnected parts
+    using Part = std::tuple<size_t, size_t>;  // (rank, index into `nodes`)
+    std::priority_queue<Part, std::vector<Part>, std::greater<>> parts;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (alive[i]) parts.emplace(nodes[i].edges.size(), i);
+    }
+    while (parts.size() > 1) {
+        auto const a = std::get<1>(parts.top());
+        parts.pop();
+        auto const b = std::get<1>(parts.top());
+        parts.pop();
+        auto const c = merge(a, b);
+        parts.emplace(nodes[c].edges.size(), c);
+    }
+    return nodes[std::get<1>(parts.top())].id;
+}
+
+/**
+ * @brief Split the nodes into two balanced halves with few edges in between, by growing one
+ *        half from a random node and refining the cut with Fiduccia-Mattheyses passes.
+ *
+ * @param imbalance the allowed deviation of each half from half of the nodes, relative to the number of nodes
+ * @return whether each node goes to the second half
+ */
+std::vector<bool> bisect(std::vector<PlanNode> const& nodes, double imbalance, Generator& gen) {
+    auto const n = nodes.size();
+
+    // NOTE - adjacency among the nodes; parallel edges appear multiple times
+    std::vector<std::vector<size_t>> neighbors(n);
+    {
+        std::unordered_map<Edge, size_t> first_owner;
+        for (size_t i = 0; i < n; ++i) {
+            for (auto const edge : nodes[i].edges) {
+                auto const [it, inserted] = first_owner.try_emplace(edge, i);
+                if (inserted) continue;
+                neighbors[it->second].emplace_back(i);
+                neighbors[i].emplace_back(it->second);
+            }
+        }
+    }
+
+    auto const max_size = std::max(static_cast<size_t>(std::ceil(n * (0.5 + imbalance))), (n + 1) / 2);
+    auto const min_size = n - max_size;
+
+    // NOTE - grow the second half by BFS
+    std::vector<bool> side(n, false);
+    {
+        std::vector<size_t> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::shuffle(order, gen);
+        std::vector<bool> visited(n, false);
+        std::queue<size_t> queue;
+        size_t grown = 0;
+        for (auto const seed : order) {
+            if (grown >= n / 2) break;
+            if (visited[seed]) continue;
+            visited[seed] = true;
+            queue.push(seed);
+            while (!queue.empty() && grown < n / 2) {
+                auto const v = queue.front();
+                queue.pop();
+                side[v] = true;
+                ++grown;
+                for (auto const u : neighbors[v]) {
+                    if (!visited[u]) {
+                        visited[u] = true;
+                        queue.push(u);
+                    }
+                }
+            }
+            queue = {};
+        }
+    }
+
+    std::array<size_t, 2> sizes{static_cast<size_t>(std::ranges::count(side, false)), static_cast<size_t>(std::ranges::count(side, true))};
+    std::vector<long> gain(n, 0);  // decrease of the cut if the node switches sides
+    auto const compute_gains = [&]() {
+        for (size_t v = 0; v < n; ++v) {
+            gain[v] = 0;
+            for (auto const u : neighbors[v]) gain[v] += side[u] != side[v] ? 1 : -1;
+        }
+    };
+
+    // NOTE - Fiduccia-Mattheyses refinement
+    constexpr size_t max_passes = 4;
+    for (size_t pass = 0; pass < max_passes; ++pass) {
+        compute_gains();
+        std::vector<bool> locked(n, false);
+        std::array<std::priority_queue<std::pair<long, size_t>>, 2> heaps;
+        for (size_t v = 0; v < n; ++v) heaps[side[v]].emplace(gain[v], v);
+
+        auto const top = [&](bool from) -> std::optional<size_t> {
+            auto& heap = heaps[from];
+            while (!heap.empty() && (locked[heap.top().second] || heap.top().first != gain[heap.top().second])) heap.pop();
+            if (heap.empty() || sizes[from] <= std::max<size_t>(min_size, 1)) return std::nullopt;
+            return heap.top().second;
+        };
+
+        std::vector<size_t> moves;
+        long cut_change = 0, best_change = 0;
+        size_t best_num_moves = 0;
+        while (true) {
+            auto const from_first  = top(false);
+            auto const from_second = top(true);
+            if (!from_first && !from_second) break;
+            auto const v = (!from_second || (from_first && gain[*from_first] >= gain[*from_second])) ? *from_first : *from_second;
+
+            cut_change -= gain[v];
+            locked[v] = true;
+            --sizes[side[v]];
+            side[v] = !side[v];
+            ++sizes[side[v]];
+            moves.emplace_back(v);
+            for (auto const u : neighbors[v]) {
+                if (locked[u]) continue;
+                gain[u] += side[u] == side[v] ? -2 : 2;
+                heaps[side[u]].emplace(gain[u], u);
+            }
+            if (cut_change < best_change && sizes[0] <= max_size && sizes[1] <= max_size) {
+                best_change    = cut_change;
+                best_num_moves = moves.size();
+            }
+        }
+        // roll back the moves after the best cut
+        for (auto const v : moves | std::views::drop(best_num_moves)) {
+            --sizes[side[v]];
+            side[v] = !side[v];
+            ++sizes[side[v]];
+        }
+        if (best_change == 0) break;
+    }
+
+    return side;
+}
+
+/**
+ * @brief Append steps that contract the nodes by recursive bisection: each half is contracted
+ *        on its own and the two results are contracted last. Small parts are planned greedily.
+ *
+ * @return the number of the contracted tensor
+ */
+size_t plan_partition(std::vector<PlanNode> nodes, StepList& steps, size_t num_inputs, size_t leaf_size, double imbalance, Generator& gen) {
+    if (nodes.size() <= leaf_size) return plan_greedy(std::move(nodes), steps, num_inputs, 0., gen);
+
+    auto const side = bisect(nodes, imbalance, gen);
+    std::array<std::vector<PlanNode>, 2> halves;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        halves[side[i]].emplace_back(std::move(nodes[i]));
+    }
+    if (halves[0].empty() || halves[1].empty()) {
+        return plan_greedy(std::move(halves[halves[0].empty() ? 1 : 0]), steps, num_inputs, 0., gen);
+    }
+    auto const lhs = plan_partition(std::move(halves[0]), steps, num_inputs, leaf_size, imbalance, gen);
+    auto const rhs = plan_partition(std::move(halves[1]), steps, num_inputs, leaf_size, imbalance, gen);
+    steps.emplace_back(lhs, rhs);
+    return num_inputs + steps.size() - 1;
+}
+
+}  // namespace
+
+std::string get_contraction_strategy_str(ContractionStrategy const& strategy) {
+    switch (strategy) {
+        case ContractionStrategy::greedy:
+            return "greedy";
+        case ContractionStrategy::partition:
+            return "partition";
+        case ContractionStrategy::best:
+            return "best";
+        case ContractionStrategy::sequential:
+        default:
+            return "sequential";
+    }
+}
+
+std::optional<ContractionStrategy> get_contraction_strategy(std::string const& str) {
+    if (str == "sequential") return ContractionStrategy::sequential;
+    if (str == "greedy") return ContractionStrategy::greedy;
+    if (str == "partition") return ContractionStrategy::partition;
+    if (str == "best") return ContractionStrategy::best;
+
+    return std::nullopt;
+}
+
+/**
+ * @brief Estimate the cost of contracting the network in the given steps
+ *
+ * @param network
+ * @param steps
+ * @return ContractionCost
+ */
+ContractionCost estimate_contraction_cost(TensorNetwork const& network, std::vector<std::pair<size_t, size_t>> const& steps) {
+    auto nodes = get_input_nodes(network);
+
+    ContractionCost cost;
+    double memory = 0.;
+    for (auto const& node : nodes) {
+        memory += num_entries(node.edges.size());
+        cost.max_rank = std::max(cost.max_rank, node.edges.size());
+    }
+    cost.peak_memory = memory;
+
+    for (auto const& [a, b] : steps) {
+        auto const& lhs   = nodes[a].edges;
+        auto const& rhs   = nodes[b].edges;
+        auto result       = contracted_edges(lhs, rhs);
+        auto const shared = (lhs.size() + rhs.size() - result.size()) / 2;
+
+        cost.flops += num_entries(lhs.size() + rhs.size() - shared);
+        cost.max_rank    = std::max(cost.max_rank, result.size());
+        memory          += num_entries(result.size());
+        cost.peak_memory = std::max(cost.peak_memory, memory);
+        memory -= num_entries(lhs.size()) + num_entries(rhs.size());
+
+        nodes.push_back({nodes.size(), std::move(result)});
+    }
+    return cost;
+}
+
+/**
+ * @brief Find an order to contract the network. The greedy and partition strategies try
+ *        `num_trials` randomized runs in parallel; the best strategy tries all of them.
+ *        The plan with the lowest peak memory wins, and then the one with the fewest FLOPs.
+ *
+ * @param network
+ * @param strategy
+ * @param num_trials
+ * @return ContractionPlan
+ */
+ContractionPlan find_contraction_plan(TensorNetwork const& network, ContractionStrategy strategy, size_t num_trials) {
+    auto const num_inputs = network.get_num_tensors();
+    auto const inputs     = get_input_nodes(network);
+    if (num_inputs <= 1) return {.steps = {}, .cost = estimate_contraction_cost(network, {})};
+
+    // NOTE - (strategy, trial) pairs to run
+    std::vector<std::pair<ContractionStrategy, size_t>> runs;
+    auto const add_runs = [&](ContractionStrategy s) {
+        auto const count = s == ContractionStrategy::sequential ? 1 : std::max<size_t>(num_trials, 1);
+        for (size_t trial = 0; trial < count; ++trial) runs.emplace_back(s, trial);
+    };
+    if (strategy == ContractionStrategy::best) {
+        add_runs(ContractionStrategy::sequential);
+        add_runs(ContractionStrategy::greedy);
+        add_runs(ContractionStrategy::partition);
+    } else {
+        add_runs(strategy);
+    }
+
+    std::vector<ContractionPlan> plans(runs.size());
+#pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < runs.size(); ++i) {
+        auto const [s, trial] = runs[i];
+        Generator gen{trial};
+        auto& steps = plans[i].steps;
+        steps.reserve(num_inputs - 1);
+        switch (s) {
+            case ContractionStrategy::greedy:
+                // the first trial is the plain greedy order
+                plan_greedy(inputs, steps, num_inputs, trial == 0 ? 0. : 0.05 * static_cast<double>(trial), gen);
+                break;
+            case ContractionStrategy::partition:
+                plan_partition(inputs, steps, num_inputs, 8 + 8 * (trial % 4), 0.05 + 0.05 * static_cast<double>(trial % 5), gen);
+                break;
+            case ContractionStrategy::sequential:
+            default:
+                plan_sequential(inputs, steps, num_inputs);
+                break;
+        }
+        plans[i].cost = estimate_contraction_cost(network, steps);
+    }
+
+    size_t best = 0;
+    for (size_t i = 0; i < plans.size(); ++i) {
+        spdlog::debug("Contraction plan {:<10} #{}: {:.3g} FLOPs, peak memory {:.3g} entries, max rank {}",
+                      get_contraction_strategy_str(runs[i].first), runs[i].second,
+                      plans[i].cost.flops, plans[i].cost.peak_memory, plans[i].cost.max_rank);
+        if (plans[i].cost < plans[best].cost) best = i;
+    }
+    return std::move(plans[best]);
+}
+
+}  // namespace qsyn::tensor
@@ -0,0 +1,134 @@
+/****************************************************************************
+  PackageName  [ tensor ]
+  Synopsis     [ Define tensor networks and their contraction planners ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "./tensor_util.hpp"
+#include "./tensordot_kernels.hpp"
+
+extern bool stop_requested();
+
+namespace qsyn::tensor {
+
+/**
+ * @brief The shape of a network of qubit tensors, i.e., tensors whose axes all have dimension 2.
+ *        The axes are labelled by edges. An edge carried by two tensors is contracted, and an
+ *        edge carried by only one tensor is an open axis of the network.
+ *
+ */
+class TensorNetwork {
+public:
+    using Edge = size_t;
+
+    size_t add_tensor(std::vector<Edge> edges) {
+        _tensors.emplace_back(std::move(edges));
+        return _tensors.size() - 1;
+    }
+
+    size_t get_num_tensors() const { return _tensors.size(); }
+    std::vector<Edge> const& get_edges(size_t id) const { return _tensors[id]; }
+
+private:
+    std::vector<std::vector<Edge>> _tensors;
+};
+
+enum class ContractionStrategy {
+    sequential,  // contract the tensors one by one in the order they are added
+    greedy,
+    partition,
+    best
+};
+
+std::string get_contraction_strategy_str(ContractionStrategy const& strategy);
+std::optional<ContractionStrategy> get_contraction_strategy(std::string const& str);
+
+struct ContractionCost {
+    double flops       = 0.;  // number of multiply-adds
+    double peak_memory = 0.;  // the largest number of entries held at the same time
+    size_t max_rank    = 0;   // the largest number of axes of a tensor in the process
+
+    bool operator<(ContractionCost const& other) const {
+        return std::tie(peak_memory, flops) < std::tie(other.peak_memory, other.flops);
+    }
+};
+
+/**
+ * @brief An order to contract a tensor network. The input tensors are numbered 0 to n-1,
+ *        and the tensor produced by the i-th step is numbered n+i.
+ *        A plan contracts the network down to a single tensor.
+ *
+ */
+struct ContractionPlan {
+    std::vector<std::pair<size_t, size_t>> steps;
+    ContractionCost cost;
+};
+
+ContractionCost estimate_contraction_cost(TensorNetwork const& network, std::vector<std::pair<size_t, size_t>> const& steps);
+
+ContractionPlan find_contraction_plan(TensorNetwork const& network, ContractionStrategy strategy, size_t num_trials = 8);
+
+/**
+ * @brief Contract a tensor network following the plan
+ *
+ * @tparam T the tensor type
+ * @param tensors the tensors of the network, whose axes are in the order of `network.get_edges(i)`
+ * @param network
+ * @param plan
+ * @return the contracted tensor and the open edges labelling its axes, or std::nullopt if interrupted
+ */
+template <typename T>
+std::optional<std::pair<T, std::vector<TensorNetwork::Edge>>> contract(std::vector<T> tensors, TensorNetwork const& network, ContractionPlan const& plan) {
+    using Edge   = TensorNetwork::Edge;
+    auto const n = network.get_num_tensors();
+    assert(tensors.size() == n && n > 0);
+    assert(plan.steps.size() + 1 == n);
+
+    std::vector<std::vector<Edge>> edges(n + plan.steps.size());
+    for (size_t i = 0; i < n; ++i) {
+        edges[i] = network.get_edges(i);
+    }
+    tensors.resize(n + plan.steps.size());
+
+    TensordotWorkspace<typename T::value_type> workspace;
+    for (size_t k = 0; k < plan.steps.size(); ++k) {
+        if (stop_requested()) return std::nullopt;
+        auto const [a, b] = plan.steps[k];
+
+        TensorAxisList ax1, ax2;
+        auto& result_edges = edges[n + k];
+        for (size_t i = 0; i < edges[a].size(); ++i) {
+            auto const it = std::ranges::find(edges[b], edges[a][i]);
+            if (it == edges[b].end()) {
+                result_edges.emplace_back(edges[a][i]);
+            } else {
+                ax1.emplace_back(i);
+                ax2.emplace_back(std::distance(edges[b].begin(), it));
+            }
+        }
+        for (size_t j = 0; j < edges[b].size(); ++j) {
+            if (std::ranges::find(ax2, j) == ax2.end()) result_edges.emplace_back(edges[b][j]);
+        }
+
+        tensordot_into(tensors[a], tensors[b], ax1, ax2, tensors[n + k], workspace);
+        // release the operands as soon as possible to keep the peak memory as planned
+        tensors[a] = T{};
+        tensors[b] = T{};
+    }
+
+    return std::make_pair(std::move(tensors.back()), std::move(edges.back()));
+}
+
+}  // namespace qsyn::tensor
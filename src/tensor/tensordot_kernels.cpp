@@ -0,0 +1,101 @@
+/****************************************************************************
+  PackageName  [ tensor ]
+  Synopsis     [ Define the GEMM kernels of tensordot ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include "./tensordot_kernels.hpp"
+
+#include <limits>
+
+// the Fortran interface, which every BLAS implementation exports
+extern "C" {
+void sgemm_(char const* transa, char const* transb, int const* m, int const* n, int const* k,
+            float const* alpha, float const* a, int const* lda, float const* b, int const* ldb,
+            float const* beta, float* c, int const* ldc);
+void dgemm_(char const* transa, char const* transb, int const* m, int const* n, int const* k,
+            double const* alpha, double const* a, int const* lda, double const* b, int const* ldb,
+            double const* beta, double* c, int const* ldc);
+void cgemm_(char const* transa, char const* transb, int const* m, int const* n, int const* k,
+            std::complex<float> const* alpha, std::complex<float> const* a, int const* lda, std::complex<float> const* b, int const* ldb,
+            std::complex<float> const* beta, std::complex<float>* c, int const* ldc);
+void zgemm_(char const* transa, char const* transb, int const* m, int const* n, int const* k,
+            std::complex<double> const* alpha, std::complex<double> const* a, int const* lda, std::complex<double> const* b, int const* ldb,
+            std::complex<double> const* beta, std::complex<double>* c, int const* ldc);
+}
+
+namespace qsyn::tensor {
+
+bool TENSORDOT_USE_BLAS = true;
+
+namespace {
+
+constexpr auto blas_int_max = static_cast<size_t>(std::numeric_limits<int>::max());
+
+template <typename T>
+void gemm_naive(size_t m, size_t n, size_t k, T const* a, bool transpose_a, T const* b, bool transpose_b, T* c) {
+#pragma omp parallel for schedule(static)
+    for (std::ptrdiff_t i = 0; i < static_cast<std::ptrdiff_t>(m); ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            T sum = 0;
+            for (size_t l = 0; l < k; ++l) {
+                sum += a[transpose_a ? l * m + i : i * k + l] * b[transpose_b ? j * k + l : l * n + j];
+            }
+            c[i * n + j] = sum;
+        }
+    }
+}
+
+/**
+ * @brief Call a BLAS GEMM on row-major matrices. BLAS is column-major, where the storage of a
+ *        row-major matrix is its transpose, so this computes C^T = op(B)^T op(A)^T instead.
+ *        The rows of C are split into chunks that fit in the 32-bit BLAS interface.
+ *
+ */
+template <typename T, typename BlasGemm>
+void gemm_blas(BlasGemm blas_gemm, size_t m, size_t n, size_t k, T const* a, bool transpose_a, T const* b, bool transpose_b, T* c) {
+    if (m == 0 || n == 0) return;
+    if (k == 0) {
+        std::fill_n(c, m * n, T{0});
+        return;
+    }
+    if (n > blas_int_max || k > blas_int_max || (transpose_a && m > blas_int_max)) {
+        gemm_naive(m, n, k, a, transpose_a, b, transpose_b, c);
+        return;
+    }
+
+    char const trans_a = transpose_a ? 'T' : 'N';
+    char const trans_b = transpose_b ? 'T' : 'N';
+    auto const n_int   = static_cast<int>(n);
+    auto const k_int   = static_cast<int>(k);
+    auto const lda     = static_cast<int>(transpose_a ? m : k);
+    auto const ldb     = transpose_b ? k_int : n_int;
+    T const one        = 1;
+    T const zero       = 0;
+    for (size_t row = 0; row < m; row += blas_int_max) {
+        auto const n_rows = static_cast<int>(std::min(m - row, blas_int_max));
+        auto const* a_row = transpose_a ? a + row : a + row * k;
+        blas_gemm(&trans_b, &trans_a, &n_int, &n_rows, &k_int, &one, b, &ldb, a_row, &lda, &zero, c + row * n, &n_int);
+    }
+}
+
+}  // namespace
+
+void gemm(size_t m, size_t n, size_t k, float const* a, bool transpose_a, float const* b, bool transpose_b, float* c) {
+    gemm_blas(sgemm_, m, n, k, a, transpose_a, b, transpose_b, c);
+}
+
+void gemm(size_t m, size_t n, size_t k, double const* a, bool transpose_a, double const* b, bool transpose_b, double* c) {
+    gemm_blas(dgemm_, m, n, k, a, transpose_a, b, transpose_b, c);
+}
+
+void gemm(size_t m, size_t n, size_t k, std::complex<float> const* a, bool transpose_a, std::complex<float> const* b, bool transpose_b, std::complex<float>* c) {
+    gemm_blas(cgemm_, m, n, k, a, transpose_a, b, transpose_b, c);
+}
+
+void gemm(size_t m, size_t n, size_t k, std::complex<double> const* a, bool transpose_a, std::complex<double> const* b, bool transpose_b, std::complex<double>* c) {
+    gemm_blas(zgemm_, m, n, k, a, transpose_a, b, transpose_b, c);
+}
+
+}  // namespace qsyn::tensor
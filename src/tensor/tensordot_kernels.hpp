@@ -0,0 +1,196 @@
+/****************************************************************************
+  PackageName  [ tensor ]
+  Synopsis     [ Define the axis permutation and GEMM kernels of tensordot ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <complex>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace qsyn::tensor {
+
+extern bool TENSORDOT_USE_BLAS;  // if false, tensordot always calls xt::linalg::tensordot
+
+template <typename T>
+concept BlasType = std::same_as<T, float> || std::same_as<T, double> ||
+                   std::same_as<T, std::complex<float>> || std::same_as<T, std::complex<double>>;
+
+/**
+ * @brief Compute C = op(A) * op(B) with BLAS, where all matrices are row-major, C is m x n,
+ *        and op(A) and op(B) are m x k and k x n. If `transpose_a` is set, A is stored as
+ *        its k x m transpose; ditto for `transpose_b`.
+ *
+ */
+void gemm(size_t m, size_t n, size_t k, float const* a, bool transpose_a, float const* b, bool transpose_b, float* c);
+void gemm(size_t m, size_t n, size_t k, double const* a, bool transpose_a, double const* b, bool transpose_b, double* c);
+void gemm(size_t m, size_t n, size_t k, std::complex<float> const* a, bool transpose_a, std::complex<float> const* b, bool transpose_b, std::complex<float>* c);
+void gemm(size_t m, size_t n, size_t k, std::complex<double> const* a, bool transpose_a, std::complex<double> const* b, bool transpose_b, std::complex<double>* c);
+
+/**
+ * @brief The buffers for the permuted operands of tensordot. Reusing a workspace across
+ *        calls of the same sizes, e.g., one per gate in a circuit, avoids reallocations.
+ *
+ */
+template <typename T>
+struct TensordotWorkspace {
+    std::vector<T> lhs;
+    std::vector<T> rhs;
+};
+
+namespace detail {
+
+// the side length of the tiles of the transpose kernel; a tile of complex<double> takes 4 KiB
+constexpr size_t transpose_tile_size        = 16;
+constexpr size_t permute_parallel_threshold = size_t{1} << 16;
+
+/**
+ * @brief Merge the axes that stay adjacent under the permutation.
+ *
+ * @return the merged shape in the source order and the merged permutation
+ */
+inline std::pair<std::vector<size_t>, std::vector<size_t>> merge_axes(std::span<size_t const> shape, std::span<size_t const> perm) {
+    // groups of consecutive source axes, in the destination order
+    std::vector<std::pair<size_t, size_t>> groups;  // (first source axis, merged dimension)
+    for (size_t i = 0; i < perm.size(); ++i) {
+        if (i > 0 && perm[i] == perm[i - 1] + 1) {
+            groups.back().second *= shape[perm[i]];
+        } else {
+            groups.emplace_back(perm[i], shape[perm[i]]);
+        }
+    }
+
+    std::vector<size_t> order(groups.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, {}, [&groups](size_t g) { return groups[g].first; });
+
+    std::vector<size_t> merged_shape(groups.size());
+    std::vector<size_t> merged_perm(groups.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        merged_shape[i]       = groups[order[i]].second;
+        merged_perm[order[i]] = i;
+    }
+    return {merged_shape, merged_perm};
+}
+
+}  // namespace detail
+
+/**
+ * @brief Permute the axes of a row-major tensor: axis i of `dst` is axis `perm[i]` of `src`.
+ *        Axes that stay adjacent are merged first. If the innermost axis stays innermost,
+ *        contiguous runs are copied; otherwise, the innermost axes of the source and the
+ *        destination are transposed tile by tile so that both the reads and the writes stay
+ *        in cache.
+ *
+ */
+template <typename T>
+void permute_axes(T const* src, T* dst, std::span<size_t const> shape, std::span<size_t const> perm) {
+    auto const size         = std::accumulate(shape.begin(), shape.end(), size_t{1}, std::multiplies<>{});
+    auto const merged       = detail::merge_axes(shape, perm);
+    auto const& dims        = merged.first;
+    auto const& merged_perm = merged.second;
+    auto const rank         = dims.size();
+    if (rank <= 1) {
+        std::copy_n(src, size, dst);
+        return;
+    }
+
+    std::vector<size_t> src_strides(rank, 1);
+    for (size_t i = rank - 1; i > 0; --i) src_strides[i - 1] = src_strides[i] * dims[i];
+    std::vector<size_t> dst_dims(rank), dst_strides(rank, 1);
+    for (size_t i = 0; i < rank; ++i) dst_dims[i] = dims[merged_perm[i]];
+    for (size_t i = rank - 1; i > 0; --i) dst_strides[i - 1] = dst_strides[i] * dst_dims[i];
+    // the destination stride of each source axis
+    std::vector<size_t> dst_strides_by_src(rank);
+    for (size_t i = 0; i < rank; ++i) dst_strides_by_src[merged_perm[i]] = dst_strides[i];
+
+    auto const src_inner = rank - 1;
+    auto const dst_inner = merged_perm[rank - 1];
+    // the axes other than the innermost ones are iterated over by a linear index
+    std::vector<size_t> outer_axes;
+    for (size_t i = 0; i < rank; ++i) {
+        if (i != src_inner && i != dst_inner) outer_axes.emplace_back(i);
+    }
+    auto const get_bases = [&](size_t outer) {
+        size_t src_base = 0, dst_base = 0;
+        for (auto it = outer_axes.rbegin(); it != outer_axes.rend(); ++it) {
+            auto const index = outer % dims[*it];
+            outer /= dims[*it];
+            src_base += index * src_strides[*it];
+            dst_base += index * dst_strides_by_src[*it];
+        }
+        return std::pair{src_base, dst_base};
+    };
+
+    if (src_inner == dst_inner) {
+        auto const run    = dims[src_inner];
+        auto const n_runs = static_cast<std::ptrdiff_t>(size / run);
+#pragma omp parallel for schedule(static) if (size >= detail::permute_parallel_threshold)
+        for (std::ptrdiff_t outer = 0; outer < n_runs; ++outer) {
+            auto const [src_base, dst_base] = get_bases(static_cast<size_t>(outer));
+            std::copy_n(src + src_base, run, dst + dst_base);
+        }
+        return;
+    }
+
+    auto const src_len  = dims[src_inner];
+    auto const dst_len  = dims[dst_inner];
+    auto const src_step = src_strides[dst_inner];         // the source stride along the destination-innermost axis
+    auto const dst_step = dst_strides_by_src[src_inner];  // the destination stride along the source-innermost axis
+    auto const n_outer  = static_cast<std::ptrdiff_t>(size / (src_len * dst_len));
+#pragma omp parallel for schedule(static) if (size >= detail::permute_parallel_threshold)
+    for (std::ptrdiff_t outer = 0; outer < n_outer; ++outer) {
+        auto const [src_base, dst_base] = get_bases(static_cast<size_t>(outer));
+        for (size_t ib = 0; ib < src_len; ib += detail::transpose_tile_size) {
+            auto const i_end = std::min(ib + detail::transpose_tile_size, src_len);
+            for (size_t jb = 0; jb < dst_len; jb += detail::transpose_tile_size) {
+                auto const j_end = std::min(jb + detail::transpose_tile_size, dst_len);
+                for (size_t i = ib; i < i_end; ++i) {
+                    for (size_t j = jb; j < j_end; ++j) {
+                        dst[dst_base + i * dst_step + j] = src[src_base + j * src_step + i];
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Lay out a row-major tensor as a matrix whose rows and columns are indexed by the axes
+ *        in `rows` and `cols`. The data is used in place if the axes are already in the order
+ *        of the matrix or of its transpose; otherwise, it is permuted into `buffer`.
+ *
+ * @return the data of the matrix and whether it is stored as its transpose
+ */
+template <typename T>
+std::pair<T const*, bool> arrange_as_matrix(T const* data, std::span<size_t const> shape,
+                                            std::span<size_t const> rows, std::span<size_t const> cols, std::vector<T>& buffer) {
+    auto const is_in_order = [](std::span<size_t const> first, std::span<size_t const> second) {
+        for (size_t i = 0; i < first.size(); ++i) {
+            if (first[i] != i) return false;
+        }
+        for (size_t i = 0; i < second.size(); ++i) {
+            if (second[i] != first.size() + i) return false;
+        }
+        return true;
+    };
+    if (is_in_order(rows, cols)) return {data, false};
+    if (is_in_order(cols, rows)) return {data, true};
+
+    std::vector<size_t> perm(rows.begin(), rows.end());
+    perm.insert(perm.end(), cols.begin(), cols.end());
+    auto const size = std::accumulate(shape.begin(), shape.end(), size_t{1}, std::multiplies<>{});
+    if (buffer.size() < size) buffer.resize(size);
+    permute_axes(data, buffer.data(), shape, perm);
+    return {buffer.data(), false};
+}
+
+}  // namespace qsyn::tensor
@@ -0,0 +1,159 @@
+/****************************************************************************
+  PackageName  [ util ]
+  Synopsis     [ Define word-level bit kernels with runtime SIMD dispatch ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include "./bit_kernels.hpp"
+
+#include <bit>
+#include <cassert>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define DVLAB_BIT_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace dvlab::bit_kernels {
+
+namespace {
+
+struct KernelSet {
+    void (*xor_words)(WordType*, WordType const*, size_t);
+    size_t (*popcount_words)(WordType const*, size_t);
+    std::string_view name;
+};
+
+//------------------------------------------------------------------------
+//   portable kernels
+//------------------------------------------------------------------------
+
+void xor_words_scalar(WordType* dst, WordType const* src, size_t n) {
+    for (size_t i = 0; i < n; ++i) dst[i] ^= src[i];
+}
+
+size_t popcount_words_scalar(WordType const* words, size_t n) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) count += std::popcount(words[i]);
+    return count;
+}
+
+#ifdef DVLAB_BIT_KERNELS_X86
+
+//------------------------------------------------------------------------
+//   AVX2 kernels
+//------------------------------------------------------------------------
+
+__attribute__((target("avx2"))) void xor_words_avx2(WordType* dst, WordType const* src, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        auto const a = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(dst + i));
+        auto const b = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(a, b));
+    }
+    for (; i < n; ++i) dst[i] ^= src[i];
+}
+
+/**
+ * @brief Count the set bits of a 256-bit vector with the nibble-lookup method of W. Mula.
+ *        Returns four 64-bit partial sums.
+ */
+__attribute__((target("avx2"))) __m256i popcount_m256(__m256i v) {
+    auto const lookup   = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    auto const low_mask = _mm256_set1_epi8(0x0f);
+    auto const lo       = _mm256_and_si256(v, low_mask);
+    auto const hi       = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    auto const counts   = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+    return _mm256_sad_epu8(counts, _mm256_setzero_si256());
+}
+
+__attribute__((target("avx2"))) size_t horizontal_sum_m256(__m256i v) {
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), v);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+__attribute__((target("avx2,popcnt"))) size_t popcount_words_avx2(WordType const* words, size_t n) {
+    auto acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm256_add_epi64(acc, popcount_m256(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(words + i))));
+    }
+    auto count = horizontal_sum_m256(acc);
+    for (; i < n; ++i) count += std::popcount(words[i]);
+    return count;
+}
+
+//------------------------------------------------------------------------
+//   AVX-512 kernels
+//------------------------------------------------------------------------
+
+__attribute__((target("avx512f"))) void xor_words_avx512(WordType* dst, WordType const* src, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        auto const a = _mm512_loadu_si512(dst + i);
+        auto const b = _mm512_loadu_si512(src + i);
+        _mm512_storeu_si512(dst + i, _mm512_xor_si512(a, b));
+    }
+    for (; i < n; ++i) dst[i] ^= src[i];
+}
+
+// NOTE - _mm512_reduce_add_epi64 trips -Wuninitialized inside GCC 12's own headers
+__attribute__((target("avx512f"))) size_t horizontal_sum_m512(__m512i v) {
+    alignas(64) uint64_t lanes[8];
+    _mm512_store_si512(lanes, v);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7];
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq,popcnt"))) size_t popcount_words_avx512(WordType const* words, size_t n) {
+    auto acc = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_loadu_si512(words + i)));
+    }
+    auto count = horizontal_sum_m512(acc);
+    for (; i < n; ++i) count += std::popcount(words[i]);
+    return count;
+}
+
+#endif  // DVLAB_BIT_KERNELS_X86
+
+KernelSet select_kernels() {
+#ifdef DVLAB_BIT_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq")) {
+        return {xor_words_avx512, popcount_words_avx512, "avx512"};
+    }
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2")) {
+        return {xor_words_avx512, popcount_words_avx2, "avx512f+avx2"};
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return {xor_words_avx2, popcount_words_avx2, "avx2"};
+    }
+#endif
+    return {xor_words_scalar, popcount_words_scalar, "scalar"};
+}
+
+KernelSet const& kernels() {
+    static KernelSet const selected = select_kernels();
+    return selected;
+}
+
+}  // namespace
+
+void xor_words(std::span<WordType> dst, std::span<WordType const> src) {
+    assert(dst.size() == src.size());
+    kernels().xor_words(dst.data(), src.data(), dst.size());
+}
+
+size_t popcount_words(std::span<WordType const> words) {
+    return kernels().popcount_words(words.data(), words.size());
+}
+
+std::string_view kernel_name() {
+    return kernels().name;
+}
+
+}  // namespace dvlab::bit_kernels
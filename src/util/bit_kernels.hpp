@@ -0,0 +1,44 @@
+/****************************************************************************
+  PackageName  [ util ]
+  Synopsis     [ Define word-level bit kernels with runtime SIMD dispatch ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace dvlab {
+
+namespace bit_kernels {
+
+using WordType                 = uint64_t;
+constexpr size_t bits_per_word = 64;
+
+constexpr size_t num_words(size_t n_bits) { return (n_bits + bits_per_word - 1) / bits_per_word; }
+
+/**
+ * @brief dst ^= src, word by word. The two spans must be of the same size.
+ *
+ */
+void xor_words(std::span<WordType> dst, std::span<WordType const> src);
+
+/**
+ * @brief Count the number of set bits in the span.
+ *
+ */
+size_t popcount_words(std::span<WordType const> words);
+
+/**
+ * @brief Return the name of the kernel set selected for this machine, e.g., "avx2".
+ *
+ */
+std::string_view kernel_name();
+
+}  // namespace bit_kernels
+
+}  // namespace dvlab
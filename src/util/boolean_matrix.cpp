@@ -7,6 +7,8 @@
 
 #include "./boolean_matrix.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
 #include <cmath>
 #include <gsl/util>
@@ -20,17 +22,80 @@
 
 namespace dvlab {
 
-struct UCharVectorHash {
-    size_t operator()(std::vector<unsigned char> const& k) const {
-        size_t ret = std::hash<unsigned char>()(k[0]);
-        for (size_t i = 1; i < k.size(); i++) {
-            ret ^= std::hash<unsigned char>()(k[i] << (i % sizeof(size_t)));
+struct WordVectorHash {
+    size_t operator()(std::vector<BooleanMatrix::Row::WordType> const& k) const {
+        size_t ret = 0;
+        for (auto const& word : k) {
+            ret ^= std::hash<BooleanMatrix::Row::WordType>()(word) + 0x9e3779b97f4a7c15 + (ret << 6) + (ret >> 2);
         }
-
         return ret;
     }
 };
 
+BooleanMatrix::Row::Row(std::vector<unsigned char> const& r) : Row(r.size()) {
+    for (size_t i = 0; i < r.size(); i++) {
+        if (r[i] & 1) (*this)[i] = 1;
+    }
+}
+
+BooleanMatrix::Row::Row(size_t size, unsigned char val) : Row(size) {
+    if ((val & 1) == 0) return;
+    std::ranges::fill(_words, ~WordType{0});
+    if (auto const tail = _size % bit_kernels::bits_per_word; tail != 0) {
+        _words.back() = (WordType{1} << tail) - 1;
+    }
+}
+
+/**
+ * @brief Unpack the row into one byte per bit
+ *
+ * @return std::vector<unsigned char>
+ */
+std::vector<unsigned char> BooleanMatrix::Row::get_row() const {
+    std::vector<unsigned char> row(_size);
+    for (size_t i = 0; i < _size; i++) {
+        row[i] = (*this)[i];
+    }
+    return row;
+}
+
+/**
+ * @brief Append a bit to the end of the row
+ *
+ * @param i the value of the new bit
+ */
+void BooleanMatrix::Row::emplace_back(unsigned char i) {
+    if (_size % bit_kernels::bits_per_word == 0) _words.emplace_back(0);
+    ++_size;
+    back() = i;
+}
+
+/**
+ * @brief Get the bits in [begin, end) packed into words, starting from the lowest bit
+ *
+ * @param begin
+ * @param end
+ * @return std::vector<WordType>
+ */
+std::vector<BooleanMatrix::Row::WordType> BooleanMatrix::Row::get_section(size_t begin, size_t end) const {
+    assert(begin <= end && end <= _size);
+    constexpr auto word_bits = bit_kernels::bits_per_word;
+
+    std::vector<WordType> section(bit_kernels::num_words(end - begin), 0);
+    auto const shift = begin % word_bits;
+    for (size_t i = 0; i < section.size(); i++) {
+        auto const src = begin / word_bits + i;
+        section[i]     = _words[src] >> shift;
+        if (shift != 0 && src + 1 < _words.size()) {
+            section[i] |= _words[src + 1] << (word_bits - shift);
+        }
+    }
+    if (auto const tail = (end - begin) % word_bits; tail != 0) {
+        section.back() &= (WordType{1} << tail) - 1;
+    }
+    return section;
+}
+
 /**
  * @brief Overload operator + for Row
  *
@@ -50,33 +115,17 @@ BooleanMatrix::Row operator+(BooleanMatrix::Row lhs, BooleanMatrix::Row const& r
  * @return Row&
  */
 BooleanMatrix::Row& BooleanMatrix::Row::operator+=(Row const& rhs) {
-    assert(_row.size() == rhs._row.size());
-    for (size_t i = 0; i < _row.size(); i++) {
-        _row[i] = (_row[i] + rhs._row[i]) % 2;
-    }
+    assert(_size == rhs._size);
+    bit_kernels::xor_words(_words, rhs._words);
     return *this;
 }
 
-/**
- * @brief Overload operator == for Row
- *
- * @param rhs
- * @return Row&
- */
-bool BooleanMatrix::Row::operator==(Row const& rhs) const {
-    assert(_row.size() == rhs._row.size());
-    for (size_t i = 0; i < _row.size(); i++) {
-        if (_row[i] != rhs._row[i]) return false;
-    }
-    return true;
-}
-
 /**
  * @brief Print row
  *
  */
 void BooleanMatrix::Row::print_row(spdlog::level::level_enum lvl) const {
-    spdlog::log(lvl, "{}", fmt::join(_row, " "));
+    spdlog::log(lvl, "{}", fmt::join(get_row(), " "));
 }
 
 /**
@@ -86,10 +135,10 @@ void BooleanMatrix::Row::print_row(spdlog::level::level_enum lvl) const {
  * @return false
  */
 bool BooleanMatrix::Row::is_one_hot() const {
-    // we don't use count_if here because we want to stop early if we find a second 1
-    auto first_one = std::ranges::find(_row, 1);
-    if (first_one == _row.end()) return false;
-    return std::ranges::find(first_one + 1, _row.end(), 1) == _row.end();
+    // we don't use popcount here because we want to stop early if we find a second 1
+    auto first_one = std::ranges::find_if(_words, [](WordType w) { return w != 0; });
+    if (first_one == _words.end() || !std::has_single_bit(*first_one)) return false;
+    return std::ranges::all_of(first_one + 1, _words.end(), [](WordType w) { return w == 0; });
 }
 
 /**
@@ -99,27 +148,7 @@ bool BooleanMatrix::Row::is_one_hot() const {
  * @return false
  */
 bool BooleanMatrix::Row::is_zeros() const {
-    for (auto& i : _row) {
-        if (i == 1) {
-            return false;
-        }
-    }
-    return true;
-}
-
-/**
- * @brief Sum the values of the row
- *
- * @return Sum of the row
- */
-size_t BooleanMatrix::Row::sum() const {
-    size_t sum = 0;
-    for (auto& i : _row) {
-        if (i == 1) {
-            ++sum;
-        }
-    }
-    return sum;
+    return std::ranges::all_of(_words, [](WordType w) { return w == 0; });
 }
 
 /**
@@ -183,28 +212,27 @@ bool BooleanMatrix::row_operation(size_t ctrl, size_t targ, bool track) {
  * @param blockSize
  * @param fullReduced if true, performing back-substitution from the echelon form
  * @param track if true, record the process to operation track
- * @return size_t (rank)
+ * @param max_row_operations if tracking, give up as soon as more row operations than this have been recorded.
+ *        The matrix is then left partially reduced.
+ * @return size_t (rank, or the number of pivots found so far if given up)
  */
-size_t BooleanMatrix::gaussian_elimination_skip(size_t block_size, bool do_fully_reduced, bool track) {
+size_t BooleanMatrix::gaussian_elimination_skip(size_t block_size, bool do_fully_reduced, bool track, size_t max_row_operations) {
+    auto over_budget = [track, max_row_operations, this]() {
+        return track && _row_operations.size() > max_row_operations;
+    };
+
     auto get_section_range = [block_size, this](size_t section_idx) {
         auto section_begin = section_idx * block_size;
         auto section_end   = std::min(num_cols(), (section_idx + 1) * block_size);
         return std::make_pair(section_begin, section_end);
     };
 
-    auto get_sub_vec = [this](size_t row_idx, size_t section_begin, size_t section_end) {
-        auto row_begin = dvlab::iterator::next(_matrix[row_idx].get_row().begin(), section_begin);
-        auto row_end   = dvlab::iterator::next(_matrix[row_idx].get_row().begin(), section_end);
-        // NOTE - not all vector, only consider [row_begin, row_end)
-        return std::vector<unsigned char>(row_begin, row_end);
-    };
-
-    auto clear_section_duplicates = [this, get_sub_vec, track](size_t section_begin, size_t section_end, auto row_range) {
-        std::unordered_map<std::vector<unsigned char>, size_t, UCharVectorHash> duplicated;
+    auto clear_section_duplicates = [this, track](size_t section_begin, size_t section_end, auto row_range) {
+        std::unordered_map<std::vector<Row::WordType>, size_t, WordVectorHash> duplicated;
         for (auto row_idx : row_range) {
-            auto sub_vec = get_sub_vec(row_idx, section_begin, section_end);
+            auto sub_vec = _matrix[row_idx].get_section(section_begin, section_end);
 
-            if (std::ranges::all_of(sub_vec, [](unsigned char const& e) { return e == 0; })) continue;
+            if (std::ranges::all_of(sub_vec, [](Row::WordType const& e) { return e == 0; })) continue;
 
             if (duplicated.contains(sub_vec)) {
                 row_operation(duplicated[sub_vec], row_idx, track);
@@ -249,6 +277,7 @@ size_t BooleanMatrix::gaussian_elimination_skip(size_t block_size, bool do_fully
 
             // records the current columns for fully-reduced
             if (do_fully_reduced) pivots.emplace_back(col_idx);
+            if (over_budget()) return pivots.size();
         }
     }
     auto const rank = pivots.size();
@@ -270,7 +299,7 @@ size_t BooleanMatrix::gaussian_elimination_skip(size_t block_size, bool do_fully
 
             clear_all_1s_in_column(pivots.size() - 1, last, std::views::iota(0u, pivots.size()));
 
-            if (pivots.empty()) return rank;
+            if (pivots.empty() || over_budget()) return rank;
         }
     }
 
@@ -531,6 +560,28 @@ void BooleanMatrix::push_zeros_column() {
     for_each(_matrix.begin(), _matrix.end(), [](Row& r) { r.emplace_back(0); });
 }
 
+/**
+ * @brief Reorder the columns so that column i of the result is column new_to_old[i] of the original
+ *
+ * @param new_to_old a permutation of [0, num_cols())
+ */
+void BooleanMatrix::permute_columns(std::vector<size_t> const& new_to_old) {
+    assert(new_to_old.size() == num_cols());
+    std::vector<size_t> old_to_new(new_to_old.size());
+    for (auto const& [i, j] : tl::views::enumerate(new_to_old)) {
+        old_to_new[j] = i;
+    }
+    for (auto& row : _matrix) {
+        Row permuted(row.size());
+        for (auto const& [w, word] : tl::views::enumerate(row.get_words())) {
+            for (auto bits = word; bits != 0; bits &= bits - 1) {
+                permuted[old_to_new[w * bit_kernels::bits_per_word + std::countr_zero(bits)]] = 1;
+            }
+        }
+        row = std::move(permuted);
+    }
+}
+
 /**
  * @brief Find if the row exist in the matrix
  * @param Row: row
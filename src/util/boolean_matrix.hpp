@@ -10,10 +10,13 @@
 #include <spdlog/spdlog.h>
 
 #include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
 #include <utility>
 #include <vector>
 
-#include "util/ordered_hashset.hpp"
+#include "util/bit_kernels.hpp"
 
 //------------------------------------------------------------------------
 //   Define classes
@@ -23,39 +26,80 @@ namespace dvlab {
 
 class BooleanMatrix {
 public:
+    /**
+     * @brief A row of the matrix. Bits are packed into 64-bit words so that
+     *        row additions and popcounts are done a word (or a SIMD lane) at a time.
+     *        Bits beyond `size()` in the last word are always kept zero.
+     */
     class Row {
     public:
-        Row(std::vector<unsigned char> const& r) : _row(r) {}
-        Row(size_t size, unsigned char val) : _row(size, val) {}
-        Row(size_t size) : _row(size, 0) {}
-
-        std::vector<unsigned char> const& get_row() const { return _row; }
-        void set_row(std::vector<unsigned char> row) { _row = std::move(row); }
-        size_t size() const { return _row.size(); }
-        unsigned char& back() { return _row.back(); }
-        unsigned char const& back() const { return _row.back(); }
-        size_t sum() const;
+        using WordType = bit_kernels::WordType;
+
+        /**
+         * @brief Proxy to a single bit of a row. Arithmetic is done in GF(2).
+         *
+         */
+        class BitReference {
+        public:
+            BitReference(WordType& word, WordType mask) : _word(word), _mask(mask) {}
+
+            operator unsigned char() const { return (_word & _mask) ? 1 : 0; }
+
+            BitReference& operator=(unsigned char val) {
+                if (val & 1)
+                    _word |= _mask;
+                else
+                    _word &= ~_mask;
+                return *this;
+            }
+            BitReference& operator=(BitReference const& other) { return *this = static_cast<unsigned char>(other); }
+            BitReference& operator+=(unsigned char val) {
+                if (val & 1) _word ^= _mask;
+                return *this;
+            }
+            // values are always reduced modulo 2; kept for source compatibility
+            BitReference& operator%=(unsigned char /* mod */) { return *this; }
+
+        private:
+            WordType& _word;
+            WordType _mask;
+        };
+
+        Row(std::vector<unsigned char> const& r);
+        Row(size_t size, unsigned char val);
+        Row(size_t size) : _words(bit_kernels::num_words(size), 0), _size(size) {}
+
+        std::vector<unsigned char> get_row() const;
+        void set_row(std::vector<unsigned char> const& row) { *this = Row(row); }
+        std::span<WordType const> get_words() const { return _words; }
+        size_t size() const { return _size; }
+        BitReference back() { return (*this)[_size - 1]; }
+        unsigned char back() const { return (*this)[_size - 1]; }
+        size_t sum() const { return bit_kernels::popcount_words(_words); }
 
         bool is_one_hot() const;
         bool is_zeros() const;
         void print_row(spdlog::level::level_enum lvl = spdlog::level::level_enum::off) const;
 
-        void emplace_back(unsigned char i) { _row.emplace_back(i); }
+        void emplace_back(unsigned char i);
 
         Row& operator+=(Row const& rhs);
         friend Row operator+(Row lhs, Row const& rhs);
 
-        bool operator==(Row const& rhs) const;
+        bool operator==(Row const& rhs) const { return _size == rhs._size && _words == rhs._words; }
 
-        unsigned char& operator[](size_t const& i) {
-            return _row[i];
+        BitReference operator[](size_t const& i) {
+            return {_words[i / bit_kernels::bits_per_word], WordType{1} << (i % bit_kernels::bits_per_word)};
         }
-        unsigned char const& operator[](size_t const& i) const {
-            return _row[i];
+        unsigned char operator[](size_t const& i) const {
+            return (_words[i / bit_kernels::bits_per_word] >> (i % bit_kernels::bits_per_word)) & 1;
         }
 
+        std::vector<WordType> get_section(size_t begin, size_t end) const;
+
     private:
-        std::vector<unsigned char> _row;
+        std::vector<WordType> _words;
+        size_t _size = 0;
     };
     using RowOperation = std::pair<size_t, size_t>;
 
@@ -81,7 +125,7 @@ public:
     }
 
     bool row_operation(size_t ctrl, size_t targ, bool track = false);
-    size_t gaussian_elimination_skip(size_t block_size, bool do_fully_reduced, bool track = true);
+    size_t gaussian_elimination_skip(size_t block_size, bool do_fully_reduced, bool track = true, size_t max_row_operations = SIZE_MAX);
     bool gaussian_elimination(bool track = false, bool is_augmented_matrix = false);
     bool gaussian_elimination_augmented(bool track = false);
     bool is_solved_form() const;
@@ -93,7 +137,8 @@ public:
     double dense_ratio();
     void append_one_hot_column(size_t idx);
     void push_zeros_column();
-    void push_zeros_row() { _matrix.emplace_back(std::vector<unsigned char>(_matrix[0].size(), 0)); }
+    void permute_columns(std::vector<size_t> const& new_to_old);
+    void push_zeros_row() { _matrix.emplace_back(_matrix[0].size()); }
     void push_row(Row const& row) { _matrix.emplace_back(row); }
     void push_wor(Row&& row) { _matrix.emplace_back(std::move(row)); }
     void erase_row(size_t r) { (_matrix.erase(_matrix.begin() + r)); };
@@ -0,0 +1,294 @@
+/****************************************************************************
+  PackageName  [ util ]
+  Synopsis     [ Define class compact_ordered_hashset ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+/********************** Summary of this data structure **********************
+ *
+ *     compact_ordered_hashset is a drop-in replacement of ordered_hashset for
+ * sets that are usually tiny, e.g., the neighbors of a ZX-vertex. Elements are
+ * kept in insertion order as ordered_hashset does, but
+ *
+ *     - up to `InlineCapacity` elements are stored inside the object itself;
+ *     - up to `IndexThreshold` elements are looked up with a linear scan, and
+ *       erasure shifts the later elements forward;
+ *     - beyond that, a hash index is built, and erasure leaves placeholders
+ *       that are swept once they outnumber the live elements.
+ *
+ *     Only the interface that ordered_hashset users actually rely on is
+ * provided; elements cannot be modified through the iterators.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace dvlab {
+
+namespace utils {
+
+template <typename Key, size_t InlineCapacity = 4, size_t IndexThreshold = 16, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class compact_ordered_hashset {  // NOLINT(readability-identifier-naming) : compact_ordered_hashset intentionally mimics std::unordered_set
+    static_assert(InlineCapacity > 0);
+    static_assert(IndexThreshold >= InlineCapacity);
+
+public:
+    using key_type        = Key;
+    using value_type      = Key;
+    using size_type       = size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher          = Hash;
+    using key_equal       = KeyEqual;
+
+    class const_iterator {
+    public:
+        using value_type        = Key;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = Key const&;
+        using pointer           = Key const*;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        const_iterator() = default;
+        const_iterator(Key const* itr, Key const* begin, Key const* end, unsigned char const* erased) noexcept
+            : _itr{itr}, _begin{begin}, _end{end}, _erased{erased} {
+            while (_itr != _end && _is_erased()) ++_itr;
+        }
+
+        const_iterator& operator++() noexcept {
+            ++_itr;
+            while (_itr != _end && _is_erased()) ++_itr;
+            return *this;
+        }
+
+        const_iterator operator++(int) noexcept {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        const_iterator& operator--() noexcept {
+            --_itr;
+            while (_itr != _begin && _is_erased()) --_itr;
+            return *this;
+        }
+
+        const_iterator operator--(int) noexcept {
+            auto tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        reference operator*() const noexcept { return *_itr; }
+        pointer operator->() const noexcept { return _itr; }
+
+        bool operator==(const_iterator const& rhs) const noexcept { return _itr == rhs._itr; }
+        bool operator!=(const_iterator const& rhs) const noexcept { return !(*this == rhs); }
+
+    private:
+        Key const* _itr               = nullptr;
+        Key const* _begin             = nullptr;
+        Key const* _end               = nullptr;
+        unsigned char const* _erased = nullptr;  // null if there are no placeholders
+
+        bool _is_erased() const noexcept { return _erased != nullptr && _erased[_itr - _begin]; }
+    };
+
+    using iterator = const_iterator;
+
+    compact_ordered_hashset() = default;
+    ~compact_ordered_hashset() = default;
+
+    compact_ordered_hashset(compact_ordered_hashset const& other) {
+        reserve(other.size());
+        for (auto const& key : other) _append(Key{key});
+    }
+
+    compact_ordered_hashset(compact_ordered_hashset&& other) noexcept { swap(other); }
+
+    compact_ordered_hashset& operator=(compact_ordered_hashset copy) noexcept {
+        swap(copy);
+        return *this;
+    }
+
+    void swap(compact_ordered_hashset& other) noexcept {
+        std::swap(_inline, other._inline);
+        std::swap(_heap, other._heap);
+        std::swap(_index, other._index);
+        std::swap(_num_slots, other._num_slots);
+        std::swap(_capacity, other._capacity);
+    }
+
+    friend void swap(compact_ordered_hashset& a, compact_ordered_hashset& b) noexcept { a.swap(b); }
+
+    // iterators
+    const_iterator begin() const noexcept { return _iterator_at(0); }
+    const_iterator end() const noexcept { return _iterator_at(_num_slots); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // lookup
+    const_iterator find(Key const& key) const {
+        auto const pos = _find(key);
+        return pos == npos ? end() : _iterator_at(pos);
+    }
+    bool contains(Key const& key) const { return _find(key) != npos; }
+
+    // properties
+    size_type size() const noexcept { return _num_slots - (_index ? _index->num_erased : 0); }
+    bool empty() const noexcept { return size() == 0; }
+
+    // container manipulation
+    void clear() noexcept {
+        _inline = {};
+        _heap.reset();
+        _index.reset();
+        _num_slots = 0;
+        _capacity  = InlineCapacity;
+    }
+
+    void reserve(size_type n) {
+        if (n > _capacity) _grow(n);
+    }
+
+    template <typename... Args>
+    std::pair<const_iterator, bool> emplace(Args&&... args) {
+        Key key(std::forward<Args>(args)...);
+        if (auto const pos = _find(key); pos != npos) return {_iterator_at(pos), false};
+        _append(std::move(key));
+        return {_iterator_at(_num_slots - 1), true};
+    }
+
+    std::pair<const_iterator, bool> insert(Key const& key) { return emplace(key); }
+
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) emplace(*first);
+    }
+
+    size_type erase(Key const& key) {
+        auto const pos = _find(key);
+        if (pos == npos) return 0;
+        auto data = _data();
+        if (_index) {
+            _index->positions.erase(data[pos]);
+            _index->erased[pos] = 1;
+            ++_index->num_erased;
+            if (size() <= IndexThreshold / 2) {
+                _sweep(false);
+            } else if (_index->num_erased > size()) {
+                _sweep(true);
+            }
+        } else {
+            std::move(data + pos + 1, data + _num_slots, data + pos);
+            --_num_slots;
+            data[_num_slots] = Key{};
+        }
+        return 1;
+    }
+
+    size_type erase(const_iterator const& itr) { return erase(Key{*itr}); }
+
+private:
+    struct Index {
+        std::unordered_map<Key, uint32_t, Hash, KeyEqual> positions;
+        std::vector<unsigned char> erased;
+        uint32_t num_erased = 0;
+    };
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    std::array<Key, InlineCapacity> _inline{};
+    std::unique_ptr<Key[]> _heap;  // replaces `_inline` as the storage once allocated
+    std::unique_ptr<Index> _index;
+    uint32_t _num_slots = 0;  // including placeholders
+    uint32_t _capacity  = InlineCapacity;
+
+    Key* _data() noexcept { return _heap ? _heap.get() : _inline.data(); }
+    Key const* _data() const noexcept { return _heap ? _heap.get() : _inline.data(); }
+
+    const_iterator _iterator_at(size_t pos) const noexcept {
+        auto const data = _data();
+        return const_iterator(data + pos, data, data + _num_slots, _index ? _index->erased.data() : nullptr);
+    }
+
+    size_t _find(Key const& key) const {
+        if (_index) {
+            auto const itr = _index->positions.find(key);
+            return itr == _index->positions.end() ? npos : itr->second;
+        }
+        auto const data = _data();
+        for (size_t i = 0; i < _num_slots; ++i) {
+            if (KeyEqual{}(data[i], key)) return i;
+        }
+        return npos;
+    }
+
+    void _append(Key&& key) {
+        if (_num_slots == _capacity) _grow(2 * static_cast<size_t>(_capacity));
+        auto data        = _data();
+        data[_num_slots] = std::move(key);
+        if (_index) {
+            _index->positions.emplace(data[_num_slots], _num_slots);
+            _index->erased.emplace_back(0);
+        }
+        ++_num_slots;
+        if (!_index && _num_slots > IndexThreshold) _build_index();
+    }
+
+    void _grow(size_t capacity) {
+        auto heap = std::make_unique<Key[]>(capacity);
+        std::move(_data(), _data() + _num_slots, heap.get());
+        if (!_heap) _inline = {};
+        _heap     = std::move(heap);
+        _capacity = static_cast<uint32_t>(capacity);
+    }
+
+    void _build_index() {
+        _index = std::make_unique<Index>();
+        _index->positions.reserve(2 * static_cast<size_t>(_num_slots));
+        auto const data = _data();
+        for (uint32_t i = 0; i < _num_slots; ++i) _index->positions.emplace(data[i], i);
+        _index->erased.assign(_num_slots, 0);
+    }
+
+    /**
+     * @brief Remove the placeholders left by erasure. If `keep_index` is false,
+     *        fall back to linear lookup and move back to the inline storage if possible.
+     *
+     */
+    void _sweep(bool keep_index) {
+        auto data     = _data();
+        uint32_t live = 0;
+        for (uint32_t i = 0; i < _num_slots; ++i) {
+            if (_index->erased[i]) continue;
+            if (live != i) data[live] = std::move(data[i]);
+            ++live;
+        }
+        std::fill(data + live, data + _num_slots, Key{});
+        _num_slots = live;
+        _index.reset();
+        if (keep_index) {
+            _build_index();
+        } else if (_num_slots <= InlineCapacity) {
+            std::move(data, data + _num_slots, _inline.begin());
+            _heap.reset();
+            _capacity = InlineCapacity;
+        }
+    }
+};
+
+}  // namespace utils
+
+}  // namespace dvlab
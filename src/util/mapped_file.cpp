@@ -0,0 +1,88 @@
+/****************************************************************************
+  PackageName  [ util ]
+  Synopsis     [ Read-only memory-mapped files and a line cursor over them ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include "./mapped_file.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dvlab {
+
+namespace utils {
+
+MappedFile::MappedFile(std::filesystem::path const& filepath) {
+#ifndef _WIN32
+    auto const fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat st {};
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        _size    = static_cast<size_t>(st.st_size);
+        _is_open = true;
+        if (_size > 0) {
+            auto const addr = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                ::madvise(addr, _size, MADV_SEQUENTIAL);
+                _mapped_addr = addr;
+                _data        = static_cast<char const*>(addr);
+            }
+        }
+    }
+    ::close(fd);
+    if (!_is_open || _mapped_addr != nullptr || _size == 0) return;
+    _is_open = false;
+#endif
+    // fall back to reading the whole file
+    std::ifstream file{filepath, std::ios::binary};
+    if (!file.is_open()) return;
+    _buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    _data    = _buffer.data();
+    _size    = _buffer.size();
+    _is_open = true;
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (_mapped_addr != nullptr) ::munmap(_mapped_addr, _size);
+#endif
+}
+
+/**
+ * @brief Get the next line, or std::nullopt if the buffer is exhausted
+ *
+ * @return std::optional<std::string_view>
+ */
+std::optional<std::string_view> LineCursor::next_line() {
+    if (_rest.empty()) return std::nullopt;
+    auto const end = _rest.find('\n');
+    auto line      = _rest.substr(0, end);
+    _rest.remove_prefix(end == std::string_view::npos ? _rest.size() : end + 1);
+    if (line.ends_with('\r')) line.remove_suffix(1);
+    ++_line_number;
+    return line;
+}
+
+/**
+ * @brief Count the lines not yet returned. Useful for preallocation.
+ *
+ * @return size_t
+ */
+size_t LineCursor::count_remaining_lines() const {
+    auto const n_newlines = static_cast<size_t>(std::ranges::count(_rest, '\n'));
+    return n_newlines + ((_rest.empty() || _rest.ends_with('\n')) ? 0 : 1);
+}
+
+}  // namespace utils
+
+}  // namespace dvlab
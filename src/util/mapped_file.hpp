@@ -0,0 +1,66 @@
+/****************************************************************************
+  PackageName  [ util ]
+  Synopsis     [ Read-only memory-mapped files and a line cursor over them ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace dvlab {
+
+namespace utils {
+
+/**
+ * @brief A read-only view of a whole file. The file is memory-mapped where
+ *        supported, and read into a buffer otherwise.
+ *
+ */
+class MappedFile {
+public:
+    MappedFile(std::filesystem::path const& filepath);
+    ~MappedFile();
+
+    MappedFile(MappedFile const&)            = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+    MappedFile(MappedFile&&)                 = delete;
+    MappedFile& operator=(MappedFile&&)      = delete;
+
+    bool is_open() const { return _is_open; }
+    std::string_view view() const { return {_data, _size}; }
+
+private:
+    bool _is_open      = false;
+    char const* _data  = nullptr;
+    size_t _size       = 0;
+    void* _mapped_addr = nullptr;  // null if the file is read into `_buffer` instead
+    std::string _buffer;
+};
+
+/**
+ * @brief Walk through the lines of a buffer without copying them.
+ *        The trailing '\r' of CRLF line endings is dropped.
+ *
+ */
+class LineCursor {
+public:
+    LineCursor(std::string_view buffer) : _rest{buffer} {}
+
+    std::optional<std::string_view> next_line();
+    size_t line_number() const { return _line_number; }  // 1-based number of the last line returned
+    size_t count_remaining_lines() const;
+
+private:
+    std::string_view _rest;
+    size_t _line_number = 0;
+};
+
+}  // namespace utils
+
+}  // namespace dvlab
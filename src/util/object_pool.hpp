@@ -0,0 +1,156 @@
+/****************************************************************************
+  PackageName  [ util ]
+  Synopsis     [ Define class ObjectPool, a chunked arena with stable addresses ]
+  Author       [ Design Verification Lab ]
+  Copyright    [ Copyright(c) 2023 DVLab, GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+/********************** Summary of this data structure **********************
+ *
+ *     ObjectPool hands out objects carved from a few large chunks instead of
+ * one heap allocation per object. Addresses stay valid until the object is
+ * destroyed, and destroyed slots are recycled by later creations.
+ *
+ *     The pool does not track which slots are alive. The owner is expected to
+ * destroy the live objects before the pool goes away; the pool then releases
+ * the memory chunk by chunk. Two pools can be merged without moving any object.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace dvlab {
+
+namespace utils {
+
+template <typename T>
+class ObjectPool {
+public:
+    ObjectPool()  = default;
+    ~ObjectPool() = default;
+
+    ObjectPool(ObjectPool const&)            = delete;
+    ObjectPool& operator=(ObjectPool const&) = delete;
+    ObjectPool(ObjectPool&& other) noexcept
+        : _chunks{std::move(other._chunks)},
+          _free_slots{std::move(other._free_slots)},
+          _tail{std::exchange(other._tail, nullptr)},
+          _tail_end{std::exchange(other._tail_end, nullptr)},
+          _capacity{std::exchange(other._capacity, 0)} {}
+    ObjectPool& operator=(ObjectPool&& other) noexcept {
+        ObjectPool tmp{std::move(other)};
+        swap(tmp);
+        return *this;
+    }
+
+    void swap(ObjectPool& other) noexcept {
+        std::swap(_chunks, other._chunks);
+        std::swap(_free_slots, other._free_slots);
+        std::swap(_tail, other._tail);
+        std::swap(_tail_end, other._tail_end);
+        std::swap(_capacity, other._capacity);
+    }
+
+    friend void swap(ObjectPool& a, ObjectPool& b) noexcept { a.swap(b); }
+
+    /**
+     * @brief Construct an object in a free slot of the pool.
+     *
+     * @return T* the address of the object; stable until `destroy` is called on it
+     */
+    template <typename... Args>
+    T* create(Args&&... args) {
+        Slot* slot = nullptr;
+        if (!_free_slots.empty()) {
+            slot = _free_slots.back();
+            _free_slots.pop_back();
+        } else {
+            if (_tail == _tail_end) _allocate_chunk(std::max(min_chunk_size, _capacity));
+            slot = _tail++;
+        }
+        return ::new (static_cast<void*>(slot)) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroy an object created by this pool and recycle its slot.
+     *
+     * @param obj
+     */
+    void destroy(T* obj) {
+        std::destroy_at(obj);
+        _free_slots.emplace_back(reinterpret_cast<Slot*>(obj));
+    }
+
+    /**
+     * @brief Make sure the next `n` creations do not allocate.
+     *        Fresh slots are laid out contiguously in creation order.
+     *
+     * @param n
+     */
+    void reserve(size_t n) {
+        auto const available = _free_slots.size() + static_cast<size_t>(_tail_end - _tail);
+        if (n <= available) return;
+        _retire_tail();
+        _allocate_chunk(n - _free_slots.size());
+    }
+
+    /**
+     * @brief Take over the memory of `other`. Objects living in `other` keep their addresses
+     *        and must be destroyed through this pool from now on.
+     *
+     * @param other
+     */
+    void merge(ObjectPool&& other) {
+        if (this == &other) return;
+        other._retire_tail();
+        _chunks.insert(_chunks.end(), std::make_move_iterator(other._chunks.begin()), std::make_move_iterator(other._chunks.end()));
+        _free_slots.insert(_free_slots.end(), other._free_slots.begin(), other._free_slots.end());
+        _capacity += other._capacity;
+        other._chunks.clear();
+        other._free_slots.clear();
+        other._capacity = 0;
+    }
+
+    /**
+     * @brief Return the number of slots the pool holds, whether in use or not.
+     *
+     */
+    size_t capacity() const { return _capacity; }
+
+private:
+    struct Slot {
+        alignas(T) std::byte bytes[sizeof(T)];
+    };
+
+    static constexpr size_t min_chunk_size = 256;
+
+    std::vector<std::unique_ptr<Slot[]>> _chunks;
+    std::vector<Slot*> _free_slots;
+    Slot* _tail     = nullptr;  // the never-used slots of the last chunk
+    Slot* _tail_end = nullptr;
+    size_t _capacity = 0;
+
+    void _allocate_chunk(size_t n) {
+        _chunks.emplace_back(new Slot[n]);
+        _tail     = _chunks.back().get();
+        _tail_end = _tail + n;
+        _capacity += n;
+    }
+
+    void _retire_tail() {
+        // pushed backwards so that the free list hands them out in address order
+        while (_tail_end != _tail) _free_slots.emplace_back(--_tail_end);
+        _tail = _tail_end = nullptr;
+    }
+};
+
+}  // namespace utils
+
+}  // namespace dvlab
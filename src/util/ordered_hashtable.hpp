@@ -183,6 +183,10 @@ public:
 
     // container manipulation
     void clear();
+    void reserve(size_type n) {
+        _key2id.reserve(n);
+        _data.reserve(n);
+    }
     std::pair<iterator, bool> insert(value_type&& value);
     std::pair<iterator, bool> insert(value_type const& value) { return this->insert(std::move(value)); }
 
@@ -15,26 +15,45 @@ size_t scoped_interior_clifford_simp(ZXGraph* graph, ZXVertexList const& scope);
 size_t scoped_clifford_simp(ZXGraph* graph, ZXVertexList const& scope);
 
 /**
- * @brief partition the graph into 2^numPartitions partitions and reduce each partition separately
- *        then merge the partitions together for n rounds (experimental)
+ * @brief partition the graph into `n_partitions` partitions and reduce each partition separately,
+ *        then merge the partitions together. Repeat for `n_rounds` rounds or until a round
+ *        no longer shrinks the graph. The partitions of a round are reduced on `_num_threads` threads.
  *
- * @param numPartitions number of partitions to create
- * @param iterations number of iterations
+ * @param n_partitions number of partitions to create
+ * @param n_rounds number of rounds
  */
-void Simplifier::partition_reduce(size_t n_partitions) {
-    auto const partitions        = kl_partition(*_simp_graph, n_partitions);
-    auto const [subgraphs, cuts] = _simp_graph->create_subgraphs(partitions);
-
-    for (auto& graph : subgraphs) {
-        auto simplifier = Simplifier(graph);
-        simplifier.dynamic_reduce();
+void Simplifier::partition_reduce(size_t n_partitions, size_t n_rounds) {
+    for (size_t round = 0; round < n_rounds && !stop_requested(); ++round) {
+        auto const old_num_vertices = _simp_graph->get_num_vertices();
+        auto const old_num_edges    = _simp_graph->get_num_edges();
+
+        auto const partitions        = kl_partition(*_simp_graph, n_partitions);
+        auto const [subgraphs, cuts] = _simp_graph->create_subgraphs(partitions);
+
+        // the subgraphs own their vertices, so they can be reduced concurrently
+        auto const num_threads = static_cast<int>(std::min(_num_threads, subgraphs.size()));
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+        for (size_t i = 0; i < subgraphs.size(); ++i) {
+            auto simplifier = Simplifier(subgraphs[i]);
+            simplifier.set_incremental(_incremental);
+            // the partitions already occupy the threads
+            simplifier.set_num_threads(num_threads > 1 ? 1 : _num_threads);
+            simplifier.dynamic_reduce();
+        }
+
+        ZXGraph* const temp_graph = ZXGraph::from_subgraphs(subgraphs, cuts);
+        _simp_graph->swap(*temp_graph);
+        delete temp_graph;
+        // the whole graph has been replaced; start over with full scans
+        set_incremental(_incremental);
+
+        spider_fusion_simp();
+
+        if (n_rounds > 1) {
+            spdlog::info("Partition Reduce: round {} ({} -> {} vertices)", round + 1, old_num_vertices, _simp_graph->get_num_vertices());
+        }
+        if (_simp_graph->get_num_vertices() == old_num_vertices && _simp_graph->get_num_edges() == old_num_edges) break;
     }
-
-    ZXGraph* const temp_graph = ZXGraph::from_subgraphs(subgraphs, cuts);
-    _simp_graph->swap(*temp_graph);
-    delete temp_graph;
-
-    spider_fusion_simp();
 }
 
 void scoped_dynamic_reduce(ZXGraph* graph, ZXVertexList const& scope) {
@@ -12,27 +12,30 @@ using namespace qsyn::zx;
 
 using MatchType = IdentityRemovalRule::MatchType;
 
+namespace {
+
 /**
- * @brief Find all the matches of the identity removal rule.
+ * @brief Find matchings of the identity removal rule centered at `vertices`.
  *
- * @param g The graph to be simplified.
+ * @param graph The graph to find matches in.
+ * @param vertices the vertices to consider
  */
-std::vector<MatchType> IdentityRemovalRule::find_matches(ZXGraph const& graph) const {
+std::vector<MatchType> find_identity_removal_matches(ZXGraph const& graph, ZXVertexList const& vertices) {
     std::vector<MatchType> matches;
 
     std::unordered_set<ZXVertex*> taken;
 
-    for (auto const& v : graph.get_vertices()) {
+    for (auto const& v : vertices) {
         if (taken.contains(v)) continue;
 
-        if (v->get_phase() != Phase(0)) continue;
+        if (v->get_phase() != dvlab::Phase(0)) continue;
         if (v->get_type() != VertexType::z && v->get_type() != VertexType::x) continue;
         if (graph.get_num_neighbors(v) != 2) continue;
 
         auto [n0, etype0] = graph.get_first_neighbor(v);
         auto [n1, etype1] = graph.get_second_neighbor(v);
 
-        matches.emplace_back(v, n0, n1, zx::concat_edge(etype0, etype1));
+        matches.emplace_back(v, n0, n1, qsyn::zx::concat_edge(etype0, etype1));
         taken.insert(v);
         taken.insert(n0);
         taken.insert(n1);
@@ -41,6 +44,27 @@ std::vector<MatchType> IdentityRemovalRule::find_matches(ZXGraph const& graph) c
     return matches;
 }
 
+}  // namespace
+
+/**
+ * @brief Find all the matches of the identity removal rule.
+ *
+ * @param g The graph to be simplified.
+ */
+std::vector<MatchType> IdentityRemovalRule::find_matches(ZXGraph const& graph) const {
+    return find_identity_removal_matches(graph, graph.get_vertices());
+}
+
+/**
+ * @brief Find matchings of the identity removal rule centered at `candidates`.
+ *
+ * @param graph The graph to find matches in.
+ * @param candidates
+ */
+std::vector<MatchType> IdentityRemovalRule::find_matches_local(ZXGraph const& graph, ZXVertexList const& candidates) const {
+    return find_identity_removal_matches(graph, candidates);
+}
+
 /**
  * @brief Apply the identity removal rule to the graph.
  *
@@ -15,18 +15,21 @@ using namespace qsyn::zx;
 
 using MatchType = LocalComplementRule::MatchType;
 
+namespace {
+
 /**
- * @brief Find noninteracting matchings of the local complementation rule.
+ * @brief Find matchings of the local complementation rule centered at `vertices`.
  *
  * @param graph The graph to find matches in.
+ * @param vertices the vertices to consider
  */
-std::vector<MatchType> LocalComplementRule::find_matches(ZXGraph const& graph) const {
+std::vector<MatchType> find_local_complement_matches(ZXGraph const& graph, ZXVertexList const& vertices) {
     std::vector<MatchType> matches;
 
     std::unordered_set<ZXVertex*> taken;
 
-    for (auto const& v : graph.get_vertices()) {
-        if (v->get_type() == VertexType::z && (v->get_phase() == Phase(1, 2) || v->get_phase() == Phase(3, 2))) {
+    for (auto const& v : vertices) {
+        if (v->get_type() == VertexType::z && (v->get_phase() == dvlab::Phase(1, 2) || v->get_phase() == dvlab::Phase(3, 2))) {
             bool match_condition = true;
             if (taken.contains(v)) continue;
 
@@ -52,6 +55,27 @@ std::vector<MatchType> LocalComplementRule::find_matches(ZXGraph const& graph) c
     return matches;
 }
 
+}  // namespace
+
+/**
+ * @brief Find noninteracting matchings of the local complementation rule.
+ *
+ * @param graph The graph to find matches in.
+ */
+std::vector<MatchType> LocalComplementRule::find_matches(ZXGraph const& graph) const {
+    return find_local_complement_matches(graph, graph.get_vertices());
+}
+
+/**
+ * @brief Find matchings of the local complementation rule centered at `candidates`.
+ *
+ * @param graph The graph to find matches in.
+ * @param candidates
+ */
+std::vector<MatchType> LocalComplementRule::find_matches_local(ZXGraph const& graph, ZXVertexList const& candidates) const {
+    return find_local_complement_matches(graph, candidates);
+}
+
 void LocalComplementRule::apply(ZXGraph& graph, std::vector<MatchType> const& matches) const {
     ZXOperation op;
 
@@ -11,12 +11,20 @@ using namespace qsyn::zx;
 
 using MatchType = PivotGadgetRule::MatchType;
 
-std::vector<MatchType> PivotGadgetRule::find_matches(ZXGraph const& graph) const {
+namespace {
+
+/**
+ * @brief Find matchings of the pivot gadget rule among the edges visited by `for_each_candidate_edge`.
+ *
+ * @param graph The graph to find matches
+ * @param for_each_candidate_edge a callable that feeds each candidate edge to its argument
+ */
+std::vector<MatchType> find_pivot_gadget_matches(ZXGraph const& graph, auto const& for_each_candidate_edge) {
     std::vector<MatchType> matches;
 
     std::unordered_set<ZXVertex*> taken;
 
-    graph.for_each_edge([&graph, &taken, &matches](EdgePair const& epair) {
+    for_each_candidate_edge([&graph, &taken, &matches](EdgePair const& epair) {
         if (epair.second != EdgeType::hadamard) return;
 
         ZXVertex* vs = epair.first.first;
@@ -74,6 +82,27 @@ std::vector<MatchType> PivotGadgetRule::find_matches(ZXGraph const& graph) const
     return matches;
 }
 
+}  // namespace
+
+/**
+ * @brief Finds matchings of the pivot gadget rule.
+ *
+ * @param graph The graph to find matches
+ */
+std::vector<MatchType> PivotGadgetRule::find_matches(ZXGraph const& graph) const {
+    return find_pivot_gadget_matches(graph, [&graph](auto const& visit) { graph.for_each_edge(visit); });
+}
+
+/**
+ * @brief Finds matchings of the pivot gadget rule on the edges incident to `candidates`.
+ *
+ * @param graph The graph to find matches
+ * @param candidates
+ */
+std::vector<MatchType> PivotGadgetRule::find_matches_local(ZXGraph const& graph, ZXVertexList const& candidates) const {
+    return find_pivot_gadget_matches(graph, [&graph, &candidates](auto const& visit) { graph.for_each_edge_incident_to(candidates, visit); });
+}
+
 void PivotGadgetRule::apply(ZXGraph& graph, std::vector<MatchType> const& matches) const {
     for (auto& [_, v] : matches) {
         // REVIEW - scalar add power
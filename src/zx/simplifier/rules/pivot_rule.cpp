@@ -11,16 +11,19 @@ using namespace qsyn::zx;
 
 using MatchType = PivotRule::MatchType;
 
+namespace {
+
 /**
- * @brief Finds matchings of the pivot rule.
+ * @brief Find matchings of the pivot rule among the edges visited by `for_each_candidate_edge`.
  *
- * @param grapg The graph to find matches
+ * @param graph The graph to find matches
+ * @param for_each_candidate_edge a callable that feeds each candidate edge to its argument
  */
-std::vector<MatchType> PivotRule::find_matches(ZXGraph const& graph) const {
+std::vector<MatchType> find_pivot_matches(ZXGraph const& graph, auto const& for_each_candidate_edge) {
     std::vector<MatchType> matches;
 
     std::unordered_set<ZXVertex*> taken;
-    graph.for_each_edge([&graph, &taken, &matches](EdgePair const& epair) {
+    for_each_candidate_edge([&graph, &taken, &matches](EdgePair const& epair) {
         if (epair.second != EdgeType::hadamard) return;
 
         // 2: Get Neighbors
@@ -61,6 +64,27 @@ std::vector<MatchType> PivotRule::find_matches(ZXGraph const& graph) const {
     return matches;
 }
 
+}  // namespace
+
+/**
+ * @brief Finds matchings of the pivot rule.
+ *
+ * @param graph The graph to find matches
+ */
+std::vector<MatchType> PivotRule::find_matches(ZXGraph const& graph) const {
+    return find_pivot_matches(graph, [&graph](auto const& visit) { graph.for_each_edge(visit); });
+}
+
+/**
+ * @brief Finds matchings of the pivot rule on the edges incident to `candidates`.
+ *
+ * @param graph The graph to find matches
+ * @param candidates
+ */
+std::vector<MatchType> PivotRule::find_matches_local(ZXGraph const& graph, ZXVertexList const& candidates) const {
+    return find_pivot_matches(graph, [&graph, &candidates](auto const& visit) { graph.for_each_edge_incident_to(candidates, visit); });
+}
+
 void PivotRule::apply(ZXGraph& graph, std::vector<MatchType> const& matches) const {
     for (auto const& [vs, vt] : matches) {
         for (auto& v : {vs, vt}) {
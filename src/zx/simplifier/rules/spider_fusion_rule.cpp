@@ -11,17 +11,20 @@ using namespace qsyn::zx;
 
 using MatchType = SpiderFusionRule::MatchType;
 
+namespace {
+
 /**
- * @brief Find non-interacting matchings of the spider fusion rule.
+ * @brief Find non-interacting matchings of the spider fusion rule among the edges visited by `for_each_candidate_edge`.
  *
  * @param graph The graph to find matches.
+ * @param for_each_candidate_edge a callable that feeds each candidate edge to its argument
  */
-std::vector<MatchType> SpiderFusionRule::find_matches(ZXGraph const& graph) const {
+std::vector<MatchType> find_spider_fusion_matches(ZXGraph const& graph, auto const& for_each_candidate_edge) {
     std::vector<MatchType> match_type_vec;
 
     std::unordered_set<ZXVertex*> taken;
 
-    graph.for_each_edge([&graph, &taken, &match_type_vec](EdgePair const& epair) {
+    for_each_candidate_edge([&graph, &taken, &match_type_vec](EdgePair const& epair) {
         if (epair.second != EdgeType::simple) return;
         ZXVertex* v0 = epair.first.first;
         ZXVertex* v1 = epair.first.second;  // to be merged to v0
@@ -42,6 +45,27 @@ std::vector<MatchType> SpiderFusionRule::find_matches(ZXGraph const& graph) cons
     return match_type_vec;
 }
 
+}  // namespace
+
+/**
+ * @brief Find non-interacting matchings of the spider fusion rule.
+ *
+ * @param graph The graph to find matches.
+ */
+std::vector<MatchType> SpiderFusionRule::find_matches(ZXGraph const& graph) const {
+    return find_spider_fusion_matches(graph, [&graph](auto const& visit) { graph.for_each_edge(visit); });
+}
+
+/**
+ * @brief Find non-interacting matchings of the spider fusion rule on the edges incident to `candidates`.
+ *
+ * @param graph The graph to find matches.
+ * @param candidates
+ */
+std::vector<MatchType> SpiderFusionRule::find_matches_local(ZXGraph const& graph, ZXVertexList const& candidates) const {
+    return find_spider_fusion_matches(graph, [&graph, &candidates](auto const& visit) { graph.for_each_edge_incident_to(candidates, visit); });
+}
+
 /**
  * @brief Generate Rewrite format from `_matchTypeVec`
  *
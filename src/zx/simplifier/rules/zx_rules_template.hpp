@@ -55,6 +55,24 @@ public:
     virtual std::vector<MatchType> find_matches(ZXGraph const& graph) const         = 0;
     virtual void apply(ZXGraph& graph, std::vector<MatchType> const& matches) const = 0;
     virtual std::vector<ZXVertex*> flatten_vertices(MatchType match) const          = 0;
+
+    /**
+     * @brief Find matches that only need to look at the candidate vertices and the edges incident to them.
+     *        Rules that cannot localize their search fall back to a full scan.
+     *
+     * @param graph
+     * @param candidates the region to search in. Should be closed under taking neighbors of changed vertices.
+     */
+    virtual std::vector<MatchType> find_matches_local(ZXGraph const& graph, ZXVertexList const& /* candidates */) const {
+        return find_matches(graph);
+    }
+
+    /**
+     * @brief Whether `find_matches_local` really localizes the search. If so, the matches around
+     *        disjoint candidate sets can be searched concurrently.
+     *
+     */
+    virtual bool supports_local_matching() const { return false; }
 };
 
 // H Box related rules have simliar interface but is used differentlu in simplifier
@@ -111,6 +129,8 @@ public:
     IdentityRemovalRule() : ZXRuleTemplate("Identity Removal Rule") {}
 
     std::vector<MatchType> find_matches(ZXGraph const& graph) const override;
+    std::vector<MatchType> find_matches_local(ZXGraph const& graph, ZXVertexList const& candidates) const override;
+    bool supports_local_matching() const override { return true; }
     void apply(ZXGraph& graph, std::vector<MatchType> const& matches) const override;
     std::vector<ZXVertex*> flatten_vertices(MatchType match) const override { return {std::get<0>(match), std::get<1>(match), std::get<2>(match)}; }
 };
@@ -120,6 +140,8 @@ public:
     LocalComplementRule() : ZXRuleTemplate("Local Complementation Rule") {}
 
     std::vector<MatchType> find_matches(ZXGraph const& graph) const override;
+    std::vector<MatchType> find_matches_local(ZXGraph const& graph, ZXVertexList const& candidates) const override;
+    bool supports_local_matching() const override { return true; }
     void apply(ZXGraph& graph, std::vector<MatchType> const& matches) const override;
     std::vector<ZXVertex*> flatten_vertices(MatchType match) const override {
         auto [v0, vertices] = match;
@@ -155,6 +177,8 @@ public:
     PivotRule() : PivotRuleInterface("Pivot Rule") {}
 
     std::vector<MatchType> find_matches(ZXGraph const& graph) const override;
+    std::vector<MatchType> find_matches_local(ZXGraph const& graph, ZXVertexList const& candidates) const override;
+    bool supports_local_matching() const override { return true; }
     void apply(ZXGraph& graph, std::vector<MatchType> const& matches) const override;
 };
 
@@ -163,6 +187,8 @@ public:
     PivotGadgetRule() : PivotRuleInterface("Pivot Gadget Rule") {}
 
     std::vector<MatchType> find_matches(ZXGraph const& graph) const override;
+    std::vector<MatchType> find_matches_local(ZXGraph const& graph, ZXVertexList const& candidates) const override;
+    bool supports_local_matching() const override { return true; }
     void apply(ZXGraph& graph, std::vector<MatchType> const& matches) const override;
 };
 
@@ -179,6 +205,8 @@ public:
     SpiderFusionRule() : ZXRuleTemplate("Spider Fusion Rule") {}
 
     std::vector<MatchType> find_matches(ZXGraph const& graph) const override;
+    std::vector<MatchType> find_matches_local(ZXGraph const& graph, ZXVertexList const& candidates) const override;
+    bool supports_local_matching() const override { return true; }
     void apply(ZXGraph& graph, std::vector<MatchType> const& matches) const override;
     std::vector<ZXVertex*> flatten_vertices(MatchType match) const override { return {match.first, match.second}; }
 };
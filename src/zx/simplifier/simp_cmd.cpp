@@ -57,10 +57,26 @@ Command zxgraph_optimize_cmd(zx::ZXGraphMgr &zxgraph_mgr) {
                 mutex.add_argument<bool>("-c", "--clifford")
                     .action(store_true)
                     .help("Runs reduction without producing phase gadgets");
+
+                parser.add_argument<bool>("--incremental")
+                    .action(store_true)
+                    .help("only rescan the neighborhoods of changed vertices between rule applications instead of the whole graph");
+
+                parser.add_argument<size_t>("--threads")
+                    .metavar("#threads")
+                    .default_value(1)
+                    .help("find matches on this many threads and apply non-overlapping ones in batches. With --partition, reduces the partitions concurrently instead");
+
+                parser.add_argument<size_t>("--rounds")
+                    .metavar("#rounds")
+                    .default_value(1)
+                    .help("with --partition, re-partitions and reduces the graph for up to `#rounds` rounds");
             },
             [&](ArgumentParser const &parser) {
                 if (!dvlab::utils::mgr_has_data(zxgraph_mgr)) return dvlab::CmdExecResult::error;
                 zx::Simplifier s(zxgraph_mgr.get());
+                s.set_incremental(parser.get<bool>("--incremental"));
+                s.set_num_threads(parser.get<size_t>("--threads"));
                 std::string procedure_str = "";
 
                 if (parser.parsed("--symbolic")) {
@@ -70,7 +86,7 @@ Command zxgraph_optimize_cmd(zx::ZXGraphMgr &zxgraph_mgr) {
                     s.dynamic_reduce();
                     procedure_str = "DR";
                 } else if (parser.parsed("--partition")) {
-                    s.partition_reduce(parser.get<size_t>("--partition"));
+                    s.partition_reduce(parser.get<size_t>("--partition"), parser.get<size_t>("--rounds"));
                     procedure_str = "PR";
                 } else if (parser.parsed("--interior-clifford")) {
                     s.interior_clifford_simp();
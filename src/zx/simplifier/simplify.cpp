@@ -7,7 +7,10 @@
 
 #include "./simplify.hpp"
 
+#include <atomic>
 #include <cstddef>
+#include <limits>
+#include <numeric>
 
 #include "util/util.hpp"
 #include "zx/zx_def.hpp"
@@ -17,6 +20,151 @@
 
 using namespace qsyn::zx;
 
+void Simplifier::set_incremental(bool incremental) {
+    _incremental = incremental;
+    _dirty_vertices_by_rule.clear();
+    _simp_graph->set_dirty_tracking(incremental);
+}
+
+/**
+ * @brief Move the vertices the graph has marked dirty into the pending set of every rule
+ *
+ */
+void Simplifier::_collect_dirty_vertices() {
+    auto const dirty_vertices = _simp_graph->take_dirty_vertices();
+    if (dirty_vertices.empty()) return;
+    for (auto& [_, pending] : _dirty_vertices_by_rule) {
+        pending.insert(dirty_vertices.begin(), dirty_vertices.end());
+    }
+}
+
+/**
+ * @brief Get the vertices a rule should rescan: the dirty vertices still in the graph and their neighbors.
+ *        Dirty vertices that have been removed from the graph are dropped along the way.
+ *
+ * @param dirty_vertices
+ * @return the scan region, or std::nullopt if it would cover a large part of the graph,
+ *         in which case a full scan is cheaper than collecting the region
+ */
+std::optional<ZXVertexList> Simplifier::_get_scan_region(ZXVertexList& dirty_vertices) const {
+    // check membership before dereferencing; removed vertices may linger in the pending set
+    std::vector<ZXVertex*> removed;
+    for (auto v : dirty_vertices) {
+        if (!_simp_graph->get_vertices().contains(v)) removed.emplace_back(v);
+    }
+    for (auto v : removed) dirty_vertices.erase(v);
+
+    // an upper bound of the region size; hashing a vertex into the region costs
+    // several times more than rejecting it in a full scan
+    auto region_size_bound = dirty_vertices.size();
+    for (auto v : dirty_vertices) {
+        region_size_bound += _simp_graph->get_num_neighbors(v);
+    }
+    if (region_size_bound * 4 >= _simp_graph->get_num_vertices()) return std::nullopt;
+
+    ZXVertexList region = dirty_vertices;
+    for (auto v : dirty_vertices) {
+        for (auto const& [nb, _] : _simp_graph->get_neighbors(v)) {
+            region.emplace(nb);
+        }
+    }
+    return region;
+}
+
+/**
+ * @brief Get the vertices a match may read or modify: the matched vertices and their neighbors.
+ *
+ * @param vertices the vertices of a match
+ * @return the footprint, sorted and deduplicated
+ */
+std::vector<ZXVertex*> Simplifier::_get_footprint(std::vector<ZXVertex*> const& vertices) const {
+    std::vector<ZXVertex*> footprint = vertices;
+    for (auto v : vertices) {
+        for (auto const& [nb, _] : _simp_graph->get_neighbors(v)) {
+            footprint.emplace_back(nb);
+        }
+    }
+    std::ranges::sort(footprint);
+    auto const [first, last] = std::ranges::unique(footprint);
+    footprint.erase(first, last);
+    return footprint;
+}
+
+/**
+ * @brief Select matches whose footprints are pairwise disjoint. The selection is the same as
+ *        greedily taking the matches in order, but is computed in parallel rounds: in each round,
+ *        every match that comes first on all of its footprint vertices is selected, and
+ *        the matches overlapping with them are dropped.
+ *
+ * @param footprints the footprint of each candidate match
+ * @return the indices of the selected matches, in increasing order
+ */
+std::vector<size_t> Simplifier::_select_independent_matches(std::vector<std::vector<ZXVertex*>> const& footprints) const {
+    constexpr auto unclaimed = std::numeric_limits<size_t>::max();
+    auto const num_threads   = static_cast<int>(_num_threads);
+
+    // number the vertices touched by the footprints densely, so that the scratch space
+    // scales with the graph at hand rather than with the largest vertex id ever issued
+    std::vector<ZXVertex*> touched;
+    for (auto const& footprint : footprints) touched.insert(touched.end(), footprint.begin(), footprint.end());
+    std::ranges::sort(touched);
+    auto const [first, last] = std::ranges::unique(touched);
+    touched.erase(first, last);
+
+    std::vector<std::vector<size_t>> slots(footprints.size());
+#pragma omp parallel for num_threads(num_threads)
+    for (size_t i = 0; i < footprints.size(); ++i) {
+        slots[i].reserve(footprints[i].size());
+        for (auto v : footprints[i]) {
+            slots[i].emplace_back(static_cast<size_t>(std::ranges::lower_bound(touched, v) - touched.begin()));
+        }
+    }
+
+    // claims[slot] holds the first undecided match touching the vertex in this round
+    std::vector<std::atomic<size_t>> claims(touched.size());
+    std::vector<unsigned char> blocked(touched.size(), 0);
+    std::vector<unsigned char> wins(footprints.size(), 0);
+
+    std::vector<size_t> undecided(footprints.size());
+    std::iota(undecided.begin(), undecided.end(), 0);
+    std::vector<size_t> selected;
+
+    while (!undecided.empty()) {
+        for (auto const i : undecided) {
+            for (auto const s : slots[i]) claims[s].store(unclaimed, std::memory_order_relaxed);
+        }
+
+#pragma omp parallel for num_threads(num_threads)
+        for (size_t k = 0; k < undecided.size(); ++k) {
+            auto const i = undecided[k];
+            for (auto const s : slots[i]) {
+                auto& claim  = claims[s];
+                auto current = claim.load(std::memory_order_relaxed);
+                while (i < current && !claim.compare_exchange_weak(current, i, std::memory_order_relaxed)) {}
+            }
+        }
+
+#pragma omp parallel for num_threads(num_threads)
+        for (size_t k = 0; k < undecided.size(); ++k) {
+            auto const i = undecided[k];
+            wins[k]      = std::ranges::all_of(slots[i], [&](size_t s) { return claims[s].load(std::memory_order_relaxed) == i; });
+        }
+
+        for (size_t k = 0; k < undecided.size(); ++k) {
+            if (!wins[k]) continue;
+            selected.emplace_back(undecided[k]);
+            for (auto const s : slots[undecided[k]]) blocked[s] = 1;
+        }
+
+        std::erase_if(undecided, [&](size_t i) {
+            return std::ranges::any_of(slots[i], [&](size_t s) { return blocked[s] != 0; });
+        });
+    }
+
+    std::ranges::sort(selected);
+    return selected;
+}
+
 // Basic rules simplification
 size_t Simplifier::bialgebra_simp() {
     return simplify(BialgebraRule());
@@ -146,7 +294,10 @@ void Simplifier::dynamic_reduce() {
     ZXGraph copied_graph = *_simp_graph;
     spdlog::info("Full Reduce:");
     // to obtain the T-optimal
-    Simplifier(&copied_graph).full_reduce();
+    Simplifier copied_simplifier(&copied_graph);
+    copied_simplifier.set_incremental(_incremental);
+    copied_simplifier.set_num_threads(_num_threads);
+    copied_simplifier.full_reduce();
     auto t_optimal = copied_graph.t_count();
 
     spdlog::info("Dynamic Reduce: (T-optimal: {})", t_optimal);
@@ -7,9 +7,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
+#include <iterator>
 #include <memory>
+#include <optional>
+#include <string>
 #include <type_traits>
+#include <unordered_map>
 
 #include "./rules/zx_rules_template.hpp"
 
@@ -25,6 +30,34 @@ public:
         hadamard_rule_simp();
     }
 
+    Simplifier(Simplifier const&)            = delete;
+    Simplifier& operator=(Simplifier const&) = delete;
+    Simplifier(Simplifier&&)                 = delete;
+    Simplifier& operator=(Simplifier&&)      = delete;
+
+    ~Simplifier() {
+        if (_incremental) _simp_graph->set_dirty_tracking(false);
+    }
+
+    /**
+     * @brief In incremental mode, each rule rescans only the neighborhoods of the vertices
+     *        changed since the rule last ran, instead of the whole graph.
+     *
+     * @param incremental
+     */
+    void set_incremental(bool incremental);
+    bool is_incremental() const { return _incremental; }
+
+    /**
+     * @brief With more than one thread, rules that support local matching search for matches
+     *        in vertex shards concurrently. Among the matches found, a set whose neighborhoods
+     *        do not overlap is selected and applied as one batch.
+     *
+     * @param num_threads
+     */
+    void set_num_threads(size_t num_threads) { _num_threads = std::max(num_threads, size_t{1}); }
+    size_t get_num_threads() const { return _num_threads; }
+
     /**
      * @brief apply the rule on the zx graph
      *
@@ -37,12 +70,19 @@ public:
         std::vector<size_t> match_counts;
 
         while (!stop_requested()) {
-            std::vector<typename Rule::MatchType> const matches = rule.find_matches(*_simp_graph);
+            std::vector<typename Rule::MatchType> const matches = _incremental ? _find_matches_incrementally(rule) : _find_matches(rule);
             if (matches.empty()) {
                 break;
             }
             match_counts.emplace_back(matches.size());
 
+            if (_incremental) {
+                // phases are not tracked by the graph; conservatively mark every matched vertex
+                for (auto const& match : matches) {
+                    for (auto v : rule.flatten_vertices(match)) _simp_graph->mark_dirty(v);
+                }
+            }
+
             rule.apply(*_simp_graph, matches);
         }
 
@@ -135,7 +175,7 @@ public:
     void dynamic_reduce();
     void dynamic_reduce(size_t optimal_t_count);
     void symbolic_reduce();
-    void partition_reduce(size_t n_partitions);
+    void partition_reduce(size_t n_partitions, size_t n_rounds = 1);
 
     void to_z_graph();
     void to_x_graph();
@@ -143,6 +183,89 @@ public:
 private:
     void _report_simp_result(std::string_view rule_name, std::span<size_t> match_counts) const;
     ZXGraph* _simp_graph;
+
+    // incremental mode: vertices changed since each rule last came up empty.
+    // A rule without an entry has never been run and needs a full scan.
+    bool _incremental = false;
+    std::unordered_map<std::string, ZXVertexList> _dirty_vertices_by_rule;
+
+    void _collect_dirty_vertices();
+    std::optional<ZXVertexList> _get_scan_region(ZXVertexList& dirty_vertices) const;
+
+    template <typename Rule>
+    std::vector<typename Rule::MatchType> _find_matches_incrementally(Rule const& rule) {
+        _collect_dirty_vertices();
+        auto const [itr, first_run] = _dirty_vertices_by_rule.try_emplace(rule.get_name());
+        if (first_run) return _find_matches(rule);
+
+        auto& dirty_vertices = itr->second;
+        if (dirty_vertices.empty()) return {};
+
+        auto const region = _get_scan_region(dirty_vertices);
+        // Candidates blocked by this round's matches neighbor a matched vertex,
+        // which is marked dirty on apply; they will be in the next scan region.
+        dirty_vertices.clear();
+        return region.has_value() ? _find_matches_local(rule, *region) : _find_matches(rule);
+    }
+
+    // parallel mode: matches are searched in shards of this many vertices. Fixing the shard size
+    // rather than the number of shards keeps the result independent of the number of threads.
+    static constexpr size_t parallel_shard_size = 1024;
+    size_t _num_threads                         = 1;
+
+    std::vector<ZXVertex*> _get_footprint(std::vector<ZXVertex*> const& vertices) const;
+    std::vector<size_t> _select_independent_matches(std::vector<std::vector<ZXVertex*>> const& footprints) const;
+
+    template <typename Rule>
+    std::vector<typename Rule::MatchType> _find_matches(Rule const& rule) {
+        if (_num_threads > 1 && rule.supports_local_matching()) return _find_matches_in_parallel(rule, _simp_graph->get_vertices());
+        return rule.find_matches(*_simp_graph);
+    }
+
+    template <typename Rule>
+    std::vector<typename Rule::MatchType> _find_matches_local(Rule const& rule, ZXVertexList const& region) {
+        if (_num_threads > 1 && rule.supports_local_matching()) return _find_matches_in_parallel(rule, region);
+        return rule.find_matches_local(*_simp_graph, region);
+    }
+
+    /**
+     * @brief Find matches around `vertices` shard by shard on multiple threads, and then
+     *        keep a set of them that can be applied together.
+     *
+     */
+    template <typename Rule>
+    std::vector<typename Rule::MatchType> _find_matches_in_parallel(Rule const& rule, ZXVertexList const& vertices) {
+        using MatchType = typename Rule::MatchType;
+
+        std::vector<ZXVertex*> const vertex_vec(vertices.begin(), vertices.end());
+        auto const num_shards  = (vertex_vec.size() + parallel_shard_size - 1) / parallel_shard_size;
+        auto const num_threads = static_cast<int>(_num_threads);
+
+        std::vector<std::vector<MatchType>> matches_by_shard(num_shards);
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+        for (size_t i = 0; i < num_shards; ++i) {
+            auto const first = vertex_vec.begin() + static_cast<std::ptrdiff_t>(i * parallel_shard_size);
+            auto const last  = vertex_vec.begin() + static_cast<std::ptrdiff_t>(std::min((i + 1) * parallel_shard_size, vertex_vec.size()));
+            matches_by_shard[i] = rule.find_matches_local(*_simp_graph, ZXVertexList(first, last));
+        }
+
+        std::vector<MatchType> candidates;
+        for (auto& shard_matches : matches_by_shard) {
+            candidates.insert(candidates.end(), std::make_move_iterator(shard_matches.begin()), std::make_move_iterator(shard_matches.end()));
+        }
+
+        std::vector<std::vector<ZXVertex*>> footprints(candidates.size());
+#pragma omp parallel for num_threads(num_threads)
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            footprints[i] = _get_footprint(rule.flatten_vertices(candidates[i]));
+        }
+
+        std::vector<MatchType> matches;
+        for (auto const i : _select_independent_matches(footprints)) {
+            matches.emplace_back(std::move(candidates[i]));
+        }
+        return matches;
+    }
 };
 
 }  // namespace qsyn::zx
@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "qsyn/qsyn_type.hpp"
+#include "util/compact_ordered_hashset.hpp"
 #include "util/ordered_hashmap.hpp"
 #include "util/ordered_hashset.hpp"
 #include "util/phase.hpp"
@@ -67,7 +68,15 @@ struct EdgePairHash {
                (std::hash<EdgeType>()(k.second) << 1);
     }
 };
+
+// Most vertices of a graph-like diagram have only a handful of neighbors, so by default the
+// neighbors are kept inline and looked up by linear scans. Define QSYN_ZX_HASHED_NEIGHBORS
+// (cmake -DZX_HASHED_NEIGHBORS=ON) to switch back to a fully hashed set, e.g., for benchmarking.
+#ifdef QSYN_ZX_HASHED_NEIGHBORS
 using Neighbors = dvlab::utils::ordered_hashset<NeighborPair, NeighborPairHash>;
+#else
+using Neighbors = dvlab::utils::compact_ordered_hashset<NeighborPair, 4, 16, NeighborPairHash>;
+#endif
 
 struct ZXCutHash {
     size_t operator()(ZXCut const& cut) const {
@@ -58,51 +58,53 @@ std::pair<std::vector<ZXGraph*>, std::vector<ZXCut>> ZXGraph::create_subgraphs(s
     // by pass the output qubit id collision check in the copy constructor
     int next_boundary_qubit_id = INT_MIN;
 
-    for (auto& partition : partitions) {
+    for (auto const& partition : partitions) {
+        // the vertices are copied so that every subgraph owns the pool its vertices live in
+        auto subgraph = new ZXGraph;
+        subgraph->_vertex_pool.reserve(partition.size());
         ZXVertexList subgraph_inputs;
         ZXVertexList subgraph_outputs;
-        std::vector<ZXVertex*> boundary_vertices;
 
-        size_t next_vertex_id = 0;
+        std::unordered_map<ZXVertex*, ZXVertex*> old_v2new_v_map;
+        old_v2new_v_map.reserve(partition.size());
         for (auto const& vertex : partition) {
-            vertex->set_id(next_vertex_id);
-            next_vertex_id++;
+            auto const new_vertex = subgraph->add_vertex(vertex->get_qubit(), vertex->get_type(), vertex->get_phase(), vertex->get_col());
+            new_vertex->_neighbors.reserve(this->get_num_neighbors(vertex));
+            old_v2new_v_map.emplace(vertex, new_vertex);
         }
 
         for (auto const& vertex : partition) {
-            if (primary_inputs.contains(vertex)) subgraph_inputs.insert(vertex);
-            if (primary_outputs.contains(vertex)) subgraph_outputs.insert(vertex);
+            auto const new_vertex = old_v2new_v_map.at(vertex);
+            if (primary_inputs.contains(vertex)) subgraph_inputs.insert(new_vertex);
+            if (primary_outputs.contains(vertex)) subgraph_outputs.insert(new_vertex);
 
-            std::vector<NeighborPair> neighbors_to_remove;
             std::vector<NeighborPair> neighbors_to_add;
             for (auto const& [neighbor, edgeType] : this->get_neighbors(vertex)) {
-                if (!partition.contains(neighbor)) {
-                    auto boundary = new ZXVertex(next_vertex_id++, next_boundary_qubit_id++, VertexType::boundary);
-                    inner_cuts.emplace(vertex, neighbor, edgeType);
-                    cut_to_boundary[{vertex, neighbor, edgeType}] = boundary;
+                if (partition.contains(neighbor)) {
+                    new_vertex->_neighbors.emplace(old_v2new_v_map.at(neighbor), edgeType);
+                    continue;
+                }
+                auto boundary = subgraph->add_vertex(next_boundary_qubit_id++, VertexType::boundary);
+                inner_cuts.emplace(vertex, neighbor, edgeType);
+                cut_to_boundary[{vertex, neighbor, edgeType}] = boundary;
 
-                    neighbors_to_remove.push_back({neighbor, edgeType});
-                    neighbors_to_add.push_back({boundary, edgeType});
+                neighbors_to_add.push_back({boundary, edgeType});
 
-                    boundary->_neighbors.emplace(vertex, edgeType);
+                boundary->_neighbors.emplace(new_vertex, edgeType);
 
-                    boundary_vertices.push_back(boundary);
-                    subgraph_outputs.insert(boundary);
-                }
+                subgraph_outputs.insert(boundary);
             }
 
             for (auto const& neighbor_pair : neighbors_to_add) {
-                vertex->_neighbors.emplace(neighbor_pair);
-            }
-            for (auto const& neighbor_pair : neighbors_to_remove) {
-                vertex->_neighbors.erase(neighbor_pair);
+                new_vertex->_neighbors.emplace(neighbor_pair);
             }
         }
 
-        for (auto const& vertex : boundary_vertices) {
-            partition.insert(vertex);
-        }
-        subgraphs.push_back(new ZXGraph(partition, subgraph_inputs, subgraph_outputs));
+        subgraph->_inputs  = subgraph_inputs;
+        subgraph->_outputs = subgraph_outputs;
+        for (auto v : subgraph_inputs) subgraph->_input_list[v->get_qubit()] = v;
+        for (auto v : subgraph_outputs) subgraph->_output_list[v->get_qubit()] = v;
+        subgraphs.push_back(subgraph);
     }
 
     for (auto&& [i, g] : tl::views::enumerate(subgraphs)) {
@@ -116,8 +118,8 @@ std::pair<std::vector<ZXGraph*>, std::vector<ZXCut>> ZXGraph::create_subgraphs(s
         outer_cuts.push_back({b1, b2, edge_type});
     }
 
-    // ownership of the vertices is transferred to the subgraphs
-    release();
+    // the subgraphs hold copies of all the vertices
+    ZXGraph{}.swap(*this);
 
     return {subgraphs, outer_cuts};
 }
@@ -136,8 +138,10 @@ ZXGraph* ZXGraph::from_subgraphs(std::vector<ZXGraph*> const& subgraphs, std::ve
     ZXVertexList vertices;
     ZXVertexList inputs;
     ZXVertexList outputs;
+    dvlab::utils::ObjectPool<ZXVertex> vertex_pool;
 
     for (auto subgraph : subgraphs) {
+        vertex_pool.merge(std::move(subgraph->_vertex_pool));
         vertices.insert(subgraph->get_vertices().begin(), subgraph->get_vertices().end());
         inputs.insert(subgraph->get_inputs().begin(), subgraph->get_inputs().end());
         outputs.insert(subgraph->get_outputs().begin(), subgraph->get_outputs().end());
@@ -159,8 +163,8 @@ ZXGraph* ZXGraph::from_subgraphs(std::vector<ZXGraph*> const& subgraphs, std::ve
         outputs.erase(b2);
         v1->_neighbors.emplace(v2, new_edge_type);
         v2->_neighbors.emplace(v1, new_edge_type);
-        delete b1;
-        delete b2;
+        vertex_pool.destroy(b1);
+        vertex_pool.destroy(b2);
     }
 
     for (auto subgraph : subgraphs) {
@@ -169,7 +173,7 @@ ZXGraph* ZXGraph::from_subgraphs(std::vector<ZXGraph*> const& subgraphs, std::ve
         delete subgraph;
     }
 
-    return new ZXGraph(vertices, inputs, outputs);
+    return new ZXGraph(std::move(vertex_pool), vertices, inputs, outputs);
 }
 
 /*****************************************************/
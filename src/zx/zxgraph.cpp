@@ -26,14 +26,15 @@ namespace qsyn::zx {
 /**
  * @brief Construct a new ZXGraph object from a list of vertices.
  *
+ * @param vertex_pool the pool the vertices are allocated from. The graph takes over its ownership.
  * @param vertices the vertices
  * @param inputs the inputs. Note that the inputs must be a subset of the vertices.
  * @param outputs the outputs. Note that the outputs must be a subset of the vertices.
- * @param id
  */
-ZXGraph::ZXGraph(ZXVertexList const& vertices,
+ZXGraph::ZXGraph(dvlab::utils::ObjectPool<ZXVertex>&& vertex_pool,
+                 ZXVertexList const& vertices,
                  ZXVertexList const& inputs,
-                 ZXVertexList const& outputs) : _next_v_id{0}, _inputs{inputs}, _outputs{outputs}, _vertices{vertices} {
+                 ZXVertexList const& outputs) : _vertex_pool{std::move(vertex_pool)}, _next_v_id{0}, _inputs{inputs}, _outputs{outputs}, _vertices{vertices} {
     for (auto v : _vertices) {
         v->set_id(_next_v_id);
         _next_v_id++;
@@ -48,22 +49,38 @@ ZXGraph::ZXGraph(ZXVertexList const& vertices,
     }
 }
 
+/**
+ * @brief Copy a ZXGraph. The vertices are laid out contiguously in the order of `other.get_vertices()`,
+ *        and the neighbor sets are sized up front so that the edges can be filled in without rehashing.
+ *
+ * @param other
+ */
 ZXGraph::ZXGraph(ZXGraph const& other) : _filename{other._filename}, _procedures{other._procedures} {
     std::unordered_map<ZXVertex*, ZXVertex*> old_v2new_v_map;
+    old_v2new_v_map.reserve(other.get_num_vertices());
+    _vertex_pool.reserve(other.get_num_vertices());
+    _vertices.reserve(other.get_num_vertices());
 
     for (auto& v : other._vertices) {
+        ZXVertex* new_v = nullptr;
         if (v->is_boundary()) {
             if (other._inputs.contains(v))
-                old_v2new_v_map[v] = this->add_input(v->get_qubit(), v->get_col());
+                new_v = this->add_input(v->get_qubit(), v->get_col());
             else
-                old_v2new_v_map[v] = this->add_output(v->get_qubit(), v->get_col());
+                new_v = this->add_output(v->get_qubit(), v->get_col());
         } else if (v->is_z() || v->is_x() || v->is_hbox()) {
-            old_v2new_v_map[v] = this->add_vertex(v->get_qubit(), v->get_type(), v->get_phase(), v->get_col());
+            new_v = this->add_vertex(v->get_qubit(), v->get_type(), v->get_phase(), v->get_col());
         }
+        new_v->_neighbors.reserve(other.get_num_neighbors(v));
+        old_v2new_v_map.emplace(v, new_v);
     }
 
-    other.for_each_edge([&old_v2new_v_map, this](EdgePair&& epair) {
-        this->add_edge(old_v2new_v_map[epair.first.first], old_v2new_v_map[epair.first.second], epair.second);
+    // the edges of a valid graph are distinct, so they can be inserted without the checks in `add_edge`
+    other.for_each_edge([&old_v2new_v_map](EdgePair&& epair) {
+        auto const vs = old_v2new_v_map.at(epair.first.first);
+        auto const vt = old_v2new_v_map.at(epair.first.second);
+        vs->_neighbors.emplace(vt, epair.second);
+        vt->_neighbors.emplace(vs, epair.second);
     });
 }
 
@@ -246,8 +263,9 @@ ZXVertex* ZXGraph::add_output(QubitIdType qubit, ColumnIdType col) {
  * @return ZXVertex*
  */
 ZXVertex* ZXGraph::add_vertex(QubitIdType qubit, VertexType vt, Phase phase, ColumnIdType col) {
-    auto v = new ZXVertex(_next_v_id, qubit, vt, phase, col);
+    auto v = _vertex_pool.create(_next_v_id, qubit, vt, phase, col);
     _vertices.emplace(v);
+    mark_dirty(v);
     _next_v_id++;
     return v;
 }
@@ -261,6 +279,9 @@ ZXVertex* ZXGraph::add_vertex(QubitIdType qubit, VertexType vt, Phase phase, Col
  * @return EdgePair
  */
 void ZXGraph::add_edge(ZXVertex* vs, ZXVertex* vt, EdgeType et) {
+    mark_dirty(vs);
+    mark_dirty(vt);
+
     if (vs == vt) {
         vs->set_phase(vs->get_phase() + (et == EdgeType::hadamard ? Phase(1) : Phase(0)));
         return;
@@ -313,6 +334,7 @@ void ZXGraph::add_edge(ZXVertex* vs, ZXVertex* vt, EdgeType et) {
  * @param vertices
  */
 void ZXGraph::_move_vertices_from(ZXGraph& other) {
+    _vertex_pool.merge(std::move(other._vertex_pool));
     _vertices.insert(other._vertices.begin(), other._vertices.end());
     other.relabel_vertex_ids(_next_v_id);
     _next_v_id += other.get_num_vertices();
@@ -354,8 +376,10 @@ size_t ZXGraph::remove_vertex(ZXVertex* v) {
         ZXVertex* const nv = n.first;
         EdgeType const ne  = n.second;
         nv->_neighbors.erase({v, ne});
+        mark_dirty(nv);
     }
     _vertices.erase(v);
+    _dirty_vertices.erase(v);
 
     // Check if also in _inputs or _outputs
     if (_inputs.contains(v)) {
@@ -368,7 +392,7 @@ size_t ZXGraph::remove_vertex(ZXVertex* v) {
     }
 
     // deallocate ZXVertex
-    delete v;
+    _vertex_pool.destroy(v);
     return 1;
 }
 
@@ -402,6 +426,10 @@ size_t ZXGraph::remove_edge(EdgePair const& ep) {
  */
 size_t ZXGraph::remove_edge(ZXVertex* vs, ZXVertex* vt, EdgeType etype) {
     auto const count = vs->_neighbors.erase({vt, etype}) + vt->_neighbors.erase({vs, etype});
+    if (count > 0) {
+        mark_dirty(vs);
+        mark_dirty(vt);
+    }
     if (count == 1) {
         throw std::out_of_range("Graph connection error in " + std::to_string(vs->get_id()) + " and " + std::to_string(vt->get_id()));
     }
@@ -525,10 +553,18 @@ ZXVertex* ZXGraph::find_vertex_by_id(size_t const& id) const {
 }
 
 dvlab::BooleanMatrix get_biadjacency_matrix(ZXGraph const& graph, ZXVertexList const& row_vertices, ZXVertexList const& col_vertices) {
+    // fill each row by walking the neighbors of the row vertex rather than querying every (row, column) pair;
+    // the rows are usually much sparser than the number of columns
+    std::unordered_map<ZXVertex*, size_t> col_ids;
+    col_ids.reserve(col_vertices.size());
+    for (auto const& [j, w] : col_vertices | tl::views::enumerate) {
+        col_ids.emplace(w, j);
+    }
+
     dvlab::BooleanMatrix matrix(row_vertices.size(), col_vertices.size());
     for (auto const& [i, v] : row_vertices | tl::views::enumerate) {
-        for (auto const& [j, w] : col_vertices | tl::views::enumerate) {
-            if (graph.is_neighbor(v, w)) matrix[i][j] = 1;
+        for (auto const& [nb, _] : graph.get_neighbors(v)) {
+            if (auto const itr = col_ids.find(nb); itr != col_ids.end()) matrix[i][itr->second] = 1;
         }
     }
     return matrix;
@@ -13,6 +13,7 @@
 #include <filesystem>
 #include <iterator>
 #include <limits>
+#include <memory>
 #include <span>
 #include <string>
 #include <unordered_map>
@@ -22,6 +23,7 @@
 #include "qsyn/qsyn_type.hpp"
 #include "spdlog/common.h"
 #include "util/boolean_matrix.hpp"
+#include "util/object_pool.hpp"
 #include "util/phase.hpp"
 
 namespace qsyn::zx {
@@ -97,8 +99,9 @@ public:
     ZXGraph() {}
 
     ~ZXGraph() {
+        // the pool frees the memory in bulk afterwards
         for (auto& v : _vertices) {
-            delete v;
+            std::destroy_at(v);
         }
     }
 
@@ -106,15 +109,16 @@ public:
 
     ZXGraph(ZXGraph&& other) noexcept = default;
 
-    ZXGraph(ZXVertexList const& vertices,
-            ZXVertexList const& inputs,
-            ZXVertexList const& outputs);
-
     ZXGraph& operator=(ZXGraph copy) {
         copy.swap(*this);
         return *this;
     }
 
+    /**
+     * @brief Forget about the vertices without destroying them. The vertex pool
+     *        should have been merged into the graph taking over the vertices.
+     *
+     */
     void release() {
         _next_v_id = 0;
         _filename  = "";
@@ -124,6 +128,8 @@ public:
         _vertices.clear();
         _input_list.clear();
         _output_list.clear();
+        _dirty_vertices.clear();
+        _vertex_pool = {};
     }
 
     void swap(ZXGraph& other) noexcept {
@@ -135,6 +141,9 @@ public:
         std::swap(_vertices, other._vertices);
         std::swap(_input_list, other._input_list);
         std::swap(_output_list, other._output_list);
+        std::swap(_track_dirty_vertices, other._track_dirty_vertices);
+        std::swap(_dirty_vertices, other._dirty_vertices);
+        std::swap(_vertex_pool, other._vertex_pool);
     }
 
     friend void swap(ZXGraph& a, ZXGraph& b) noexcept {
@@ -209,6 +218,18 @@ public:
     size_t remove_edges(std::span<EdgePair const> epairs);
     size_t remove_all_edges_between(ZXVertex* vs, ZXVertex* vt);
 
+    // Dirty-vertex tracking for incremental simplification.
+    // When enabled, every vertex whose incident edges change is recorded until taken out.
+    void set_dirty_tracking(bool track) {
+        _track_dirty_vertices = track;
+        if (!track) _dirty_vertices.clear();
+    }
+    bool is_tracking_dirty_vertices() const { return _track_dirty_vertices; }
+    void mark_dirty(ZXVertex* v) {
+        if (_track_dirty_vertices) _dirty_vertices.emplace(v);
+    }
+    ZXVertexList take_dirty_vertices() { return std::exchange(_dirty_vertices, {}); }
+
     // Operation on graph
     void adjoint();
     void assign_vertex_to_boundary(QubitIdType qubit, bool is_input, VertexType vtype, Phase phase);
@@ -284,12 +305,27 @@ public:
             }
         }
     }
+    /**
+     * @brief Visit each edge with at least one endpoint in `vertices` exactly once
+     *
+     */
+    template <typename F>
+    void for_each_edge_incident_to(ZXVertexList const& vertices, F lambda) const {
+        for (auto& v : vertices) {
+            for (auto& [nb, etype] : this->get_neighbors(v)) {
+                if (vertices.contains(nb) && nb->get_id() < v->get_id()) continue;
+                lambda(make_edge_pair(v, nb, etype));
+            }
+        }
+    }
 
     // divide into subgraphs and merge (in zxPartition.cpp)
     std::pair<std::vector<ZXGraph*>, std::vector<ZXCut>> create_subgraphs(std::vector<ZXVertexList> partitions);
     static ZXGraph* from_subgraphs(std::vector<ZXGraph*> const& subgraphs, std::vector<ZXCut> const& cuts);
 
 private:
+    // all vertices of the graph live in this pool; it must outlive `_vertices`
+    dvlab::utils::ObjectPool<ZXVertex> _vertex_pool;
     size_t _next_v_id = 0;
     std::string _filename;
     std::vector<std::string> _procedures;
@@ -298,6 +334,8 @@ private:
     ZXVertexList _vertices;
     std::unordered_map<size_t, ZXVertex*> _input_list;
     std::unordered_map<size_t, ZXVertex*> _output_list;
+    bool _track_dirty_vertices = false;
+    ZXVertexList _dirty_vertices;
 
     void _dfs(std::unordered_set<ZXVertex*>& visited_vertices, std::vector<ZXVertex*>& topological_order, ZXVertex* v) const;
     void _bfs(std::unordered_set<ZXVertex*>& visited_vertices, std::vector<ZXVertex*>& topological_order, ZXVertex* v) const;
@@ -305,6 +343,11 @@ private:
     bool _build_graph_from_parser_storage(detail::StorageType const& storage, bool keep_id = false);
 
     void _move_vertices_from(ZXGraph& other);
+
+    ZXGraph(dvlab::utils::ObjectPool<ZXVertex>&& vertex_pool,
+            ZXVertexList const& vertices,
+            ZXVertexList const& inputs,
+            ZXVertexList const& outputs);
 };
 
 dvlab::BooleanMatrix get_biadjacency_matrix(ZXGraph const& graph, ZXVertexList const& row_vertices, ZXVertexList const& col_vertices);
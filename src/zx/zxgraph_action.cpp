@@ -37,8 +37,10 @@ void ZXGraph::toggle_vertex(ZXVertex* v) {
         toggled_neighbors.emplace(nb, toggle_edge(etype));
         nb->_neighbors.erase({v, etype});
         nb->_neighbors.emplace(v, toggle_edge(etype));
+        mark_dirty(nb);
     }
     v->_neighbors = toggled_neighbors;
+    mark_dirty(v);
     v->set_type(v->get_type() == VertexType::z ? VertexType::x : VertexType::z);
 }
 